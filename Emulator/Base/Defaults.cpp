@@ -30,6 +30,7 @@ Defaults::Defaults()
     setFallback(OPT_C64_VSYNC,                  false);
     setFallback(OPT_C64_SPEED_BOOST,            100);
     setFallback(OPT_C64_RUN_AHEAD,              0);
+    setFallback(OPT_C64_RENDER_INTERVAL,        1);
 
     setFallback(OPT_C64_SNAP_AUTO,              false);
     setFallback(OPT_C64_SNAP_DELAY,             10);
@@ -45,6 +46,7 @@ Defaults::Defaults()
 
     setFallback(OPT_VICII_REVISION,             VICII_PAL_8565);
     setFallback(OPT_VICII_POWER_SAVE,           true);
+    setFallback(OPT_VICII_LINE_CACHE,           true);
     setFallback(OPT_VICII_GRAY_DOT_BUG,         true);
     setFallback(OPT_VICII_HIDE_SPRITES,         false);
     setFallback(OPT_VICII_SB_COLLISIONS,        true);
@@ -120,6 +122,7 @@ Defaults::Defaults()
     setFallback(OPT_SID_ENGINE,                 SIDENGINE_RESID,        {0, 1, 2, 3});
     setFallback(OPT_SID_SAMPLING,               SAMPLING_INTERPOLATE,   {0, 1, 2, 3});
     setFallback(OPT_SID_POWER_SAVE,             false,                  {0, 1, 2, 3});
+    setFallback(OPT_SID_ASYNC,                  false,                  {0, 1, 2, 3});
 
     setFallback(OPT_MEM_INIT_PATTERN,           RAM_PATTERN_VICE);
     setFallback(OPT_MEM_HEATMAP,                false);
@@ -163,6 +166,7 @@ Defaults::Defaults()
 
     setFallback(OPT_RS232_BAUD,                 600);
 
+    setFallback(OPT_REC_FORMAT,                 REC_FORMAT_FFMPEG);
     setFallback(OPT_REC_FRAME_RATE,             50);
     setFallback(OPT_REC_BIT_RATE,               512);
     setFallback(OPT_REC_SAMPLE_RATE,            44100);
@@ -65,6 +65,10 @@ Error::Error(ErrorCode code, const string &s)
             description = "Syntax error in line " + s;
             break;
 
+        case VC64ERROR_GUARD_SYNTAX:
+            description = "Syntax error in condition: " + s;
+            break;
+
         case VC64ERROR_OUT_OF_MEMORY:
             description = "Out of memory.";
             break;
@@ -44,6 +44,7 @@ enum_long(VC64ERROR_CODE)
     VC64ERROR_BP_ALREADY_SET,       ///< Breakpoint is already set
     VC64ERROR_WP_NOT_FOUND,         ///< Watchpoint is not set
     VC64ERROR_WP_ALREADY_SET,       ///< Watchpoint is already set
+    VC64ERROR_GUARD_SYNTAX,         ///< Malformed guard condition
 
     // Memory
     VC64ERROR_OUT_OF_MEMORY,        ///< Out of memory
@@ -150,6 +151,7 @@ struct ErrorCodeEnum : util::Reflection<ErrorCodeEnum, ErrorCode> {
             case VC64ERROR_BP_ALREADY_SET:          return "BP_ALREADY_SET";
             case VC64ERROR_WP_NOT_FOUND:            return "WP_NOT_FOUND";
             case VC64ERROR_WP_ALREADY_SET:          return "WP_ALREADY_SET";
+            case VC64ERROR_GUARD_SYNTAX:            return "GUARD_SYNTAX";
 
             case VC64ERROR_OUT_OF_MEMORY:           return "OUT_OF_MEMORY";
 
@@ -38,6 +38,7 @@ OptionParser::create(Option opt, i64 arg)
         case OPT_C64_VSYNC:                 return boolParser();
         case OPT_C64_SPEED_BOOST:           return numParser("%");
         case OPT_C64_RUN_AHEAD:             return numParser(" frames");
+        case OPT_C64_RENDER_INTERVAL:       return numParser(" frames");
 
         case OPT_C64_SNAP_AUTO:             return boolParser();
         case OPT_C64_SNAP_DELAY:            return numParser(" sec");
@@ -46,6 +47,7 @@ OptionParser::create(Option opt, i64 arg)
         case OPT_VICII_REVISION:            return enumParser.template operator()<VICIIRevisionEnum>();
         case OPT_VICII_GRAY_DOT_BUG:        return boolParser();
         case OPT_VICII_POWER_SAVE:          return boolParser();
+        case OPT_VICII_LINE_CACHE:          return boolParser();
         case OPT_VICII_HIDE_SPRITES:        return boolParser();
         case OPT_VICII_SS_COLLISIONS:       return boolParser();
         case OPT_VICII_SB_COLLISIONS:       return boolParser();
@@ -111,6 +113,7 @@ OptionParser::create(Option opt, i64 arg)
         case OPT_SID_ENGINE:                return enumParser.template operator()<SIDEngineEnum>();
         case OPT_SID_SAMPLING:              return enumParser.template operator()<SamplingMethodEnum>();
         case OPT_SID_POWER_SAVE:            return boolParser();
+        case OPT_SID_ASYNC:                 return boolParser();
 
         case OPT_AUD_VOL0:                  return numParser("%");
         case OPT_AUD_VOL1:                  return numParser("%");
@@ -161,6 +164,7 @@ OptionParser::create(Option opt, i64 arg)
         case OPT_RS232_DEVICE:              return enumParser.template operator()<CommunicationDeviceEnum>();
         case OPT_RS232_BAUD:                return numParser(" Bd");
 
+        case OPT_REC_FORMAT:                return enumParser.template operator()<RecFormatEnum>();
         case OPT_REC_FRAME_RATE:            return numParser(" fps");
         case OPT_REC_BIT_RATE:              return numParser(" kBit");
         case OPT_REC_SAMPLE_RATE:           return numParser(" Hz");
@@ -36,6 +36,7 @@ enum_long(OPT)
     OPT_C64_VSYNC,              ///< Derive the frame rate to the VSYNC signal
     OPT_C64_SPEED_BOOST,        ///< Speed adjustment in percent
     OPT_C64_RUN_AHEAD,          ///< Number of run-ahead frames
+    OPT_C64_RENDER_INTERVAL,    ///< Render one out of N frames (0 = on demand)
 
     // Snapshots
     OPT_C64_SNAP_AUTO,          ///< Automatically take a snapshots
@@ -46,6 +47,7 @@ enum_long(OPT)
     OPT_VICII_REVISION,         ///< Chip revision
     OPT_VICII_GRAY_DOT_BUG,     ///< Emulate gray-dot bug
     OPT_VICII_POWER_SAVE,       ///< Enable fast-paths
+    OPT_VICII_LINE_CACHE,       ///< Reuse unchanged scanlines
     OPT_VICII_HIDE_SPRITES,     ///< Hide some sprites
     OPT_VICII_CUT_LAYERS,       ///< Cutout some graphics layers
     OPT_VICII_CUT_OPACITY,      ///< Cutout opacity
@@ -122,6 +124,7 @@ enum_long(OPT)
     OPT_SID_ENGINE,             ///< SID backend (e.g., reSID)
     OPT_SID_SAMPLING,           ///< Audio sampling mode
     OPT_SID_POWER_SAVE,         ///< Enable fast-paths
+    OPT_SID_ASYNC,              ///< Synthesize samples in a worker thread
 
     // Audio port
     OPT_AUD_VOL0,               ///< Channel 0 volume
@@ -181,6 +184,7 @@ enum_long(OPT)
     OPT_RS232_BAUD,             ///< Transmission rate
 
     // Screen recorder
+    OPT_REC_FORMAT,             ///< Output format of the recorder
     OPT_REC_FRAME_RATE,         ///< Frame rate of the recorded video
     OPT_REC_BIT_RATE,           ///< Bit rate of the recorded video
     OPT_REC_SAMPLE_RATE,        ///< Audio sample rate of the recorded video
@@ -221,6 +225,7 @@ struct OptionEnum : util::Reflection<OptionEnum, Option> {
             case OPT_C64_VSYNC:             return "C64.VSYNC";
             case OPT_C64_SPEED_BOOST:       return "C64.SPEED_BOOST";
             case OPT_C64_RUN_AHEAD:         return "C64.RUN_AHEAD";
+            case OPT_C64_RENDER_INTERVAL:   return "C64.RENDER_INTERVAL";
             
             case OPT_C64_SNAP_AUTO:         return "C64.SNAP_AUTO";
             case OPT_C64_SNAP_DELAY:        return "C64.SNAP_DELAY";
@@ -229,6 +234,7 @@ struct OptionEnum : util::Reflection<OptionEnum, Option> {
             case OPT_VICII_REVISION:        return "VICII.REVISION";
             case OPT_VICII_GRAY_DOT_BUG:    return "VICII.GRAY_DOT_BUG";
             case OPT_VICII_POWER_SAVE:      return "VICII.POWER_SAVE";
+            case OPT_VICII_LINE_CACHE:      return "VICII.LINE_CACHE";
             case OPT_VICII_HIDE_SPRITES:    return "VICII.HIDE_SPRITES";
             case OPT_VICII_CUT_LAYERS:      return "VICII.CUT_LAYERS";
             case OPT_VICII_CUT_OPACITY:     return "VICII.CUT_OPACITY";
@@ -295,6 +301,7 @@ struct OptionEnum : util::Reflection<OptionEnum, Option> {
             case OPT_SID_ENGINE:            return "SID.ENGINE";
             case OPT_SID_SAMPLING:          return "SID.SAMPLING";
             case OPT_SID_POWER_SAVE:        return "SID.POWER_SAVE";
+            case OPT_SID_ASYNC:             return "SID.ASYNC";
 
             case OPT_AUD_VOL0:              return "AUD.VOL0";
             case OPT_AUD_VOL1:              return "AUD.VOL1";
@@ -345,6 +352,7 @@ struct OptionEnum : util::Reflection<OptionEnum, Option> {
             case OPT_RS232_DEVICE:          return "RS232.DEVICE";
             case OPT_RS232_BAUD:            return "RS232.BAUD";
 
+            case OPT_REC_FORMAT:            return "REC.FORMAT";
             case OPT_REC_FRAME_RATE:        return "REC.FRAME_RATE";
             case OPT_REC_BIT_RATE:          return "REC.BIT_RATE";
             case OPT_REC_SAMPLE_RATE:       return "REC.SAMPLE_RATE";
@@ -378,6 +386,7 @@ struct OptionEnum : util::Reflection<OptionEnum, Option> {
             case OPT_C64_VSYNC:             return "VSYNC mode";
             case OPT_C64_SPEED_BOOST:      return "Speed adjustment";
             case OPT_C64_RUN_AHEAD:         return "Run-ahead frames";
+            case OPT_C64_RENDER_INTERVAL:   return "Render one out of N frames";
 
             case OPT_C64_SNAP_AUTO:         return "Automatically take snapshots";
             case OPT_C64_SNAP_DELAY:        return "Time span between two snapshots";
@@ -386,6 +395,7 @@ struct OptionEnum : util::Reflection<OptionEnum, Option> {
             case OPT_VICII_REVISION:        return "Chip revision";
             case OPT_VICII_GRAY_DOT_BUG:    return "Emulate gray-dot bug";
             case OPT_VICII_POWER_SAVE:      return "Take fast paths";
+            case OPT_VICII_LINE_CACHE:      return "Reuse unchanged scanlines";
             case OPT_VICII_HIDE_SPRITES:    return "Hide sprites";
             case OPT_VICII_CUT_LAYERS:      return "Cut out graphics layers";
             case OPT_VICII_CUT_OPACITY:     return "Opacity";
@@ -452,6 +462,7 @@ struct OptionEnum : util::Reflection<OptionEnum, Option> {
             case OPT_SID_ENGINE:            return "SID backend";
             case OPT_SID_SAMPLING:          return "Audio sampling rate";
             case OPT_SID_POWER_SAVE:        return "Take fast paths";
+            case OPT_SID_ASYNC:             return "Synthesize samples in a worker thread";
             case OPT_AUD_VOL0:              return "Channel 0 volume";
             case OPT_AUD_VOL1:              return "Channel 1 volume";
             case OPT_AUD_VOL2:              return "Channel 2 volume";
@@ -501,6 +512,7 @@ struct OptionEnum : util::Reflection<OptionEnum, Option> {
             case OPT_RS232_DEVICE:          return "Connected RS232 device";
             case OPT_RS232_BAUD:            return "Transmission rate (baud)";
 
+            case OPT_REC_FORMAT:            return "Output format of the recorder";
             case OPT_REC_FRAME_RATE:        return "Frame rate of the recorded video";
             case OPT_REC_BIT_RATE:          return "Bit rate of the recorded video";
             case OPT_REC_SAMPLE_RATE:       return "Audio sample rate of the recorded video";
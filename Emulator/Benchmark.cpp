@@ -0,0 +1,1713 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// This FILE is dual-licensed. You are free to choose between:
+//
+//     - The GNU General Public License v3 (or any later version)
+//     - The Mozilla Public License v2
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR MPL-2.0
+// -----------------------------------------------------------------------------
+/// @file
+
+#include "config.h"
+#include "Benchmark.h"
+#include "BenchmarkPrograms.h"
+#include "C64.h"
+#include "IOUtils.h"
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+// The canonical workloads
+static const char *workloads[] = { "idle", "raster", "drive", "sid", "reu", "events" };
+
+int main(int argc, char *argv[])
+{
+    try {
+
+        return vc64::Benchmark().main(argc, argv);
+
+    } catch (vc64::BenchSyntaxError &e) {
+
+        std::cout << "Usage: vc64Bench [-qpdcsluvmexo] [-w <workload>] [-f <frames>] [-r <interval>] [<rom> | <prg> ...]" << std::endl;
+        std::cout << std::endl;
+        std::cout << "       -q or --quick       Runs a reduced number of frames" << std::endl;
+        std::cout << "       -f or --frames      Number of measured frames per workload" << std::endl;
+        std::cout << "       -w or --workload    Only runs the specified workload" << std::endl;
+        std::cout << "       -p or --profile     Records the time spent in each component" << std::endl;
+        std::cout << "       -r or --render      Renders one out of N frames (0 = none)" << std::endl;
+        std::cout << "       -d or --dispatch    Compares the CPU dispatch engines" << std::endl;
+        std::cout << "       -c or --canvas      Compares the canvas drawing routines" << std::endl;
+        std::cout << "       -s or --sprites     Compares the sprite drawing routines" << std::endl;
+        std::cout << "       -l or --lines       Renders with and without the scanline cache" << std::endl;
+        std::cout << "       -u or --audio       Synthesizes with and without the audio worker" << std::endl;
+        std::cout << "       -v or --fir         Compares the FIR resampling kernels" << std::endl;
+        std::cout << "       -m or --mixer       Compares the audio mixing routines" << std::endl;
+        std::cout << "       -e or --silence     Synthesizes with and without silence detection" << std::endl;
+        std::cout << "       -x or --recorder    Runs with and without the raw screen recorder" << std::endl;
+        std::cout << "       -o or --output      Writes the results to a JSON file" << std::endl;
+        std::cout << "       <rom>               Installs an additional Rom (e.g., VC1541)" << std::endl;
+        std::cout << "       <prg>               Adds a program to the dispatch benchmark" << std::endl;
+        std::cout << std::endl;
+        std::cout << "       Workloads: idle, raster, drive, sid, reu, events" << std::endl;
+        std::cout << std::endl;
+
+        if (auto what = string(e.what()); !what.empty()) {
+            std::cout << what << std::endl;
+        }
+
+    } catch (vc64::Error &e) {
+
+        std::cout << "VAError: " << e.what() << std::endl;
+
+    } catch (std::exception &e) {
+
+        std::cout << "System Error: " << e.what() << std::endl;
+
+    } catch (...) {
+
+        std::cout << "Error" << std::endl;
+    }
+
+    return 1;
+}
+
+namespace vc64 {
+
+int
+Benchmark::main(int argc, char *argv[])
+{
+    std::cout << "VirtualC64 Benchmark v" << VirtualC64::version();
+    std::cout << " - (C)opyright Dirk W. Hoffmann" << std::endl << std::endl;
+
+    // Parse all command line arguments
+    parseArguments(argc, argv);
+
+    // Run all selected workloads
+    for (auto &workload : workloads) {
+        if (!keys.contains("workload") || keys["workload"] == workload) run(workload);
+    }
+
+    // Compare the CPU dispatch engines
+    if (keys.contains("dispatch")) runDispatch();
+
+    // Compare the canvas drawing routines
+    if (keys.contains("canvas")) runCanvas();
+
+    // Compare the sprite drawing routines
+    if (keys.contains("sprites")) runSprites();
+
+    // Compare rendering with and without the scanline cache
+    if (keys.contains("lines")) runLines();
+
+    // Compare synthesis with and without the audio worker
+    if (keys.contains("audio")) runAudio();
+
+    // Compare the FIR resampling kernels
+    if (keys.contains("fir")) runFIR();
+
+    // Compare the audio mixing routines
+    if (keys.contains("mixer")) runMixer();
+
+    // Compare synthesis with and without silence detection
+    if (keys.contains("silence")) runSilence();
+
+    // Compare emulation with and without recording
+    if (keys.contains("recorder")) runRecorder();
+
+    // Report the results
+    report(std::cout);
+
+    if (keys.contains("output")) {
+
+        auto file = std::ofstream(keys["output"]);
+        if (!file.is_open()) throw Error(VC64ERROR_FILE_CANT_WRITE, keys["output"]);
+        exportJSON(file);
+    }
+
+    return returnCode;
+}
+
+void
+Benchmark::parseArguments(int argc, char *argv[])
+{
+    // Remember the execution path
+    keys["exec"] = std::filesystem::absolute(std::filesystem::path(argv[0])).string();
+
+    // Parse command line arguments
+    for (isize i = 1; i < argc; i++) {
+
+        auto arg = string(argv[i]);
+
+        if (arg[0] == '-') {
+
+            auto value = [&]() {
+                if (++i >= argc) throw BenchSyntaxError("Missing argument for '" + arg + "'");
+                return string(argv[i]);
+            };
+
+            if (arg == "-q" || arg == "--quick")    { keys["quick"] = "1"; continue; }
+            if (arg == "-f" || arg == "--frames")   { keys["frames"] = value(); continue; }
+            if (arg == "-w" || arg == "--workload") { keys["workload"] = value(); continue; }
+            if (arg == "-p" || arg == "--profile")  { keys["profile"] = "1"; continue; }
+            if (arg == "-r" || arg == "--render")   { keys["render"] = value(); continue; }
+            if (arg == "-d" || arg == "--dispatch") { keys["dispatch"] = "1"; continue; }
+            if (arg == "-c" || arg == "--canvas")   { keys["canvas"] = "1"; continue; }
+            if (arg == "-s" || arg == "--sprites")  { keys["sprites"] = "1"; continue; }
+            if (arg == "-l" || arg == "--lines")    { keys["lines"] = "1"; continue; }
+            if (arg == "-u" || arg == "--audio")    { keys["audio"] = "1"; continue; }
+            if (arg == "-v" || arg == "--fir")      { keys["fir"] = "1"; continue; }
+            if (arg == "-m" || arg == "--mixer")    { keys["mixer"] = "1"; continue; }
+            if (arg == "-e" || arg == "--silence")  { keys["silence"] = "1"; continue; }
+            if (arg == "-x" || arg == "--recorder") { keys["recorder"] = "1"; continue; }
+            if (arg == "-o" || arg == "--output")   { keys["output"] = value(); continue; }
+
+            throw BenchSyntaxError("Invalid option '" + arg + "'");
+        }
+
+        auto path = std::filesystem::absolute(std::filesystem::path(arg));
+        (PRGFile::isCompatible(path) ? programs : roms).push_back(path.string());
+    }
+
+    // Check for syntax errors
+    checkArguments();
+}
+
+void
+Benchmark::checkArguments()
+{
+    if (keys.contains("quick")) frames = 50;
+
+    if (keys.contains("frames")) {
+
+        try { frames = std::stol(keys["frames"]); } catch (...) { frames = 0; }
+        if (frames <= 0) throw BenchSyntaxError("Invalid frame count: " + keys["frames"]);
+    }
+
+    if (keys.contains("render")) {
+
+        try { renderInterval = std::stol(keys["render"]); } catch (...) { renderInterval = -1; }
+        if (renderInterval < 0) throw BenchSyntaxError("Invalid render interval: " + keys["render"]);
+    }
+
+    if (keys.contains("workload")) {
+
+        if (std::find(std::begin(workloads), std::end(workloads), keys["workload"]) == std::end(workloads)) {
+            throw BenchSyntaxError("Unknown workload: " + keys["workload"]);
+        }
+    }
+
+    for (auto &file : roms) {
+
+        // All Rom files must exist
+        if (!util::fileExists(file)) {
+            throw BenchSyntaxError("File " + file + " does not exist");
+        }
+    }
+
+    for (auto &file : programs) {
+
+        // All program files must exist
+        if (!util::fileExists(file)) {
+            throw BenchSyntaxError("File " + file + " does not exist");
+        }
+    }
+}
+
+void
+Benchmark::run(const string &workload)
+{
+    BenchResult result = { .name = workload };
+
+    std::cout << "Running workload '" << workload << "'..." << std::endl;
+
+    // Create an emulator instance
+    VirtualC64 c64; emu = &c64; alarm = 0; stats = { }; checksum = 0;
+
+    // Plug in the three MEGA65 OpenROMs and all user-provided Roms
+    c64.c64.installOpenRoms();
+    c64.c64.deleteRom(ROM_TYPE_VC1541);
+    for (auto &rom : roms) c64.c64.loadRom(rom);
+
+    // Launch the emulator thread
+    c64.launch(this, vc64::process);
+
+    // Configure the emulator
+    result.skipped = configure(c64, workload);
+
+    if (result.skipped.empty()) {
+
+        auto cyclesPerFrame = c64.c64.c64->vic.getCyclesPerFrame();
+
+        // Boot the machine (the emulator pauses when the alarm fires)
+        c64.run();
+        c64.put(CMD_ALARM_ABS, AlarmCmd { .cycle = bootFrames * cyclesPerFrame, .value = ALARM_BOOTED });
+        if (!waitForAlarm(ALARM_BOOTED)) throw Error(VC64ERROR_LAUNCH, "Boot timeout");
+
+        /* Start the workload in the paused machine. This makes all workloads
+         * deterministic, i.e., the state checksum only changes if the
+         * emulation result changes.
+         */
+        start(c64, workload);
+        c64.c64.c64->setAlarmRel(warmupFrames * cyclesPerFrame, ALARM_START);
+        c64.c64.c64->setAlarmRel((warmupFrames + frames) * cyclesPerFrame, ALARM_STOP);
+
+        // Let the workload run
+        c64.run();
+        if (!waitForAlarm(ALARM_STOP)) throw Error(VC64ERROR_LAUNCH, "Workload timeout");
+
+        result.frames = stopFrame - startFrame;
+        result.cycles = frames * cyclesPerFrame;
+        result.nanos = (stopTime - startTime).asNanoseconds();
+        result.checksum = checksum;
+
+        if (stats.profiling) {
+
+            result.profiled = true;
+            for (isize i = 0; i < PROF_COUNT; i++) result.profile[i] = stats.profile[i];
+        }
+    }
+
+    results.push_back(result);
+    emu = nullptr;
+}
+
+string
+Benchmark::configure(VirtualC64 &c64, const string &workload)
+{
+    c64.set(OPT_C64_WARP_MODE, WARP_ALWAYS);
+    c64.set(OPT_C64_WARP_BOOT, 0);
+
+    // Override the warp mode frame skipping if a render interval is given
+    if (renderInterval >= 0) {
+
+        c64.set(OPT_VICII_POWER_SAVE, false);
+        c64.set(OPT_C64_RENDER_INTERVAL, renderInterval);
+    }
+
+    // Only emulate the floppy drive if the workload needs it
+    if (workload == "drive") {
+
+        if (!c64.c64.getRomTraits(ROM_TYPE_VC1541).crc) return "No VC1541 Rom";
+        c64.set(OPT_DRV_CONNECT, true, DRIVE8);
+        c64.set(OPT_DRV_POWER_SWITCH, true, DRIVE8);
+
+    } else {
+
+        c64.set(OPT_DRV_CONNECT, false, DRIVE8);
+    }
+
+    if (workload == "sid") {
+
+        for (long i = 1; i < 4; i++) c64.set(OPT_SID_ENABLE, true, i);
+    }
+
+    if (workload == "reu") {
+
+        c64.expansionPort.attachReu(512);
+    }
+
+    return "";
+}
+
+void
+Benchmark::start(VirtualC64 &c64, const string &workload)
+{
+    if (workload == "raster") {
+
+        launchProgram(c64, rasterBench, isizeof(rasterBench));
+    }
+
+    if (workload == "sid") {
+
+        launchProgram(c64, sidBench, isizeof(sidBench));
+    }
+
+    if (workload == "silence") {
+
+        launchProgram(c64, silenceBench, isizeof(silenceBench));
+    }
+
+    if (workload == "reu") {
+
+        launchProgram(c64, reuBench, isizeof(reuBench));
+    }
+
+    if (workload == "events") {
+
+        // Keep the CIAs busy and the keyboard slot occupied
+        launchProgram(c64, eventBench, isizeof(eventBench));
+        c64.keyboard.autoType(string(1024, 'x'));
+    }
+
+    if (workload == "drive") {
+
+        // Create a disk containing a 16 KB file
+        Buffer<u8> buffer(16 * 1024 + 2);
+        buffer[0] = 0x00;
+        buffer[1] = 0x20;
+        for (isize i = 2; i < buffer.size; i++) buffer[i] = u8(i * 7);
+
+        PRGFile prg(buffer.ptr, buffer.size);
+        c64.drive8.insertMedia(prg, false);
+
+        // Load the file from disk
+        c64.keyboard.autoType("load \"*\",8,1\n");
+    }
+}
+
+void
+Benchmark::launchProgram(VirtualC64 &c64, const u8 *prg, isize len)
+{
+    c64.suspend();
+
+    c64.c64.flash(PRGFile(prg, len));
+    c64.c64.c64->cpu.jump(u16(prg[0] | prg[1] << 8));
+
+    c64.resume();
+}
+
+template <bool T> static i64
+measureDispatch(CPU &cpu, i64 cycles)
+{
+    auto start = util::Time::now();
+    for (i64 i = 0; i < cycles; i++) cpu.execute<MOS_6510, T>();
+    return (util::Time::now() - start).asNanoseconds();
+}
+
+void
+Benchmark::runDispatch()
+{
+    std::cout << "Running the dispatch benchmark..." << std::endl;
+
+    VirtualC64 c64; emu = &c64; alarm = 0;
+
+    c64.c64.installOpenRoms();
+    for (auto &rom : roms) c64.c64.loadRom(rom);
+    c64.launch(this, vc64::process);
+    c64.set(OPT_C64_WARP_MODE, WARP_ALWAYS);
+    c64.set(OPT_DRV_CONNECT, false, DRIVE8);
+
+    // Boot the machine to get the Kernal into a sane state
+    c64.run();
+    c64.put(CMD_ALARM_REL, AlarmCmd { .cycle = bootFrames * c64.c64.c64->vic.getCyclesPerFrame(), .value = ALARM_BOOTED });
+    if (!waitForAlarm(ALARM_BOOTED)) throw Error(VC64ERROR_LAUNCH, "Boot timeout");
+
+    // Run the CPU in isolation, i.e., without the other components
+    c64.suspend();
+
+    runDispatch(c64, "cpu", std::vector<u8>(std::begin(cpuBench), std::end(cpuBench)));
+    runDispatch(c64, "raster", std::vector<u8>(std::begin(rasterBench), std::end(rasterBench)));
+
+    for (auto &file : programs) {
+
+        std::ifstream stream(file, std::ios::binary);
+        std::vector<u8> prg((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+        runDispatch(c64, std::filesystem::path(file).stem().string(), prg);
+    }
+
+    c64.resume();
+    emu = nullptr;
+}
+
+void
+Benchmark::runDispatch(VirtualC64 &c64, const string &name, const std::vector<u8> &prg)
+{
+    if (prg.size() < 3) throw Error(VC64ERROR_FILE_TYPE_MISMATCH, name);
+
+    auto &cpu = c64.c64.c64->cpu;
+    DispatchResult result = { .name = name, .cycles = 5000000 };
+
+    // Determine the start address (evaluate the SYS command of a Basic stub)
+    u16 start = u16(prg[0] | prg[1] << 8);
+    if (start == 0x0801) {
+
+        for (usize i = 6; i < prg.size() && prg[i]; i++) {
+
+            if (prg[i] != 0x9E) continue;
+
+            string digits;
+            for (usize j = i + 1; j < prg.size() && (prg[j] == ' ' || isdigit(prg[j])); j++) {
+                if (prg[j] != ' ') digits += char(prg[j]);
+            }
+            if (!digits.empty()) start = u16(std::stoi(digits));
+            break;
+        }
+    }
+
+    // Measure both engines in turn and keep the best out of several rounds
+    for (isize round = 0; round < 6; round++) {
+
+        auto engine = round & 1;
+
+        c64.c64.flash(PRGFile(prg.data(), isize(prg.size())));
+        cpu.jump(start);
+
+        auto nanos = engine ?
+        measureDispatch<true>(cpu, result.cycles) : measureDispatch<false>(cpu, result.cycles);
+
+        if (round < 2 || nanos < result.nanos[engine]) result.nanos[engine] = nanos;
+    }
+
+    dispatchResults.push_back(result);
+}
+
+void
+Benchmark::runCanvas()
+{
+    std::cout << "Running the canvas benchmark..." << std::endl;
+
+    VirtualC64 c64; emu = &c64;
+
+    c64.launch(this, vc64::process);
+    c64.suspend();
+
+    auto &vic = c64.c64.c64->vic;
+    isize lines = keys.contains("quick") ? 2000 : 20000;
+
+    for (isize mode = DISPLAY_MODE_STANDARD_TEXT; mode <= DISPLAY_MODE_EXTENDED_BG_COLOR; mode++) {
+
+        CanvasResult result = { .name = DisplayModeEnum::key(mode), .lines = lines };
+
+        // Check if both routines produce the same pixels and sequencer state
+        u64 fingerprint[2];
+        drawCanvas<false>(vic, DisplayMode(mode), 512, &fingerprint[0]);
+        drawCanvas<true>(vic, DisplayMode(mode), 512, &fingerprint[1]);
+
+        if (fingerprint[0] != fingerprint[1]) {
+
+            result.match = false;
+            returnCode = 1;
+        }
+
+        // Measure both routines in turn and keep the best out of several rounds
+        for (isize round = 0; round < 6; round++) {
+
+            auto routine = round & 1;
+
+            auto nanos = routine ?
+            drawCanvas<true>(vic, DisplayMode(mode), lines, nullptr) :
+            drawCanvas<false>(vic, DisplayMode(mode), lines, nullptr);
+
+            if (round < 2 || nanos < result.nanos[routine]) result.nanos[routine] = nanos;
+        }
+
+        canvasResults.push_back(result);
+    }
+
+    c64.resume();
+    emu = nullptr;
+}
+
+template <bool V> i64
+Benchmark::drawCanvas(VICII &vic, DisplayMode mode, isize lines, u64 *fingerprint)
+{
+    // Feed the sequencer with pseudo-random graphics data
+    u32 seed = 0x12345678;
+    std::vector<u32> data(1024);
+    for (auto &d : data) { seed = seed * 1664525 + 1013904223; d = seed >> 8; }
+
+    vic.reg.delayed.mode = mode;
+    for (isize i = 0; i < 15; i++) vic.reg.delayed.colors[i] = u8((i * 7 + 3) & 0xF);
+    vic.flipflops.delayed.vertical = false;
+    vic.sr = { };
+    vic.emuTexturePtr = vic.emuTexture;
+
+    u64 hash = util::fnvInit64();
+    auto start = util::Time::now();
+
+    for (isize line = 0, i = 0; line < lines; line++) {
+
+        // Vary the scroll offset and occasionally suppress reloading
+        vic.reg.delayed.xscroll = u8(line & 7);
+        vic.sr.canLoad = (line % 16) != 15;
+        vic.bufferoffset = 0;
+
+        for (isize column = 0; column < 40; column++, i++) {
+
+            vic.gAccessResult.reset(data[i & 1023]);
+            vic.drawCanvasFastPath<V>();
+
+            if (fingerprint) {
+
+                u64 pixels, depths;
+                memcpy(&pixels, vic.emuTexturePtr + vic.bufferoffset, 8);
+                memcpy(&depths, vic.zBuffer + vic.bufferoffset, 8);
+
+                auto state = HI_HI_LO_LO(vic.sr.data, vic.sr.mcFlop, vic.sr.colorbits, vic.sr.latchedCol);
+                hash = util::fnvIt64(hash, pixels ^ depths << 1 ^ u64(state) << 3);
+            }
+            vic.bufferoffset += 8;
+        }
+    }
+
+    if (fingerprint) *fingerprint = hash;
+    return (util::Time::now() - start).asNanoseconds();
+}
+
+void
+Benchmark::runSprites()
+{
+    std::cout << "Running the sprite benchmark..." << std::endl;
+
+    VirtualC64 c64; emu = &c64;
+
+    c64.launch(this, vc64::process);
+    c64.suspend();
+
+    auto &vic = c64.c64.c64->vic;
+    isize lines = keys.contains("quick") ? 2000 : 20000;
+
+    const char *names[] = { "HIRES", "HIRES_EXPANDED", "MULTICOLOR", "MULTICOLOR_EXPANDED", "MIXED" };
+
+    for (isize mode = 0; mode < 5; mode++) {
+
+        CanvasResult result = { .name = names[mode], .lines = lines };
+
+        // Check if both routines produce the same pixels and sprite state
+        u64 fingerprint[2];
+        drawSprites<false>(vic, mode, 512, &fingerprint[0]);
+        drawSprites<true>(vic, mode, 512, &fingerprint[1]);
+
+        if (fingerprint[0] != fingerprint[1]) {
+
+            result.match = false;
+            returnCode = 1;
+        }
+
+        // Measure both routines in turn and keep the best out of several rounds
+        for (isize round = 0; round < 6; round++) {
+
+            auto routine = round & 1;
+
+            auto nanos = routine ?
+            drawSprites<true>(vic, mode, lines, nullptr) :
+            drawSprites<false>(vic, mode, lines, nullptr);
+
+            if (round < 2 || nanos < result.nanos[routine]) result.nanos[routine] = nanos;
+        }
+
+        spriteResults.push_back(result);
+    }
+
+    c64.resume();
+    emu = nullptr;
+}
+
+template <bool T> i64
+Benchmark::drawSprites(VICII &vic, isize mode, isize lines, u64 *fingerprint)
+{
+    // Mode 0 ... 3 select the color mode and X expansion, mode 4 mixes both
+    u32 seed = 0x87654321;
+    auto next = [&seed]() { seed = seed * 1664525 + 1013904223; return seed >> 8; };
+
+    // Prepare a scanline of pseudo-random foreground and background pixels
+    u8 depth[Texture::width];
+    for (auto &d : depth) d = (next() & 1) ? DEPTH_FG : DEPTH_BG;
+
+    for (isize i = 0; i < 15; i++) vic.reg.delayed.colors[i] = u8((i * 7 + 3) & 0xF);
+    vic.isVisibleColumn = true;
+    vic.emuTexturePtr = vic.emuTexture;
+    vic.irr = 0;
+
+    u64 hash = util::fnvInit64();
+    auto start = util::Time::now();
+
+    for (isize line = 0; line < lines; line++) {
+
+        // Place eight sprites with pseudo-random data at overlapping positions
+        auto bits = next();
+        vic.reg.delayed.sprMC = mode == 4 ? u8(bits) : (mode & 2) ? 0xFF : 0;
+        vic.reg.delayed.sprExpandX = mode == 4 ? u8(bits >> 8) : (mode & 1) ? 0xFF : 0;
+        vic.reg.delayed.sprPriority = u8(bits >> 16);
+        vic.spriteDisplay = 0xFF;
+        vic.spriteSrActive = 0;
+        vic.spriteSpriteCollision = 0;
+        vic.spriteBackgroundColllision = 0;
+
+        for (isize i = 0; i < 8; i++) {
+
+            // Occasionally clear the last byte to stop the shift register early
+            vic.spriteSr[i].data = next() & ((line + i) % 4 ? 0xFFFFFF : 0xFFFF00);
+            vic.spriteSr[i].colBits = 0;
+            vic.spriteSr[i].expFlop = true;
+            vic.spriteSr[i].mcFlop = true;
+            vic.reg.delayed.sprX[i] = u16(next() % 320);
+        }
+
+        memcpy(vic.zBuffer, depth, sizeof(depth));
+        memset(vic.emuTexturePtr, 0, sizeof(depth));
+        vic.bufferoffset = 0;
+
+        for (isize column = 0; column < 48; column++) {
+
+            // In mixed mode, switch the color mode and X expansion mid-line
+            if (mode == 4 && column == 24) {
+
+                vic.reg.delayed.sprMC ^= u8(bits >> 4);
+                vic.reg.delayed.sprExpandX ^= u8(bits >> 12);
+            }
+
+            vic.xCounter = u16(8 * column);
+            vic.drawSpritesFastPath<T>();
+
+            if (fingerprint) {
+
+                u64 pixels, depths;
+                memcpy(&pixels, vic.emuTexturePtr + vic.bufferoffset, 8);
+                memcpy(&depths, vic.zBuffer + vic.bufferoffset, 8);
+                hash = util::fnvIt64(hash, pixels ^ depths << 1);
+
+                for (isize i = 0; i < 8; i++) {
+
+                    auto &sr = vic.spriteSr[i];
+                    auto state = HI_HI_LO_LO(sr.mcFlop, sr.expFlop, sr.colBits, vic.collision[i]);
+                    hash = util::fnvIt64(hash, u64(sr.data) << 32 | state);
+                }
+                auto state = HI_HI_LO_LO(vic.spriteSrActive, vic.spriteSpriteCollision,
+                                         vic.spriteBackgroundColllision, vic.irr);
+                hash = util::fnvIt64(hash, state);
+            }
+            vic.bufferoffset += 8;
+        }
+    }
+
+    if (fingerprint) *fingerprint = hash;
+    return (util::Time::now() - start).asNanoseconds();
+}
+
+void
+Benchmark::runLines()
+{
+    std::cout << "Running the scanline cache benchmark..." << std::endl;
+
+    isize count = keys.contains("quick") ? 50 : 500;
+
+    for (auto workload : { "idle", "raster" }) {
+
+        CanvasResult result = { .name = workload };
+
+        // Render the same frames with and without the scanline cache
+        u64 fingerprint[2];
+        result.nanos[0] = renderFrames(workload, false, count, &fingerprint[0], result);
+        result.nanos[1] = renderFrames(workload, true, count, &fingerprint[1], result);
+
+        if (fingerprint[0] != fingerprint[1]) {
+
+            result.match = false;
+            returnCode = 1;
+        }
+
+        lineResults.push_back(result);
+    }
+}
+
+i64
+Benchmark::renderFrames(const string &workload, bool cached, isize count, u64 *fingerprint, CanvasResult &result)
+{
+    VirtualC64 c64; emu = &c64;
+
+    c64.c64.installOpenRoms();
+    c64.launch(this, vc64::process);
+    c64.set(OPT_VICII_LINE_CACHE, cached);
+    c64.powerOn();
+
+    /* Compute all frames inside this thread. This makes both runs
+     * deterministic, i.e., they produce the same textures if the scanline
+     * cache works correctly.
+     */
+    c64.suspend();
+
+    auto &c = *c64.c64.c64;
+    auto &vic = c.vic;
+
+    for (isize i = 0; i < bootFrames; i++) c.computeFrame(false);
+    start(c64, workload);
+    for (isize i = 0; i < warmupFrames; i++) c.computeFrame(false);
+
+    auto hits = vic.stats.lineCacheHit;
+    u64 hash = util::fnvInit64();
+    i64 nanos = 0;
+
+    for (isize i = 0; i < count; i++) {
+
+        auto start = util::Time::now();
+        c.computeFrame(false);
+        nanos += (util::Time::now() - start).asNanoseconds();
+
+        auto *stable = vic.emuTextures[vic.stableBuffer];
+        hash = util::fnvIt64(hash, util::fnv64(stable, Texture::height * Texture::width));
+    }
+
+    result.lines = count * vic.getLinesPerFrame();
+    if (cached) result.hits = vic.stats.lineCacheHit - hits;
+
+    c64.resume();
+    emu = nullptr;
+
+    *fingerprint = hash;
+    return nanos;
+}
+
+void
+Benchmark::runAudio()
+{
+    std::cout << "Running the audio worker benchmark..." << std::endl;
+
+    isize count = keys.contains("quick") ? 50 : 500;
+
+    for (auto sampling : { SAMPLING_FAST, SAMPLING_INTERPOLATE, SAMPLING_RESAMPLE }) {
+
+        SynthesisResult result = { .name = SamplingMethodEnum::key(sampling) };
+
+        // Synthesize the same frames on the emulator thread and in the worker
+        u64 fingerprint[2];
+        result.nanos[0] = synthesizeFrames("sid", sampling, false, false, count, &fingerprint[0], result);
+        result.nanos[1] = synthesizeFrames("sid", sampling, true, false, count, &fingerprint[1], result);
+
+        if (fingerprint[0] != fingerprint[1]) {
+
+            result.match = false;
+            returnCode = 1;
+        }
+
+        audioResults.push_back(result);
+    }
+}
+
+void
+Benchmark::runFIR()
+{
+    std::cout << "Running the FIR resampling benchmark..." << std::endl;
+
+    isize count = keys.contains("quick") ? 50 : 500;
+
+    SynthesisResult result = { .name = SamplingMethodEnum::key(SAMPLING_RESAMPLE) };
+
+    // Resample the same frames with both kernels
+    u64 fingerprint[2];
+    reSID::SID::enable_simd(false);
+    result.nanos[0] = synthesizeFrames("sid", SAMPLING_RESAMPLE, false, false, count, &fingerprint[0], result);
+    reSID::SID::enable_simd(true);
+    result.nanos[1] = synthesizeFrames("sid", SAMPLING_RESAMPLE, false, false, count, &fingerprint[1], result);
+
+    result.name += string(" (") + reSID::SID::simd_kernel() + ")";
+
+    if (fingerprint[0] != fingerprint[1]) {
+
+        result.match = false;
+        returnCode = 1;
+    }
+
+    firResults.push_back(result);
+}
+
+void
+Benchmark::runMixer()
+{
+    std::cout << "Running the audio mixer benchmark..." << std::endl;
+
+    isize count = keys.contains("quick") ? 500 : 5000;
+
+    VirtualC64 c64;
+    auto &c = *c64.c64.c64;
+
+    for (isize sids : { 1, 4 }) {
+
+        for (bool fading : { false, true }) {
+
+            MixerResult result = { .name = std::to_string(sids) + (sids == 1 ? " SID" : " SIDs") };
+            if (fading) result.name += " (fading)";
+
+            // Mix the same samples with both routines
+            u64 fingerprint[2];
+            result.nanos[0] = mixSamples<false>(c, sids, fading, 1.0, count, &fingerprint[0]);
+            result.nanos[1] = mixSamples<true>(c, sids, fading, 1.0, count, &fingerprint[1]);
+            result.samples = count * 882;
+
+            if (fingerprint[0] != fingerprint[1]) {
+
+                result.match = false;
+                returnCode = 1;
+            }
+
+            mixerResults.push_back(result);
+        }
+    }
+
+    // Mix with the maximum sample rate corrections to exercise the resampler
+    for (auto correction : { -AudioPort::maxCorrection, AudioPort::maxCorrection }) {
+
+        auto step = 1.0 / (1.0 + correction);
+
+        MixerResult result = { .name = correction < 0 ? "4 SIDs (slower)" : "4 SIDs (faster)" };
+
+        u64 fingerprint[2];
+        result.nanos[0] = mixSamples<false>(c, 4, false, step, count, &fingerprint[0]);
+        result.nanos[1] = mixSamples<true>(c, 4, false, step, count, &fingerprint[1]);
+        result.samples = count * 882;
+
+        if (fingerprint[0] != fingerprint[1] || !checkResampler(c, step)) {
+
+            result.match = false;
+            returnCode = 1;
+        }
+
+        mixerResults.push_back(result);
+    }
+}
+
+void
+Benchmark::runSilence()
+{
+    std::cout << "Running the silence detection benchmark..." << std::endl;
+
+    isize count = keys.contains("quick") ? 50 : 500;
+
+    for (auto sampling : { SAMPLING_FAST, SAMPLING_INTERPOLATE, SAMPLING_RESAMPLE }) {
+
+        SynthesisResult result = { .name = SamplingMethodEnum::key(sampling) };
+
+        // Synthesize the same frames with and without skipping silent phases
+        u64 fingerprint[2];
+        result.nanos[0] = synthesizeFrames("silence", sampling, false, false, count, &fingerprint[0], result);
+        result.nanos[1] = synthesizeFrames("silence", sampling, false, true, count, &fingerprint[1], result);
+
+        if (fingerprint[0] != fingerprint[1]) {
+
+            result.match = false;
+            returnCode = 1;
+        }
+
+        silenceResults.push_back(result);
+    }
+}
+
+void
+Benchmark::runRecorder()
+{
+    std::cout << "Running the recorder benchmark..." << std::endl;
+
+    isize count = keys.contains("quick") ? 50 : 500;
+
+    RecorderResult result = { .name = RecFormatEnum::key(REC_FORMAT_RAW) };
+
+    // Emulate the same frames with and without recording them
+    result.nanos[0] = recordFrames("raster", false, count, result);
+    result.nanos[1] = recordFrames("raster", true, count, result);
+
+    if (!result.match) returnCode = 1;
+    recorderResults.push_back(result);
+}
+
+i64
+Benchmark::recordFrames(const string &workload, bool record, isize count, RecorderResult &result)
+{
+    VirtualC64 c64; emu = &c64;
+
+    c64.c64.installOpenRoms();
+    c64.launch(this, vc64::process);
+    c64.set(OPT_REC_FORMAT, REC_FORMAT_RAW);
+    c64.powerOn();
+
+    // Compute all frames inside this thread (see renderFrames)
+    c64.suspend();
+
+    auto &c = *c64.c64.c64;
+
+    for (isize i = 0; i < bootFrames; i++) c.computeFrame(false);
+    start(c64, workload);
+    for (isize i = 0; i < warmupFrames; i++) c.computeFrame(false);
+
+    if (record) c64.recorder.startRecording(0, 0, Texture::width, Texture::height);
+
+    i64 nanos = 0;
+
+    for (isize i = 0; i < count; i++) {
+
+        auto start = util::Time::now();
+        c.computeFrame(false);
+        nanos += (util::Time::now() - start).asNanoseconds();
+    }
+
+    result.lines = count * c.vic.getLinesPerFrame();
+
+    if (record) {
+
+        // Let the recorder finalize the streams in the next frame
+        c64.recorder.stopRecording();
+        c.computeFrame(false);
+
+        auto info = c64.recorder.getInfo();
+        auto frameSize = 6 + 3 * Texture::width * Texture::height;
+
+        // The first frame is used to prepare the recorder
+        if (info.video.buffers + info.video.dropped != count - 1) result.match = false;
+        if (info.audio.buffers + info.audio.dropped != count - 1) result.match = false;
+
+        // Both streams must drop the same frames (the file sink never drops)
+        if (info.video.dropped != info.audio.dropped) result.match = false;
+        if (info.video.dropped != 0) result.match = false;
+
+        auto load = [](const string &path) {
+
+            std::ifstream file(path, std::ios::binary);
+            return string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        };
+
+        // Check the size of both files
+        auto y4m = load(c.recorder.videoStreamPath());
+        auto wav = load(c.recorder.audioStreamPath());
+        auto header = isize(y4m.find('\n') + 1);
+
+        if (isize(y4m.size()) != header + info.video.buffers * frameSize) result.match = false;
+        if (isize(wav.size()) != 44 + info.audio.bytes) result.match = false;
+
+        // Check the data chunk size in the WAV header
+        if (wav.size() >= 44) {
+
+            auto *p = (u8 *)wav.data() + 40;
+            if (HI_HI_LO_LO(p[3], p[2], p[1], p[0]) != u32(wav.size() - 44)) result.match = false;
+        }
+
+        // Check the frame markers
+        for (isize i = 0; i < info.video.buffers && result.match; i++) {
+            if (y4m.compare(header + i * frameSize, 6, "FRAME\n") != 0) result.match = false;
+        }
+
+        result.dropped = info.video.dropped;
+    }
+
+    c64.resume();
+    emu = nullptr;
+
+    return nanos;
+}
+
+template <bool V> i64
+Benchmark::mixSamples(C64 &c, isize sids, bool fading, double step, isize count, u64 *fingerprint)
+{
+    auto &port = c.audioPort;
+    constexpr isize samplesPerFrame = 882;
+
+    // Use different volumes and pan factors for all channels
+    for (isize k = 0; k < 4; k++) {
+
+        port.vol[k] = 0.0000025f * float(k + 1);
+        port.pan[k] = 0.1f + 0.25f * float(k);
+    }
+    port.resampleStep = step;
+    port.resamplePhase = 0.0;
+    for (auto &sample : port.resampleHist) sample = { };
+    port.clamp(0);
+
+    u32 seed = 1;
+    u64 hash = util::fnvInit64();
+    i64 nanos = 0;
+
+    for (isize i = 0; i < count; i++) {
+
+        // Feed all SIDs with pseudo-random samples
+        for (isize j = 0; j < sids; j++) {
+
+            auto &stream = c.sidBridge.sid[j].stream;
+            stream.clear();
+
+            for (isize k = 0; k < samplesPerFrame; k++) {
+
+                seed = seed * 1103515245 + 12345;
+                stream.write(short(seed >> 16));
+            }
+        }
+
+        // Start each frame with the same master volume
+        if (fading) {
+
+            port.volL.set(0.0); port.volR.set(0.0);
+            port.unmute(1000);
+
+        } else {
+
+            port.volL.set(0.8f); port.volR.set(0.6f);
+        }
+
+        auto start = util::Time::now();
+
+        if (sids == 1) {
+            fading ? port.mixSingleSID<true, V>(samplesPerFrame) : port.mixSingleSID<false, V>(samplesPerFrame);
+        } else {
+            fading ? port.mixMultiSID<true, V>(samplesPerFrame) : port.mixMultiSID<false, V>(samplesPerFrame);
+        }
+        port.flush();
+
+        nanos += (util::Time::now() - start).asNanoseconds();
+
+        // Collect the mixed samples
+        SamplePair pairs[2 * samplesPerFrame];
+        auto cnt = port.copy(pairs, 2 * samplesPerFrame);
+
+        for (isize k = 0; k < cnt; k++) {
+
+            u32 l, r;
+            std::memcpy(&l, &pairs[k].l, sizeof(l));
+            std::memcpy(&r, &pairs[k].r, sizeof(r));
+            hash = util::fnvIt64(hash, u64(l) << 32 | r);
+        }
+    }
+
+    *fingerprint = hash;
+    return nanos;
+}
+
+bool
+Benchmark::checkResampler(C64 &c, double step)
+{
+    auto &port = c.audioPort;
+    constexpr isize samplesPerFrame = 882;
+    constexpr isize frames = 50;
+
+    // Angular frequency of the test tone (441 Hz at 44.1 kHz)
+    const double omega = 2.0 * 3.14159265358979323846 / 100.0;
+
+    port.vol[0] = 0.0000025f;
+    port.pan[0] = 0.5f;
+    port.volL.set(0.8f);
+    port.volR.set(0.8f);
+    port.resampleStep = step;
+    port.resamplePhase = 0.0;
+    for (auto &sample : port.resampleHist) sample = { };
+    port.clamp(0);
+
+    std::vector<float> output;
+    isize n = 0;
+
+    for (isize i = 0; i < frames; i++) {
+
+        // Feed the first SID with a sine wave
+        auto &stream = c.sidBridge.sid[0].stream;
+        stream.clear();
+        for (isize k = 0; k < samplesPerFrame; k++, n++) {
+            stream.write(short(16000.0 * std::sin(omega * double(n))));
+        }
+
+        port.mixSingleSID<false, true>(samplesPerFrame);
+        port.flush();
+
+        SamplePair pairs[2 * samplesPerFrame];
+        auto cnt = port.copy(pairs, 2 * samplesPerFrame);
+        for (isize k = 0; k < cnt; k++) output.push_back(pairs[k].l);
+    }
+
+    // The resampler must produce one sample per step (it lags by one sample)
+    auto expected = double(frames * samplesPerFrame - 1) / step;
+    if (std::abs(double(output.size()) - expected) > 2.0) return false;
+
+    /* The output must be a continuous sine wave. A dropped sample, e.g., at a
+     * block or frame boundary, shows up as a step that is steeper than the
+     * wave itself. Duplicated samples are caught by the sample count.
+     */
+    float amplitude = 0.0f;
+    for (auto sample : output) amplitude = std::max(amplitude, std::abs(sample));
+
+    auto maxDelta = amplitude * float(omega * step) * 1.05f;
+    for (usize k = 4; k < output.size(); k++) {
+        if (std::abs(output[k] - output[k - 1]) > maxDelta) return false;
+    }
+
+    return amplitude > 0.0f;
+}
+
+i64
+Benchmark::synthesizeFrames(const string &workload, SamplingMethod sampling, bool async, bool powerSave, isize count, u64 *fingerprint, SynthesisResult &result)
+{
+    VirtualC64 c64; emu = &c64;
+
+    c64.c64.installOpenRoms();
+    c64.launch(this, vc64::process);
+
+    for (long i = 0; i < 4; i++) {
+
+        c64.set(OPT_SID_ENABLE, true, i);
+        c64.set(OPT_SID_SAMPLING, sampling, i);
+        c64.set(OPT_SID_ASYNC, async, i);
+        c64.set(OPT_SID_POWER_SAVE, powerSave, i);
+    }
+    c64.powerOn();
+
+    // Compute all frames inside this thread (see renderFrames)
+    c64.suspend();
+
+    auto &c = *c64.c64.c64;
+
+    for (isize i = 0; i < bootFrames; i++) c.computeFrame(true);
+    start(c64, workload);
+    for (isize i = 0; i < warmupFrames; i++) c.computeFrame(true);
+
+    u64 hash = util::fnvInit64();
+    i64 nanos = 0;
+
+    for (isize i = 0; i < count; i++) {
+
+        // Remember where the samples of this frame start
+        isize w[4];
+        for (isize j = 0; j < 4; j++) w[j] = c.sidBridge.sid[j].stream.end();
+
+        auto start = util::Time::now();
+        c.computeFrame(true);
+        nanos += (util::Time::now() - start).asNanoseconds();
+
+        // The mixer has consumed the samples, but they are still in place
+        for (isize j = 0; j < 4; j++) {
+
+            auto &stream = c.sidBridge.sid[j].stream;
+            for (isize k = w[j]; k != stream.end(); k = stream.next(k)) {
+                hash = util::fnvIt64(hash, u64(u16(stream.elements[k])) | u64(j) << 16);
+            }
+        }
+    }
+
+    result.lines = count * c.vic.getLinesPerFrame();
+
+    c64.resume();
+    emu = nullptr;
+
+    *fingerprint = hash;
+    return nanos;
+}
+
+bool
+Benchmark::waitForAlarm(i64 payload)
+{
+    for (isize i = 0; i < 600 && alarm != payload; i++) {
+        waitForWakeUp(util::Time::seconds(1.0));
+    }
+    return alarm == payload;
+}
+
+void
+process(const void *listener, Message msg)
+{
+    ((Benchmark *)listener)->process(msg);
+}
+
+void
+Benchmark::process(Message msg)
+{
+    switch (msg.type) {
+
+        case MSG_ALARM:
+
+            if (msg.value == ALARM_BOOTED) {
+
+                // Pause the emulator in the current cycle (see MSG_PAUSE)
+                emu->c64.c64->signalStop();
+                alarm = -ALARM_BOOTED;
+                break;
+            }
+            if (msg.value == ALARM_START) {
+
+                if (keys.contains("profile")) emu->c64.c64->setProfiling(true);
+                startTime = util::Time::now();
+                startFrame = i64(emu->c64.c64->frame);
+            }
+            if (msg.value == ALARM_STOP) {
+
+                stopTime = util::Time::now();
+                stopFrame = i64(emu->c64.c64->frame);
+                if (keys.contains("profile")) stats = emu->getStats();
+                checksum = emu->c64.c64->checksum(true);
+            }
+            alarm = msg.value;
+            wakeUp();
+            break;
+
+        case MSG_PAUSE:
+
+            if (alarm == -ALARM_BOOTED) {
+
+                alarm = ALARM_BOOTED;
+                wakeUp();
+            }
+            break;
+
+        case MSG_CPU_JAMMED:
+
+            returnCode = 1;
+            break;
+
+        default:
+            break;
+    }
+}
+
+void
+Benchmark::report(std::ostream &os) const
+{
+    os << std::endl;
+    os << std::setw(10) << std::left << "Workload";
+    os << std::setw(10) << std::right << "Frames";
+    os << std::setw(12) << std::right << "Cycles";
+    os << std::setw(12) << std::right << "FPS";
+    os << std::setw(12) << std::right << "ns/cycle";
+    os << std::setw(20) << std::right << "Checksum" << std::endl;
+
+    for (auto &r : results) {
+
+        os << std::setw(10) << std::left << r.name;
+
+        if (!r.skipped.empty()) {
+
+            os << "  skipped (" << r.skipped << ")" << std::endl;
+            continue;
+        }
+
+        os << std::setw(10) << std::right << r.frames;
+        os << std::setw(12) << std::right << r.cycles;
+        os << std::setw(12) << std::right << std::fixed << std::setprecision(1) << r.fps();
+        os << std::setw(12) << std::right << std::fixed << std::setprecision(3) << r.nsPerCycle();
+        os << "    " << std::hex << std::setw(16) << std::setfill('0') << r.checksum;
+        os << std::dec << std::setfill(' ') << std::endl;
+    }
+    os << std::endl;
+
+    if (!dispatchResults.empty()) {
+
+        os << std::setw(20) << std::left << "Program";
+        os << std::setw(12) << std::right << "Switch";
+        os << std::setw(12) << std::right << "Threaded";
+        os << std::setw(12) << std::right << "Speedup" << std::endl;
+
+        for (auto &r : dispatchResults) {
+
+            auto speedup = r.nanos[1] ? double(r.nanos[0]) / double(r.nanos[1]) : 0.0;
+
+            os << std::setw(20) << std::left << r.name;
+            os << std::setw(12) << std::right << std::fixed << std::setprecision(3) << r.nsPerCycle(0);
+            os << std::setw(12) << std::right << std::fixed << std::setprecision(3) << r.nsPerCycle(1);
+            os << std::setw(11) << std::right << std::fixed << std::setprecision(3) << speedup << "x";
+            os << std::endl;
+        }
+        os << std::endl;
+    }
+
+    if (!canvasResults.empty()) {
+
+        os << std::setw(20) << std::left << "Display mode";
+        os << std::setw(12) << std::right << "Per-pixel";
+        os << std::setw(12) << std::right << "Vectorized";
+        os << std::setw(12) << std::right << "Speedup" << std::endl;
+
+        for (auto &r : canvasResults) {
+
+            auto speedup = r.nanos[1] ? double(r.nanos[0]) / double(r.nanos[1]) : 0.0;
+
+            os << std::setw(20) << std::left << r.name;
+            os << std::setw(12) << std::right << std::fixed << std::setprecision(1) << r.nsPerLine(0);
+            os << std::setw(12) << std::right << std::fixed << std::setprecision(1) << r.nsPerLine(1);
+            os << std::setw(11) << std::right << std::fixed << std::setprecision(3) << speedup << "x";
+            if (!r.match) os << "    MISMATCH";
+            os << std::endl;
+        }
+        os << std::endl;
+    }
+
+    if (!spriteResults.empty()) {
+
+        os << std::setw(20) << std::left << "Sprite mode";
+        os << std::setw(12) << std::right << "Per-pixel";
+        os << std::setw(12) << std::right << "Tabulated";
+        os << std::setw(12) << std::right << "Speedup" << std::endl;
+
+        for (auto &r : spriteResults) {
+
+            auto speedup = r.nanos[1] ? double(r.nanos[0]) / double(r.nanos[1]) : 0.0;
+
+            os << std::setw(20) << std::left << r.name;
+            os << std::setw(12) << std::right << std::fixed << std::setprecision(1) << r.nsPerLine(0);
+            os << std::setw(12) << std::right << std::fixed << std::setprecision(1) << r.nsPerLine(1);
+            os << std::setw(11) << std::right << std::fixed << std::setprecision(3) << speedup << "x";
+            if (!r.match) os << "    MISMATCH";
+            os << std::endl;
+        }
+        os << std::endl;
+    }
+
+    if (!lineResults.empty()) {
+
+        os << std::setw(20) << std::left << "Workload";
+        os << std::setw(12) << std::right << "Uncached";
+        os << std::setw(12) << std::right << "Cached";
+        os << std::setw(12) << std::right << "Speedup";
+        os << std::setw(12) << std::right << "Hits" << std::endl;
+
+        for (auto &r : lineResults) {
+
+            auto speedup = r.nanos[1] ? double(r.nanos[0]) / double(r.nanos[1]) : 0.0;
+            auto hitRate = r.lines ? 100.0 * double(r.hits) / double(r.lines) : 0.0;
+
+            os << std::setw(20) << std::left << r.name;
+            os << std::setw(12) << std::right << std::fixed << std::setprecision(1) << r.nsPerLine(0);
+            os << std::setw(12) << std::right << std::fixed << std::setprecision(1) << r.nsPerLine(1);
+            os << std::setw(11) << std::right << std::fixed << std::setprecision(3) << speedup << "x";
+            os << std::setw(11) << std::right << std::fixed << std::setprecision(1) << hitRate << "%";
+            if (!r.match) os << "    MISMATCH";
+            os << std::endl;
+        }
+        os << std::endl;
+    }
+
+    if (!audioResults.empty()) {
+
+        os << std::setw(20) << std::left << "Sampling";
+        os << std::setw(12) << std::right << "Inline";
+        os << std::setw(12) << std::right << "Worker";
+        os << std::setw(12) << std::right << "Speedup" << std::endl;
+
+        for (auto &r : audioResults) {
+
+            auto speedup = r.nanos[1] ? double(r.nanos[0]) / double(r.nanos[1]) : 0.0;
+
+            os << std::setw(20) << std::left << r.name;
+            os << std::setw(12) << std::right << std::fixed << std::setprecision(1) << r.nsPerLine(0);
+            os << std::setw(12) << std::right << std::fixed << std::setprecision(1) << r.nsPerLine(1);
+            os << std::setw(11) << std::right << std::fixed << std::setprecision(3) << speedup << "x";
+            if (!r.match) os << "    MISMATCH";
+            os << std::endl;
+        }
+        os << std::endl;
+    }
+
+    if (!firResults.empty()) {
+
+        os << std::setw(20) << std::left << "Resampling";
+        os << std::setw(12) << std::right << "Portable";
+        os << std::setw(12) << std::right << "Vectorized";
+        os << std::setw(12) << std::right << "Speedup" << std::endl;
+
+        for (auto &r : firResults) {
+
+            auto speedup = r.nanos[1] ? double(r.nanos[0]) / double(r.nanos[1]) : 0.0;
+
+            os << std::setw(20) << std::left << r.name;
+            os << std::setw(12) << std::right << std::fixed << std::setprecision(1) << r.nsPerLine(0);
+            os << std::setw(12) << std::right << std::fixed << std::setprecision(1) << r.nsPerLine(1);
+            os << std::setw(11) << std::right << std::fixed << std::setprecision(3) << speedup << "x";
+            if (!r.match) os << "    MISMATCH";
+            os << std::endl;
+        }
+        os << std::endl;
+    }
+
+    if (!mixerResults.empty()) {
+
+        os << std::setw(20) << std::left << "Mixer";
+        os << std::setw(12) << std::right << "Scalar";
+        os << std::setw(12) << std::right << "Vectorized";
+        os << std::setw(12) << std::right << "Speedup" << std::endl;
+
+        for (auto &r : mixerResults) {
+
+            auto speedup = r.nanos[1] ? double(r.nanos[0]) / double(r.nanos[1]) : 0.0;
+
+            os << std::setw(20) << std::left << r.name;
+            os << std::setw(12) << std::right << std::fixed << std::setprecision(2) << r.nsPerSample(0);
+            os << std::setw(12) << std::right << std::fixed << std::setprecision(2) << r.nsPerSample(1);
+            os << std::setw(11) << std::right << std::fixed << std::setprecision(3) << speedup << "x";
+            if (!r.match) os << "    MISMATCH";
+            os << std::endl;
+        }
+        os << std::endl;
+    }
+
+    if (!silenceResults.empty()) {
+
+        os << std::setw(20) << std::left << "Sampling";
+        os << std::setw(12) << std::right << "Synthesized";
+        os << std::setw(12) << std::right << "Skipped";
+        os << std::setw(12) << std::right << "Speedup" << std::endl;
+
+        for (auto &r : silenceResults) {
+
+            auto speedup = r.nanos[1] ? double(r.nanos[0]) / double(r.nanos[1]) : 0.0;
+
+            os << std::setw(20) << std::left << r.name;
+            os << std::setw(12) << std::right << std::fixed << std::setprecision(1) << r.nsPerLine(0);
+            os << std::setw(12) << std::right << std::fixed << std::setprecision(1) << r.nsPerLine(1);
+            os << std::setw(11) << std::right << std::fixed << std::setprecision(3) << speedup << "x";
+            if (!r.match) os << "    MISMATCH";
+            os << std::endl;
+        }
+        os << std::endl;
+    }
+
+    if (!recorderResults.empty()) {
+
+        os << std::setw(20) << std::left << "Format";
+        os << std::setw(12) << std::right << "Plain";
+        os << std::setw(12) << std::right << "Recording";
+        os << std::setw(12) << std::right << "Overhead";
+        os << std::setw(12) << std::right << "Dropped" << std::endl;
+
+        for (auto &r : recorderResults) {
+
+            auto overhead = r.nanos[0] ? double(r.nanos[1]) / double(r.nanos[0]) : 0.0;
+
+            os << std::setw(20) << std::left << r.name;
+            os << std::setw(12) << std::right << std::fixed << std::setprecision(1) << r.nsPerLine(0);
+            os << std::setw(12) << std::right << std::fixed << std::setprecision(1) << r.nsPerLine(1);
+            os << std::setw(11) << std::right << std::fixed << std::setprecision(3) << overhead << "x";
+            os << std::setw(12) << std::right << r.dropped;
+            if (!r.match) os << "    MISMATCH";
+            os << std::endl;
+        }
+        os << std::endl;
+    }
+
+    if (!keys.contains("profile")) return;
+
+    os << std::setw(10) << std::left << "Workload";
+    for (isize i = 0; i < PROF_COUNT; i++) {
+        os << std::setw(11) << std::right << ProfilerSlotEnum::key(i);
+    }
+    os << std::endl;
+
+    for (auto &r : results) {
+
+        if (!r.profiled) continue;
+
+        os << std::setw(10) << std::left << r.name;
+        for (isize i = 0; i < PROF_COUNT; i++) {
+            os << std::setw(11) << std::right << std::fixed << std::setprecision(3) << r.profile[i];
+        }
+        os << std::endl;
+    }
+    os << std::endl;
+}
+
+void
+Benchmark::exportJSON(std::ostream &os) const
+{
+    os << "{" << std::endl;
+    os << "  \"version\": \"" << VirtualC64::version() << "\"," << std::endl;
+    os << "  \"build\": \"" << VirtualC64::build() << "\"," << std::endl;
+    os << "  \"frames\": " << frames << "," << std::endl;
+    os << "  \"workloads\": [" << std::endl;
+
+    for (usize i = 0; i < results.size(); i++) {
+
+        auto &r = results[i];
+
+        os << "    {" << std::endl;
+        os << "      \"name\": \"" << r.name << "\"," << std::endl;
+
+        if (!r.skipped.empty()) {
+
+            os << "      \"skipped\": \"" << r.skipped << "\"" << std::endl;
+
+        } else {
+
+            os << "      \"frames\": " << r.frames << "," << std::endl;
+            os << "      \"cycles\": " << r.cycles << "," << std::endl;
+            os << "      \"nanos\": " << r.nanos << "," << std::endl;
+            os << "      \"fps\": " << std::fixed << std::setprecision(3) << r.fps() << "," << std::endl;
+            os << "      \"nsPerCycle\": " << std::fixed << std::setprecision(3) << r.nsPerCycle() << "," << std::endl;
+            os << "      \"checksum\": \"" << std::hex << std::setw(16) << std::setfill('0') << r.checksum;
+            os << std::dec << std::setfill(' ') << "\"";
+
+            if (r.profiled) {
+
+                os << "," << std::endl << "      \"profile\": {" << std::endl;
+                for (isize i = 0; i < PROF_COUNT; i++) {
+
+                    os << "        \"" << ProfilerSlotEnum::key(i) << "\": ";
+                    os << std::fixed << std::setprecision(3) << r.profile[i];
+                    os << (i + 1 < PROF_COUNT ? "," : "") << std::endl;
+                }
+                os << "      }";
+            }
+            os << std::endl;
+        }
+
+        os << "    }" << (i + 1 < results.size() ? "," : "") << std::endl;
+    }
+
+    os << "  ]";
+
+    if (!dispatchResults.empty()) {
+
+        os << "," << std::endl << "  \"dispatch\": [" << std::endl;
+
+        for (usize i = 0; i < dispatchResults.size(); i++) {
+
+            auto &r = dispatchResults[i];
+
+            os << "    {" << std::endl;
+            os << "      \"name\": \"" << r.name << "\"," << std::endl;
+            os << "      \"cycles\": " << r.cycles << "," << std::endl;
+            os << "      \"switch\": " << std::fixed << std::setprecision(3) << r.nsPerCycle(0) << "," << std::endl;
+            os << "      \"threaded\": " << std::fixed << std::setprecision(3) << r.nsPerCycle(1) << std::endl;
+            os << "    }" << (i + 1 < dispatchResults.size() ? "," : "") << std::endl;
+        }
+        os << "  ]";
+    }
+
+    if (!canvasResults.empty()) {
+
+        os << "," << std::endl << "  \"canvas\": [" << std::endl;
+
+        for (usize i = 0; i < canvasResults.size(); i++) {
+
+            auto &r = canvasResults[i];
+
+            os << "    {" << std::endl;
+            os << "      \"name\": \"" << r.name << "\"," << std::endl;
+            os << "      \"lines\": " << r.lines << "," << std::endl;
+            os << "      \"perPixel\": " << std::fixed << std::setprecision(3) << r.nsPerLine(0) << "," << std::endl;
+            os << "      \"vectorized\": " << std::fixed << std::setprecision(3) << r.nsPerLine(1) << "," << std::endl;
+            os << "      \"match\": " << (r.match ? "true" : "false") << std::endl;
+            os << "    }" << (i + 1 < canvasResults.size() ? "," : "") << std::endl;
+        }
+        os << "  ]";
+    }
+
+    if (!spriteResults.empty()) {
+
+        os << "," << std::endl << "  \"sprites\": [" << std::endl;
+
+        for (usize i = 0; i < spriteResults.size(); i++) {
+
+            auto &r = spriteResults[i];
+
+            os << "    {" << std::endl;
+            os << "      \"name\": \"" << r.name << "\"," << std::endl;
+            os << "      \"lines\": " << r.lines << "," << std::endl;
+            os << "      \"perPixel\": " << std::fixed << std::setprecision(3) << r.nsPerLine(0) << "," << std::endl;
+            os << "      \"tabulated\": " << std::fixed << std::setprecision(3) << r.nsPerLine(1) << "," << std::endl;
+            os << "      \"match\": " << (r.match ? "true" : "false") << std::endl;
+            os << "    }" << (i + 1 < spriteResults.size() ? "," : "") << std::endl;
+        }
+        os << "  ]";
+    }
+
+    if (!lineResults.empty()) {
+
+        os << "," << std::endl << "  \"lines\": [" << std::endl;
+
+        for (usize i = 0; i < lineResults.size(); i++) {
+
+            auto &r = lineResults[i];
+
+            os << "    {" << std::endl;
+            os << "      \"name\": \"" << r.name << "\"," << std::endl;
+            os << "      \"lines\": " << r.lines << "," << std::endl;
+            os << "      \"uncached\": " << std::fixed << std::setprecision(3) << r.nsPerLine(0) << "," << std::endl;
+            os << "      \"cached\": " << std::fixed << std::setprecision(3) << r.nsPerLine(1) << "," << std::endl;
+            os << "      \"hits\": " << r.hits << "," << std::endl;
+            os << "      \"match\": " << (r.match ? "true" : "false") << std::endl;
+            os << "    }" << (i + 1 < lineResults.size() ? "," : "") << std::endl;
+        }
+        os << "  ]";
+    }
+
+    if (!audioResults.empty()) {
+
+        os << "," << std::endl << "  \"audio\": [" << std::endl;
+
+        for (usize i = 0; i < audioResults.size(); i++) {
+
+            auto &r = audioResults[i];
+
+            os << "    {" << std::endl;
+            os << "      \"name\": \"" << r.name << "\"," << std::endl;
+            os << "      \"lines\": " << r.lines << "," << std::endl;
+            os << "      \"inline\": " << std::fixed << std::setprecision(3) << r.nsPerLine(0) << "," << std::endl;
+            os << "      \"worker\": " << std::fixed << std::setprecision(3) << r.nsPerLine(1) << "," << std::endl;
+            os << "      \"match\": " << (r.match ? "true" : "false") << std::endl;
+            os << "    }" << (i + 1 < audioResults.size() ? "," : "") << std::endl;
+        }
+        os << "  ]";
+    }
+
+    if (!firResults.empty()) {
+
+        os << "," << std::endl << "  \"fir\": [" << std::endl;
+
+        for (usize i = 0; i < firResults.size(); i++) {
+
+            auto &r = firResults[i];
+
+            os << "    {" << std::endl;
+            os << "      \"name\": \"" << r.name << "\"," << std::endl;
+            os << "      \"lines\": " << r.lines << "," << std::endl;
+            os << "      \"portable\": " << std::fixed << std::setprecision(3) << r.nsPerLine(0) << "," << std::endl;
+            os << "      \"vectorized\": " << std::fixed << std::setprecision(3) << r.nsPerLine(1) << "," << std::endl;
+            os << "      \"match\": " << (r.match ? "true" : "false") << std::endl;
+            os << "    }" << (i + 1 < firResults.size() ? "," : "") << std::endl;
+        }
+        os << "  ]";
+    }
+
+    if (!mixerResults.empty()) {
+
+        os << "," << std::endl << "  \"mixer\": [" << std::endl;
+
+        for (usize i = 0; i < mixerResults.size(); i++) {
+
+            auto &r = mixerResults[i];
+
+            os << "    {" << std::endl;
+            os << "      \"name\": \"" << r.name << "\"," << std::endl;
+            os << "      \"samples\": " << r.samples << "," << std::endl;
+            os << "      \"scalar\": " << std::fixed << std::setprecision(3) << r.nsPerSample(0) << "," << std::endl;
+            os << "      \"vectorized\": " << std::fixed << std::setprecision(3) << r.nsPerSample(1) << "," << std::endl;
+            os << "      \"match\": " << (r.match ? "true" : "false") << std::endl;
+            os << "    }" << (i + 1 < mixerResults.size() ? "," : "") << std::endl;
+        }
+        os << "  ]";
+    }
+
+    if (!silenceResults.empty()) {
+
+        os << "," << std::endl << "  \"silence\": [" << std::endl;
+
+        for (usize i = 0; i < silenceResults.size(); i++) {
+
+            auto &r = silenceResults[i];
+
+            os << "    {" << std::endl;
+            os << "      \"name\": \"" << r.name << "\"," << std::endl;
+            os << "      \"lines\": " << r.lines << "," << std::endl;
+            os << "      \"synthesized\": " << std::fixed << std::setprecision(3) << r.nsPerLine(0) << "," << std::endl;
+            os << "      \"skipped\": " << std::fixed << std::setprecision(3) << r.nsPerLine(1) << "," << std::endl;
+            os << "      \"match\": " << (r.match ? "true" : "false") << std::endl;
+            os << "    }" << (i + 1 < silenceResults.size() ? "," : "") << std::endl;
+        }
+        os << "  ]";
+    }
+
+    if (!recorderResults.empty()) {
+
+        os << "," << std::endl << "  \"recorder\": [" << std::endl;
+
+        for (usize i = 0; i < recorderResults.size(); i++) {
+
+            auto &r = recorderResults[i];
+
+            os << "    {" << std::endl;
+            os << "      \"name\": \"" << r.name << "\"," << std::endl;
+            os << "      \"lines\": " << r.lines << "," << std::endl;
+            os << "      \"plain\": " << std::fixed << std::setprecision(3) << r.nsPerLine(0) << "," << std::endl;
+            os << "      \"recording\": " << std::fixed << std::setprecision(3) << r.nsPerLine(1) << "," << std::endl;
+            os << "      \"dropped\": " << r.dropped << "," << std::endl;
+            os << "      \"match\": " << (r.match ? "true" : "false") << std::endl;
+            os << "    }" << (i + 1 < recorderResults.size() ? "," : "") << std::endl;
+        }
+        os << "  ]";
+    }
+
+    os << std::endl << "}" << std::endl;
+}
+
+}
@@ -0,0 +1,315 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// This FILE is dual-licensed. You are free to choose between:
+//
+//     - The GNU General Public License v3 (or any later version)
+//     - The Mozilla Public License v2
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR MPL-2.0
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#include "VirtualC64.h"
+#include "Wakeable.h"
+#include <map>
+
+namespace vc64 {
+
+struct BenchSyntaxError : public std::runtime_error {
+    using runtime_error::runtime_error;
+};
+
+// The message listener
+void process(const void *listener, Message msg);
+
+// Result of a single workload
+struct BenchResult {
+
+    // Name of the workload
+    string name;
+
+    // Reason for skipping the workload (empty if the workload has been run)
+    string skipped;
+
+    // Number of emulated frames and cycles
+    i64 frames = 0;
+    i64 cycles = 0;
+
+    // Elapsed host time in nanoseconds
+    i64 nanos = 0;
+
+    // Emulated frames per second
+    double fps() const { return nanos ? double(frames) * 1e9 / double(nanos) : 0.0; }
+
+    // Host time per emulated cycle in nanoseconds
+    double nsPerCycle() const { return cycles ? double(nanos) / double(cycles) : 0.0; }
+
+    // Checksum of the emulator state at the end of the workload
+    u64 checksum = 0;
+
+    // Host time per emulated cycle spent in each component (if profiled)
+    bool profiled = false;
+    double profile[PROF_COUNT] = { };
+};
+
+// Result of the dispatch micro-benchmark for a single program
+struct DispatchResult {
+
+    // Name of the program
+    string name;
+
+    // Number of executed CPU cycles per engine
+    i64 cycles = 0;
+
+    // Elapsed host time in nanoseconds (switch-based and threaded engine)
+    i64 nanos[2] = { };
+
+    // Host time per executed cycle in nanoseconds
+    double nsPerCycle(isize engine) const { return cycles ? double(nanos[engine]) / double(cycles) : 0.0; }
+};
+
+// Result of the canvas or sprite micro-benchmark for a single display mode
+struct CanvasResult {
+
+    // Name of the display mode
+    string name;
+
+    // Number of drawn scanlines per drawing routine
+    isize lines = 0;
+
+    // Elapsed host time in nanoseconds (per-pixel and vectorized routine)
+    i64 nanos[2] = { };
+
+    // Indicates if both drawing routines produced the same output
+    bool match = true;
+
+    // Number of scanlines copied from the scanline cache (if used)
+    isize hits = 0;
+
+    // Host time per scanline in nanoseconds
+    double nsPerLine(isize routine) const { return lines ? double(nanos[routine]) / double(lines) : 0.0; }
+};
+
+// Result of the audio, FIR, or silence micro-benchmark for a single variant
+struct SynthesisResult {
+
+    // Name of the variant
+    string name;
+
+    // Number of emulated scanlines per configuration
+    isize lines = 0;
+
+    // Elapsed host time in nanoseconds (reference and optimized configuration)
+    i64 nanos[2] = { };
+
+    // Indicates if both configurations produced the same samples
+    bool match = true;
+
+    // Host time per scanline in nanoseconds
+    double nsPerLine(isize config) const { return lines ? double(nanos[config]) / double(lines) : 0.0; }
+};
+
+// Result of the mixer micro-benchmark for a single SID setup
+struct MixerResult {
+
+    // Name of the SID setup
+    string name;
+
+    // Number of mixed samples per mixing routine
+    isize samples = 0;
+
+    // Elapsed host time in nanoseconds (scalar and vectorized routine)
+    i64 nanos[2] = { };
+
+    // Indicates if both mixing routines produced the same output
+    bool match = true;
+
+    // Host time per sample in nanoseconds
+    double nsPerSample(isize routine) const { return samples ? double(nanos[routine]) / double(samples) : 0.0; }
+};
+
+// Result of the recorder benchmark for a single output format
+struct RecorderResult {
+
+    // Name of the output format
+    string name;
+
+    // Number of emulated scanlines per run
+    isize lines = 0;
+
+    // Elapsed host time in nanoseconds (without and with recording)
+    i64 nanos[2] = { };
+
+    // Indicates if the recorded streams passed all checks
+    bool match = true;
+
+    // Number of frames dropped by the recorder
+    isize dropped = 0;
+
+    // Host time per scanline in nanoseconds
+    double nsPerLine(isize run) const { return lines ? double(nanos[run]) / double(lines) : 0.0; }
+};
+
+/* Headless benchmark runner
+ *
+ * The runner boots the MEGA65 OpenROMs, executes a fixed set of canonical
+ * workloads in warp mode, and reports the throughput of each workload. The
+ * measurement interval is delimited by two alarms which are serviced inside
+ * the emulator thread. Hence, the number of emulated cycles is exact and the
+ * host time is taken at the precise moment the interval starts or ends.
+ */
+class Benchmark : Wakeable {
+
+    // Alarm payloads
+    static constexpr i64 ALARM_BOOTED = 1;
+    static constexpr i64 ALARM_START = 2;
+    static constexpr i64 ALARM_STOP = 3;
+
+    // Duration of the boot phase and the warm-up phase in frames
+    static constexpr isize bootFrames = 150;
+    static constexpr isize warmupFrames = 25;
+
+    // Parsed command line arguments
+    std::map<string,string> keys;
+
+    // Additional Roms (e.g., a VC1541 Rom for the drive workload)
+    std::vector<string> roms;
+
+    // Additional programs for the dispatch micro-benchmark
+    std::vector<string> programs;
+
+    // Number of measured frames per workload
+    isize frames = 500;
+
+    // Render interval (-1 = keep the default)
+    isize renderInterval = -1;
+
+    // The emulator instance of the currently running workload
+    VirtualC64 *emu = nullptr;
+
+    // The most recently fired alarm
+    std::atomic<i64> alarm = 0;
+
+    // Time stamps and frame counters recorded by the alarm handler
+    util::Time startTime, stopTime;
+    i64 startFrame = 0, stopFrame = 0;
+
+    // Execution profile recorded by the alarm handler
+    EmulatorStats stats = { };
+
+    // State checksum recorded by the alarm handler
+    u64 checksum = 0;
+
+    // Collected results
+    std::vector<BenchResult> results;
+    std::vector<DispatchResult> dispatchResults;
+    std::vector<CanvasResult> canvasResults;
+    std::vector<CanvasResult> spriteResults;
+    std::vector<CanvasResult> lineResults;
+    std::vector<SynthesisResult> audioResults;
+    std::vector<SynthesisResult> firResults;
+    std::vector<MixerResult> mixerResults;
+    std::vector<SynthesisResult> silenceResults;
+    std::vector<RecorderResult> recorderResults;
+
+    // Return code
+    int returnCode = 0;
+
+
+    //
+    // Launching
+    //
+
+public:
+
+    // Main entry point
+    int main(int argc, char *argv[]);
+
+private:
+
+    // Parses the command line arguments
+    void parseArguments(int argc, char *argv[]);
+
+    // Checks all command line arguments for conistency
+    void checkArguments() throws;
+
+
+    //
+    // Running
+    //
+
+private:
+
+    // Runs a single workload
+    void run(const string &workload);
+
+    // Configures the emulator for a certain workload
+    string configure(VirtualC64 &c64, const string &workload);
+
+    // Starts a workload in a booted machine
+    void start(VirtualC64 &c64, const string &workload);
+
+    // Flashes a program into memory and jumps to the start address
+    void launchProgram(VirtualC64 &c64, const u8 *prg, isize len);
+
+    // Waits for a specific alarm to fire
+    bool waitForAlarm(i64 payload);
+
+    // Compares both CPU dispatch engines on a set of programs
+    void runDispatch();
+    void runDispatch(VirtualC64 &c64, const string &name, const std::vector<u8> &prg);
+
+    // Compares both canvas drawing routines in all valid display modes
+    void runCanvas();
+    template <bool V> i64 drawCanvas(class VICII &vic, DisplayMode mode, isize lines, u64 *fingerprint);
+
+    // Compares both sprite drawing routines in all sprite modes
+    void runSprites();
+    template <bool T> i64 drawSprites(class VICII &vic, isize mode, isize lines, u64 *fingerprint);
+
+    // Renders a workload with and without the scanline cache
+    void runLines();
+    i64 renderFrames(const string &workload, bool cached, isize count, u64 *fingerprint, CanvasResult &result);
+
+    // Synthesizes the SID workload with and without the audio worker
+    void runAudio();
+    i64 synthesizeFrames(const string &workload, SamplingMethod sampling, bool async, bool powerSave, isize count, u64 *fingerprint, SynthesisResult &result);
+
+    // Resamples the SID workload with the portable and the vectorized FIR kernel
+    void runFIR();
+
+    // Compares both audio mixing routines with one and four SIDs
+    void runMixer();
+    template <bool V> i64 mixSamples(class C64 &c, isize sids, bool fading, double step, isize count, u64 *fingerprint);
+    bool checkResampler(class C64 &c, double step);
+
+    // Synthesizes an intermittently silent workload with and without silence detection
+    void runSilence();
+
+    // Emulates the raster workload with and without recording it in raw format
+    void runRecorder();
+    i64 recordFrames(const string &workload, bool record, isize count, RecorderResult &result);
+
+public:
+
+    // Processes an incoming message
+    void process(Message msg);
+
+
+    //
+    // Reporting
+    //
+
+private:
+
+    // Prints the results in human-readable form
+    void report(std::ostream &os) const;
+
+    // Writes the results in JSON format
+    void exportJSON(std::ostream &os) const;
+};
+
+}
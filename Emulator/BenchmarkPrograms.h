@@ -0,0 +1,261 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// This FILE is dual-licensed. You are free to choose between:
+//
+//     - The GNU General Public License v3 (or any later version)
+//     - The Mozilla Public License v2
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR MPL-2.0
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+/* Raster stress test
+ *
+ *         SEI
+ *         LDA #$FF
+ *         STA $D015       ; Enable all sprites
+ *         STA $D017       ; Expand vertically
+ *         STA $D01D       ; Expand horizontally
+ *         STA $D01C       ; Multicolor mode
+ *         LDX #$0E
+ * sprites TXA
+ *         ASL
+ *         ASL
+ *         ASL
+ *         STA $D000,X     ; X coordinate
+ *         LDA #$70
+ *         STA $D001,X     ; Y coordinate
+ *         DEX
+ *         DEX
+ *         BPL sprites
+ * main    LDA $D012
+ *         AND #$07
+ *         ORA #$18
+ *         STA $D011       ; Force a bad line in each rasterline
+ *         INC $D020
+ *         JMP main
+ */
+static const unsigned char rasterBench[] = {
+
+    0x00, 0xC0, 0x78, 0xA9, 0xFF, 0x8D, 0x15, 0xD0, 0x8D, 0x17, 0xD0, 0x8D,
+    0x1D, 0xD0, 0x8D, 0x1C, 0xD0, 0xA2, 0x0E, 0x8A, 0x0A, 0x0A, 0x0A, 0x9D,
+    0x00, 0xD0, 0xA9, 0x70, 0x9D, 0x01, 0xD0, 0xCA, 0xCA, 0x10, 0xF0, 0xAD,
+    0x12, 0xD0, 0x29, 0x07, 0x09, 0x18, 0x8D, 0x11, 0xD0, 0xEE, 0x20, 0xD0,
+    0x4C, 0x21, 0xC0
+};
+
+/* Multi-SID stress test
+ *
+ *         LDX #$60
+ * init    LDA #$0F
+ *         STA $D418,X     ; Volume
+ *         LDA #$00
+ *         STA $D405,X     ; Attack / Decay
+ *         STA $D40C,X
+ *         STA $D413,X
+ *         LDA #$F0
+ *         STA $D406,X     ; Sustain / Release
+ *         STA $D40D,X
+ *         STA $D414,X
+ *         LDA #$08
+ *         STA $D403,X     ; Pulse width
+ *         STA $D40A,X
+ *         LDA #$21
+ *         STA $D404,X     ; Sawtooth
+ *         LDA #$41
+ *         STA $D40B,X     ; Pulse
+ *         LDA #$11
+ *         STA $D412,X     ; Triangle
+ *         TXA
+ *         SEC
+ *         SBC #$20        ; Next SID
+ *         TAX
+ *         BCS init
+ * main    INY
+ *         LDX #$60
+ * voices  TYA
+ *         STA $D401,X     ; Frequency (voice 1)
+ *         EOR #$FF
+ *         STA $D408,X     ; Frequency (voice 2)
+ *         TYA
+ *         LSR
+ *         STA $D40F,X     ; Frequency (voice 3)
+ *         TXA
+ *         SEC
+ *         SBC #$20        ; Next SID
+ *         TAX
+ *         BCS voices
+ * delay   DEX
+ *         BNE delay
+ *         JMP main
+ */
+static const unsigned char sidBench[] = {
+
+    0x00, 0xC0, 0xA2, 0x60, 0xA9, 0x0F, 0x9D, 0x18, 0xD4, 0xA9, 0x00, 0x9D,
+    0x05, 0xD4, 0x9D, 0x0C, 0xD4, 0x9D, 0x13, 0xD4, 0xA9, 0xF0, 0x9D, 0x06,
+    0xD4, 0x9D, 0x0D, 0xD4, 0x9D, 0x14, 0xD4, 0xA9, 0x08, 0x9D, 0x03, 0xD4,
+    0x9D, 0x0A, 0xD4, 0xA9, 0x21, 0x9D, 0x04, 0xD4, 0xA9, 0x41, 0x9D, 0x0B,
+    0xD4, 0xA9, 0x11, 0x9D, 0x12, 0xD4, 0x8A, 0x38, 0xE9, 0x20, 0xAA, 0xB0,
+    0xC7, 0xC8, 0xA2, 0x60, 0x98, 0x9D, 0x01, 0xD4, 0x49, 0xFF, 0x9D, 0x08,
+    0xD4, 0x98, 0x4A, 0x9D, 0x0F, 0xD4, 0x8A, 0x38, 0xE9, 0x20, 0xAA, 0xB0,
+    0xEB, 0xCA, 0xD0, 0xFD, 0x4C, 0x3B, 0xC0
+};
+
+/* SID silence test
+ *
+ *         LDX #$60
+ * init    LDA #$0F
+ *         STA $D418,X     ; Volume
+ *         LDA #$00
+ *         STA $D405,X     ; Attack / Decay
+ *         LDA #$F0
+ *         STA $D406,X     ; Sustain / Release
+ *         TXA
+ *         SEC
+ *         SBC #$20        ; Next SID
+ *         TAX
+ *         BCS init
+ * main    INY
+ *         LDX #$60
+ * notes   TYA
+ *         STA $D401,X     ; Frequency
+ *         LDA #$21
+ *         STA $D404,X     ; Sawtooth, gate on
+ *         TXA
+ *         SEC
+ *         SBC #$20        ; Next SID
+ *         TAX
+ *         BCS notes
+ *         JSR delay
+ *         LDX #$60
+ * off     LDA #$20
+ *         STA $D404,X     ; Gate off
+ *         TXA
+ *         SEC
+ *         SBC #$20        ; Next SID
+ *         TAX
+ *         BCS off
+ *         LDA #$00
+ *         STA $FB
+ * pause   JSR delay       ; Stay silent for about 1/3 second
+ *         DEC $FB
+ *         BNE pause
+ *         JMP main
+ * delay   LDX #$00
+ * loop    DEX
+ *         BNE loop
+ *         RTS
+ */
+static const unsigned char silenceBench[] = {
+
+    0x00, 0xC0, 0xA2, 0x60, 0xA9, 0x0F, 0x9D, 0x18, 0xD4, 0xA9, 0x00, 0x9D,
+    0x05, 0xD4, 0xA9, 0xF0, 0x9D, 0x06, 0xD4, 0x8A, 0x38, 0xE9, 0x20, 0xAA,
+    0xB0, 0xEA, 0xC8, 0xA2, 0x60, 0x98, 0x9D, 0x01, 0xD4, 0xA9, 0x21, 0x9D,
+    0x04, 0xD4, 0x8A, 0x38, 0xE9, 0x20, 0xAA, 0xB0, 0xF0, 0x20, 0x4A, 0xC0,
+    0xA2, 0x60, 0xA9, 0x20, 0x9D, 0x04, 0xD4, 0x8A, 0x38, 0xE9, 0x20, 0xAA,
+    0xB0, 0xF4, 0xA9, 0x00, 0x85, 0xFB, 0x20, 0x4A, 0xC0, 0xC6, 0xFB, 0xD0,
+    0xF9, 0x4C, 0x18, 0xC0, 0xA2, 0x00, 0xCA, 0xD0, 0xFD, 0x60
+};
+
+/* REU stress test
+ *
+ *         LDA #$00
+ *         STA $DF02
+ *         STA $DF04
+ *         STA $DF05
+ *         STA $DF06       ; REU address = $000000
+ *         STA $DF07
+ *         STA $DF0A
+ *         LDA #$04
+ *         STA $DF03       ; C64 address = $0400
+ *         LDA #$10
+ *         STA $DF08       ; Transfer length = $1000
+ * main    LDA #$B0
+ *         STA $DF01       ; Stash (autoload)
+ *         LDA #$B2
+ *         STA $DF01       ; Swap (autoload)
+ *         LDA #$B1
+ *         STA $DF01       ; Fetch (autoload)
+ *         INC $D020
+ *         JMP main
+ */
+static const unsigned char reuBench[] = {
+
+    0x00, 0xC0, 0xA9, 0x00, 0x8D, 0x02, 0xDF, 0x8D, 0x04, 0xDF, 0x8D, 0x05,
+    0xDF, 0x8D, 0x06, 0xDF, 0x8D, 0x07, 0xDF, 0x8D, 0x0A, 0xDF, 0xA9, 0x04,
+    0x8D, 0x03, 0xDF, 0xA9, 0x10, 0x8D, 0x08, 0xDF, 0xA9, 0xB0, 0x8D, 0x01,
+    0xDF, 0xA9, 0xB2, 0x8D, 0x01, 0xDF, 0xA9, 0xB1, 0x8D, 0x01, 0xDF, 0xEE,
+    0x20, 0xD0, 0x4C, 0x1E, 0xC0
+};
+
+/* Event stress test
+ *
+ *         SEI
+ *         LDA #$7F
+ *         STA $DC0D       ; Disable CIA interrupts
+ *         STA $DD0D
+ *         LDA #$07
+ *         STA $DC04       ; Timer latches = $0007
+ *         STA $DC06
+ *         STA $DD04
+ *         STA $DD06
+ *         LDA #$00
+ *         STA $DC05
+ *         STA $DC07
+ *         STA $DD05
+ *         STA $DD07
+ *         LDA #$11
+ *         STA $DC0E       ; Start all timers in continuous mode
+ *         STA $DC0F
+ *         STA $DD0E
+ *         STA $DD0F
+ * main    LDA $DC0D       ; Acknowledge timer underflows
+ *         LDA $DD0D
+ *         INC $D020
+ *         JMP main
+ */
+static const unsigned char eventBench[] = {
+
+    0x00, 0xC0, 0x78, 0xA9, 0x7F, 0x8D, 0x0D, 0xDC, 0x8D, 0x0D, 0xDD, 0xA9,
+    0x07, 0x8D, 0x04, 0xDC, 0x8D, 0x06, 0xDC, 0x8D, 0x04, 0xDD, 0x8D, 0x06,
+    0xDD, 0xA9, 0x00, 0x8D, 0x05, 0xDC, 0x8D, 0x07, 0xDC, 0x8D, 0x05, 0xDD,
+    0x8D, 0x07, 0xDD, 0xA9, 0x11, 0x8D, 0x0E, 0xDC, 0x8D, 0x0F, 0xDC, 0x8D,
+    0x0E, 0xDD, 0x8D, 0x0F, 0xDD, 0xAD, 0x0D, 0xDC, 0xAD, 0x0D, 0xDD, 0xEE,
+    0x20, 0xD0, 0x4C, 0x33, 0xC0
+};
+
+/* CPU stress test
+ *
+ * main    LDA #$00
+ *         STA $FB
+ *         LDA #$A0
+ *         STA $FC         ; Pointer = $A000 (Basic Rom)
+ *         LDY #$00
+ * loop    LDA ($FB),Y
+ *         JSR sum
+ *         INY
+ *         BNE loop
+ *         INC $FC
+ *         LDA $FC
+ *         CMP #$C0
+ *         BNE loop
+ *         JMP main
+ * sum     CLC
+ *         ADC $FD
+ *         STA $FD         ; Checksum
+ *         EOR $C100,X
+ *         ROL
+ *         TAX
+ *         ROL $FE
+ *         RTS
+ */
+static const unsigned char cpuBench[] = {
+
+    0x00, 0xC0, 0xA9, 0x00, 0x85, 0xFB, 0xA9, 0xA0, 0x85, 0xFC, 0xA0, 0x00,
+    0xB1, 0xFB, 0x20, 0x1D, 0xC0, 0xC8, 0xD0, 0xF8, 0xE6, 0xFC, 0xA5, 0xFC,
+    0xC9, 0xC0, 0xD0, 0xF0, 0x4C, 0x00, 0xC0, 0x18, 0x65, 0xFD, 0x85, 0xFD,
+    0x5D, 0x00, 0xC1, 0x2A, 0xAA, 0x26, 0xFE, 0x60
+};
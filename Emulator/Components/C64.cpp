@@ -17,6 +17,7 @@
 #include "RomDatabase.h"
 #include "OpenRoms.h"
 #include <algorithm>
+#include <bit>
 #include <queue>
 
 namespace vc64 {
@@ -282,6 +283,12 @@ C64::_didReset(bool hard)
     msgQueue.put(MSG_RESET);
 }
 
+void
+C64::_didLoad()
+{
+    updatePendingMask();
+}
+
 void
 C64::initialize()
 {
@@ -319,6 +326,7 @@ C64::operator << (SerResetter &worker)
         eventid[i] = (EventID)0;
         data[i] = 0;
     }
+    updatePendingMask();
 
     // Schedule initial events
     scheduleAbs<SLOT_CIA1>(cpu.clock, CIA_EXECUTE);
@@ -735,44 +743,108 @@ C64::update(CmdQueue &queue)
     if (retroShell.isDirty) { retroShell.isDirty = false; msgQueue.put(MSG_RSH_UPDATE); }
 }
 
+bool
+C64::canSkipFrame() const
+{
+    // Always render requested frames and frames that are recorded
+    if (frameRequested || recorder.isRecording()) return false;
+
+    // In warp mode, render one out of eight frames if power-saving is enabled
+    if (emulator.get(OPT_VICII_POWER_SAVE) && emulator.isWarping() && (frame & 7) != 0) return true;
+
+    // Render one out of N frames (or requested frames only if N is 0)
+    return config.renderInterval == 0 || frame % config.renderInterval != 0;
+}
+
 void
 C64::computeFrame()
 {
-    if (emulator.get(OPT_VICII_POWER_SAVE)) {
-        computeFrame(emulator.isWarping() && (frame & 7) != 0);
-    } else {
-        computeFrame(false);
-    }
+    computeFrame(canSkipFrame());
 }
 
 void 
 C64::computeFrame(bool headless)
 {
     setHeadless(headless);
+    if (!headless) frameRequested = false;
 
     cpu.debugger.watchpointPC = -1;
     cpu.debugger.breakpointPC = -1;
 
+    /* Only enable the CPU debug checks if breakpoints, watchpoints, or
+     * instruction logging are active. The other debug features are specialized
+     * elsewhere: VICII selects the headless or DMA-debugging cycle functions
+     * in beginFrame() and Memory routes all accesses through the slow path if
+     * the heatmap is enabled.
+     */
+    bool debug = cpu.flags != 0;
+
     // Dispatch
-    switch ((drive8.isPoweredOn()                   ? 4 : 0) |
-            (drive9.isPoweredOn()                   ? 2 : 0) |
-            (expansionport.needsAccurateEmulation() ? 1 : 0) ) {
-
-        case 0b000: execute <false, false, false> (); break;
-        case 0b001: execute <false, false, true>  (); break;
-        case 0b010: execute <false, true,  false> (); break;
-        case 0b011: execute <false, true,  true>  (); break;
-        case 0b100: execute <true,  false, false> (); break;
-        case 0b101: execute <true,  false, true>  (); break;
-        case 0b110: execute <true,  true,  false> (); break;
-        case 0b111: execute <true,  true,  true>  (); break;
+    if (profiling) {
+
+        auto cycle = cpu.clock;
+        auto ticks = util::rdtsc();
+
+        switch ((drive8.isPoweredOn()                   ? 8 : 0) |
+                (drive9.isPoweredOn()                   ? 4 : 0) |
+                (expansionport.needsAccurateEmulation() ? 2 : 0) |
+                (debug                                  ? 1 : 0) ) {
+
+            case 0b0000: execute <false, false, false, false, true> (); break;
+            case 0b0001: execute <false, false, false, true,  true> (); break;
+            case 0b0010: execute <false, false, true,  false, true> (); break;
+            case 0b0011: execute <false, false, true,  true,  true> (); break;
+            case 0b0100: execute <false, true,  false, false, true> (); break;
+            case 0b0101: execute <false, true,  false, true,  true> (); break;
+            case 0b0110: execute <false, true,  true,  false, true> (); break;
+            case 0b0111: execute <false, true,  true,  true,  true> (); break;
+            case 0b1000: execute <true,  false, false, false, true> (); break;
+            case 0b1001: execute <true,  false, false, true,  true> (); break;
+            case 0b1010: execute <true,  false, true,  false, true> (); break;
+            case 0b1011: execute <true,  false, true,  true,  true> (); break;
+            case 0b1100: execute <true,  true,  false, false, true> (); break;
+            case 0b1101: execute <true,  true,  false, true,  true> (); break;
+            case 0b1110: execute <true,  true,  true,  false, true> (); break;
+            case 0b1111: execute <true,  true,  true,  true,  true> (); break;
+
+            default:
+                fatalError;
+        }
+
+        profile.total += util::rdtsc() - ticks;
+        profile.cycles += cpu.clock - cycle;
+        publishProfile();
+        return;
+    }
+
+    switch ((drive8.isPoweredOn()                   ? 8 : 0) |
+            (drive9.isPoweredOn()                   ? 4 : 0) |
+            (expansionport.needsAccurateEmulation() ? 2 : 0) |
+            (debug                                  ? 1 : 0) ) {
+
+        case 0b0000: execute <false, false, false, false, false> (); break;
+        case 0b0001: execute <false, false, false, true,  false> (); break;
+        case 0b0010: execute <false, false, true,  false, false> (); break;
+        case 0b0011: execute <false, false, true,  true,  false> (); break;
+        case 0b0100: execute <false, true,  false, false, false> (); break;
+        case 0b0101: execute <false, true,  false, true,  false> (); break;
+        case 0b0110: execute <false, true,  true,  false, false> (); break;
+        case 0b0111: execute <false, true,  true,  true,  false> (); break;
+        case 0b1000: execute <true,  false, false, false, false> (); break;
+        case 0b1001: execute <true,  false, false, true,  false> (); break;
+        case 0b1010: execute <true,  false, true,  false, false> (); break;
+        case 0b1011: execute <true,  false, true,  true,  false> (); break;
+        case 0b1100: execute <true,  true,  false, false, false> (); break;
+        case 0b1101: execute <true,  true,  false, true,  false> (); break;
+        case 0b1110: execute <true,  true,  true,  false, false> (); break;
+        case 0b1111: execute <true,  true,  true,  true,  false> (); break;
 
         default:
             fatalError;
     }
 }
 
-template <bool enable8, bool enable9, bool execExp> void
+template <bool enable8, bool enable9, bool execExp, bool debug, bool prof> void
 C64::execute()
 {
     auto lastCycle = vic.getCyclesPerLine();
@@ -785,14 +857,25 @@ C64::execute()
             for (; rasterCycle <= lastCycle; rasterCycle++) {
 
                 // Execute one cycle
-                executeCycle<enable8, enable9, execExp>();
+                if constexpr (prof) {
+
+                    if ((cpu.clock + 1) & (profilerInterval - 1)) {
+                        executeCycle<enable8, enable9, execExp, debug>();
+                    } else {
+                        profileCycle<enable8, enable9, execExp, debug>();
+                    }
+
+                } else {
+
+                    executeCycle<enable8, enable9, execExp, debug>();
+                }
 
                 // Process all pending flags
                 if (flags) processFlags();
             }
 
             // Finish the scanline
-            endScanline();
+            if constexpr (prof) { profileEndScanline(); } else { endScanline(); }
 
         } while (scanline != 0);
 
@@ -806,7 +889,7 @@ C64::execute()
     }
 }
 
-template <bool enable8, bool enable9, bool execExp>
+template <bool enable8, bool enable9, bool execExp, bool debug>
 alwaysinline void C64::executeCycle()
 {
     //
@@ -843,10 +926,98 @@ alwaysinline void C64::executeCycle()
     // Second clock phase (o2 high)
     //
 
-    cpu.execute<MOS_6510>();
+    cpu.execute<MOS_6510, PEDDLE_THREADED_DISPATCH, debug>();
+    if constexpr (enable8) { if (drive8.needsEmulation) drive8.execute(durationOfOneCycle); }
+    if constexpr (enable9) { if (drive9.needsEmulation) drive9.execute(durationOfOneCycle); }
+    if constexpr (execExp) { expansionport.execute(); }
+}
+
+template <bool enable8, bool enable9, bool execExp, bool debug> void
+C64::profileCycle()
+{
+    // Same as executeCycle(), but with time stamps taken after each phase
+    u64 t[7];
+
+    Cycle cycle = ++cpu.clock;
+
+    t[0] = util::rdtsc();
+    if (nextTrigger <= cycle) processEvents(cycle);
+    t[1] = util::rdtsc();
+    (vic.*vic.vicfunc[rasterCycle])();
+    t[2] = util::rdtsc();
+    cpu.execute<MOS_6510, PEDDLE_THREADED_DISPATCH, debug>();
+    t[3] = util::rdtsc();
     if constexpr (enable8) { if (drive8.needsEmulation) drive8.execute(durationOfOneCycle); }
+    t[4] = util::rdtsc();
     if constexpr (enable9) { if (drive9.needsEmulation) drive9.execute(durationOfOneCycle); }
+    t[5] = util::rdtsc();
     if constexpr (execExp) { expansionport.execute(); }
+    t[6] = util::rdtsc();
+
+    // Extrapolate the measured values to the whole sampling interval
+    auto delta = [&](isize i) {
+        auto ticks = t[i + 1] - t[i];
+        return (ticks > profile.overhead ? ticks - profile.overhead : 0) * profilerInterval;
+    };
+    profile.ticks[PROF_EVENTS] += delta(0);
+    profile.ticks[PROF_VICII] += delta(1);
+    profile.ticks[PROF_CPU] += delta(2);
+    profile.ticks[PROF_DRIVE8] += delta(3);
+    profile.ticks[PROF_DRIVE9] += delta(4);
+    profile.ticks[PROF_EXPANSION] += delta(5);
+}
+
+void
+C64::profileEndScanline()
+{
+    auto ticks = util::rdtsc();
+    endScanline();
+
+    // The scanline counter wraps around if the end of the frame was reached
+    profile.ticks[scanline ? PROF_SCANLINE : PROF_FRAME] += util::rdtsc() - ticks;
+}
+
+void
+C64::setProfiling(bool value)
+{
+    {   SUSPENDED
+
+        profiling = value;
+
+        // Reset all counters
+        profile = { };
+        profile.startTime = util::Time::now();
+        profile.startTicks = util::rdtsc();
+
+        // Determine the cost of a time stamp (subtracted from all samples)
+        profile.overhead = UINT64_MAX;
+        for (isize i = 0; i < 64; i++) {
+
+            auto t1 = util::rdtsc();
+            auto t2 = util::rdtsc();
+            profile.overhead = std::min(profile.overhead, t2 - t1);
+        }
+
+        publishProfile();
+    }
+}
+
+bool
+C64::getProfile(Profile &result) const
+{
+    SYNCHRONIZED
+
+    result = publishedProfile;
+    return publishedProfiling;
+}
+
+void
+C64::publishProfile()
+{
+    SYNCHRONIZED
+
+    publishedProfile = profile;
+    publishedProfiling = profiling;
 }
 
 void
@@ -1073,6 +1244,7 @@ C64::endScanline()
     cia1.tod.increment();
     cia2.tod.increment();
 
+    sidBridge.endScanline();
     vic.endScanline();
     rasterCycle = 1;
     scanline++;
@@ -1159,50 +1331,45 @@ C64::processEvents(Cycle cycle)
             //
             // Check tertiary slots
             //
-            if (isDue<SLOT_EXP>(cycle)) {
-                expansionport.processEvent(eventid[SLOT_EXP]);
-            }
-            if (isDue<SLOT_TXD>(cycle)) {
-                userPort.rs232.processTxdEvent();
-            }
-            if (isDue<SLOT_RXD>(cycle)) {
-                userPort.rs232.processRxdEvent();
-            }
-            if (isDue<SLOT_MOT>(cycle)) {
-                datasette.processMotEvent(eventid[SLOT_MOT]);
-            }
-            if (isDue<SLOT_DC8>(cycle)) {
-                drive8.processDiskChangeEvent(eventid[SLOT_DC8]);
-            }
-            if (isDue<SLOT_DC9>(cycle)) {
-                drive9.processDiskChangeEvent(eventid[SLOT_DC9]);
-            }
-            if (isDue<SLOT_SNP>(cycle)) {
-                processSNPEvent(eventid[SLOT_SNP]);
-            }
-            if (isDue<SLOT_RSH>(cycle)) {
-                retroShell.serviceEvent();
-            }
-            if (isDue<SLOT_KEY>(cycle)) {
-                keyboard.processKeyEvent(eventid[SLOT_KEY]);
-            }
-            if (isDue<SLOT_SRV>(cycle)) {
-                remoteManager.serviceServerEvent();
-            }
-            if (isDue<SLOT_DBG>(cycle)) {
-                regressionTester.processEvent(eventid[SLOT_DBG]);
-            }
-            if (isDue<SLOT_ALA>(cycle)) {
-                processAlarmEvent();
-            }
-            if (isDue<SLOT_INS>(cycle)) {
-                processINSEvent();
+
+            /* Only slots with a pending event are visited. The mask is reread
+             * after each slot to catch events scheduled by an event handler.
+             */
+            for (u32 mask = pending; mask; ) {
+
+                auto slot = std::countr_zero(mask);
+
+                if (cycle >= trigger[slot]) {
+
+                    switch (slot) {
+
+                        case SLOT_EXP: expansionport.processEvent(eventid[SLOT_EXP]); break;
+                        case SLOT_TXD: userPort.rs232.processTxdEvent(); break;
+                        case SLOT_RXD: userPort.rs232.processRxdEvent(); break;
+                        case SLOT_MOT: datasette.processMotEvent(eventid[SLOT_MOT]); break;
+                        case SLOT_DC8: drive8.processDiskChangeEvent(eventid[SLOT_DC8]); break;
+                        case SLOT_DC9: drive9.processDiskChangeEvent(eventid[SLOT_DC9]); break;
+                        case SLOT_SNP: processSNPEvent(eventid[SLOT_SNP]); break;
+                        case SLOT_RSH: retroShell.serviceEvent(); break;
+                        case SLOT_KEY: keyboard.processKeyEvent(eventid[SLOT_KEY]); break;
+                        case SLOT_SRV: remoteManager.serviceServerEvent(); break;
+                        case SLOT_DBG: regressionTester.processEvent(eventid[SLOT_DBG]); break;
+                        case SLOT_ALA: processAlarmEvent(); break;
+                        case SLOT_INS: processINSEvent(); break;
+
+                        default:
+                            fatalError;
+                    }
+                }
+                mask = pending & ~((2u << slot) - 1);
             }
 
             // Determine the next trigger cycle for all tertiary slots
-            Cycle next = trigger[SLOT_TER + 1];
-            for (isize i = SLOT_TER + 2; i < SLOT_COUNT; i++) {
-                if (trigger[i] < next) next = trigger[i];
+            Cycle next = NEVER;
+            for (u32 mask = pending; mask; mask &= mask - 1) {
+
+                auto slot = std::countr_zero(mask);
+                if (trigger[slot] < next) next = trigger[slot];
             }
             rescheduleAbs<SLOT_TER>(next);
         }
@@ -1223,6 +1390,16 @@ C64::processEvents(Cycle cycle)
     nextTrigger = next;
 }
 
+void
+C64::updatePendingMask()
+{
+    pending = 0;
+
+    for (isize i = SLOT_TER + 1; i < SLOT_COUNT; i++) {
+        if (trigger[i] != NEVER) pending |= 1 << i;
+    }
+}
+
 void
 C64::processINSEvent()
 {
@@ -89,6 +89,7 @@ static constexpr double inspectionInterval = 0.1;
 class C64 final : public CoreComponent, public Inspectable<C64Info> {
 
     friend class Emulator;
+    friend class Benchmark;
 
     Descriptions descriptions = {
         {
@@ -112,6 +113,7 @@ class C64 final : public CoreComponent, public Inspectable<C64Info> {
         OPT_C64_SPEED_BOOST,
         OPT_C64_VSYNC,
         OPT_C64_RUN_AHEAD,
+        OPT_C64_RENDER_INTERVAL,
         OPT_C64_SNAP_AUTO,
         OPT_C64_SNAP_DELAY,
         OPT_C64_SNAP_COMPRESS
@@ -189,6 +191,51 @@ public:
     // Next trigger cycle
     Cycle nextTrigger = NEVER;
 
+    // Bit mask of all tertiary slots with a pending event
+    u32 pending = 0;
+    static_assert(SLOT_COUNT <= 32);
+
+
+    //
+    // Execution profiler
+    //
+
+private:
+
+    // Sampling interval of the profiler in cycles (must be a power of two)
+    static constexpr Cycle profilerInterval = 32;
+
+    // Indicates if the profiler is enabled
+    bool profiling = false;
+
+    // Collected profiling data
+    struct Profile {
+
+        // Estimated number of time stamp counter ticks spent in each slot
+        u64 ticks[PROF_COUNT];
+
+        // Number of time stamp counter ticks spent in all profiled frames
+        u64 total;
+
+        // Number of profiled cycles
+        i64 cycles;
+
+        // Measured cost of reading the time stamp counter
+        u64 overhead;
+
+        // Reference values for converting ticks into nanoseconds
+        util::Time startTime;
+        u64 startTicks;
+
+    } profile = { };
+
+    /* Copy of the profiling data for other threads. The emulator thread
+     * publishes it at the end of each profiled frame. Both sides access it
+     * while holding the component lock.
+     */
+    Profile publishedProfile = { };
+    bool publishedProfiling = false;
+
 
     //
     // Emulator thread
@@ -240,11 +287,18 @@ private:
     bool ultimax = false;
 
     /* Indicates if headless mode is activated. If yes, the pixel drawing code
-     * is skipped. Headless mode is used to accelerate warp mode and to speed
-     * up the computation of some frames in run-ahead mode.
+     * is skipped for all scanlines without sprite activity. Headless mode is
+     * used to accelerate warp mode, to skip frames, and to speed up the
+     * computation of some frames in run-ahead mode.
      */
     bool headless = false;
 
+    /* Indicates if the next frame has to be rendered. The flag is set by the
+     * GUI or the frontend of a headless application to request a frame when
+     * frames are skipped. It is cleared when a rendered frame begins.
+     */
+    std::atomic<bool> frameRequested = false;
+
     /* Indicates whether the state has been altered by an external event.
      * This flag is used to determine whether the run-ahead instance needs to
      * be recreated.
@@ -329,6 +383,7 @@ public:
         CLONE_ARRAY(eventid)
         CLONE_ARRAY(data)
         CLONE(nextTrigger)
+        CLONE(pending)
         CLONE(frame)
         CLONE(scanline)
         CLONE(rasterCycle)
@@ -400,6 +455,7 @@ private:
     void _dump(Category category, std::ostream& os) const override;
 
     void _didReset(bool hard) override;
+    void _didLoad() override;
     void _isReady() const throws override;
     void _powerOn() override;
     void _powerOff() override;
@@ -491,6 +547,23 @@ public:
     bool getHeadless() const { return headless; }
     void setHeadless(bool value) { headless = value; }
 
+    // Requests the next frame to be rendered
+    void requestFrame() { frameRequested = true; }
+
+    // Execution profiler
+    bool isProfiling() const { return profiling; }
+    void setProfiling(bool value);
+
+    // Returns the published profiling data (thread-safe)
+    bool getProfile(Profile &result) const;
+
+private:
+
+    // Makes the profiling data visible to other threads
+    void publishProfile();
+
+public:
+
     // Returns the native refresh rate (differs between PAL and NTSC)
     double nativeRefreshRate() const;
 
@@ -518,12 +591,17 @@ private:
     // Called by the Emulator class in it's own update function
     void update(CmdQueue &queue);
 
+    // Checks if the next frame can be computed without drawing pixels
+    bool canSkipFrame() const;
+
     // Emulates a frame
     void computeFrame();
     void computeFrame(bool headless);
     void computeFrameHeadless() { computeFrame(true); }
-    template <bool, bool, bool> void execute();
-    template <bool, bool, bool> alwaysinline void executeCycle();
+    template <bool, bool, bool, bool, bool> void execute();
+    template <bool, bool, bool, bool> alwaysinline void executeCycle();
+    template <bool, bool, bool, bool> void profileCycle();
+    void profileEndScanline();
     void processFlags();
 
     // Fast-forward the run-ahead instance
@@ -594,6 +672,7 @@ public:
 
         if constexpr (isTertiarySlot(s)) {
             if (cycle < trigger[SLOT_TER]) trigger[SLOT_TER] = cycle;
+            pending |= 1 << s;
         }
         if constexpr (isSecondarySlot(s) || isTertiarySlot(s)) {
             if (cycle < trigger[SLOT_SEC]) trigger[SLOT_SEC] = cycle;
@@ -613,6 +692,7 @@ public:
 
         if constexpr (isTertiarySlot(s)) {
             if (cycle < trigger[SLOT_TER]) trigger[SLOT_TER] = cycle;
+            pending |= 1 << s;
         }
         if constexpr (isSecondarySlot(s) || isTertiarySlot(s)) {
             if (cycle < trigger[SLOT_SEC]) trigger[SLOT_SEC] = cycle;
@@ -663,10 +743,15 @@ public:
         eventid[s] = (EventID)0;
         data[s] = 0;
         trigger[s] = NEVER;
+
+        if constexpr (isTertiarySlot(s)) pending &= ~(1 << s);
     }
 
 private:
 
+    // Recomputes the pending mask from the trigger cycles
+    void updatePendingMask();
+
     // Services an inspection event
     void processINSEvent();
 
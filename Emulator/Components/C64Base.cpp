@@ -189,6 +189,7 @@ C64::getOption(Option opt) const
         case OPT_C64_SPEED_BOOST:       return config.speedBoost;
         case OPT_C64_VSYNC:             return config.vsync;
         case OPT_C64_RUN_AHEAD:         return config.runAhead;
+        case OPT_C64_RENDER_INTERVAL:   return config.renderInterval;
         case OPT_C64_SNAP_AUTO:         return config.snapshots;
         case OPT_C64_SNAP_DELAY:        return config.snapshotDelay;
         case OPT_C64_SNAP_COMPRESS:     return config.compressSnapshots;
@@ -232,6 +233,13 @@ C64::checkOption(Option opt, i64 value)
             }
             return;
 
+        case OPT_C64_RENDER_INTERVAL:
+
+            if (value < 0 || value > 100) {
+                throw Error(VC64ERROR_OPT_INV_ARG, "0...100");
+            }
+            return;
+
         case OPT_C64_SNAP_AUTO:
 
             return;
@@ -285,6 +293,11 @@ C64::setOption(Option opt, i64 value)
             config.runAhead = isize(value);
             return;
 
+        case OPT_C64_RENDER_INTERVAL:
+
+            config.renderInterval = isize(value);
+            return;
+
         case OPT_C64_SNAP_AUTO:
 
             config.snapshots = bool(value);
@@ -247,6 +247,47 @@ enum_i8(EventID)
     INS_EVENT_COUNT
 };
 
+/// Execution profiler slot
+enum_long(PROFILER_SLOT)
+{
+    PROF_EVENTS,                    ///< Event processing
+    PROF_VICII,                     ///< VICII cycle functions
+    PROF_CPU,                       ///< CPU
+    PROF_DRIVE8,                    ///< Floppy drive 8
+    PROF_DRIVE9,                    ///< Floppy drive 9
+    PROF_EXPANSION,                 ///< Expansion port
+    PROF_SCANLINE,                  ///< End-of-line processing
+    PROF_FRAME,                     ///< End-of-frame processing
+
+    PROF_COUNT
+};
+typedef PROFILER_SLOT ProfilerSlot;
+
+struct ProfilerSlotEnum : util::Reflection<ProfilerSlotEnum, ProfilerSlot>
+{
+    static constexpr long minVal = 0;
+    static constexpr long maxVal = PROF_COUNT - 1;
+
+    static const char *prefix() { return "PROF"; }
+    static const char *_key(long value)
+    {
+        switch (value) {
+
+            case PROF_EVENTS:       return "EVENTS";
+            case PROF_VICII:        return "VICII";
+            case PROF_CPU:          return "CPU";
+            case PROF_DRIVE8:       return "DRIVE8";
+            case PROF_DRIVE9:       return "DRIVE9";
+            case PROF_EXPANSION:    return "EXPANSION";
+            case PROF_SCANLINE:     return "SCANLINE";
+            case PROF_FRAME:        return "FRAME";
+
+            case PROF_COUNT:        return "???";
+        }
+        return "???";
+    }
+};
+
 
 //
 // Structures
@@ -269,6 +310,9 @@ typedef struct
     //! Number of run-ahead frames (0 = run-ahead is disabled)
     isize runAhead;
 
+    //! Render one out of this many frames (0 = only render requested frames)
+    isize renderInterval;
+
     //! Enable auto-snapshots
     bool snapshots;
 
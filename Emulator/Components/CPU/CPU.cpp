@@ -144,6 +144,12 @@ CPU::jumpedTo(u16 addr) const
     msgQueue.put(MSG_CPU_JUMPED, CpuMsg { .pc = addr } );
 }
 
+i64
+CPU::frameCount() const
+{
+    return i64(c64.frame);
+}
+
 void
 CPU::jump(u16 addr)
 {
@@ -251,6 +257,24 @@ CPU::toggleBreakpoint(isize nr)
     debugger.breakpoints.isEnabled(nr) ? disableBreakpoint(nr) : enableBreakpoint(nr);
 }
 
+void
+CPU::setBreakpointCondition(isize nr, const string &cond)
+{
+    if (!debugger.breakpoints.guardNr(nr)) throw Error(VC64ERROR_BP_NOT_FOUND, nr);
+    if (!debugger.breakpoints.setCondition(nr, cond)) throw Error(VC64ERROR_GUARD_SYNTAX, cond);
+
+    msgQueue.put(MSG_BREAKPOINT_UPDATED);
+}
+
+void
+CPU::deleteBreakpointCondition(isize nr)
+{
+    if (!debugger.breakpoints.guardNr(nr)) throw Error(VC64ERROR_BP_NOT_FOUND, nr);
+
+    debugger.breakpoints.removeCondition(nr);
+    msgQueue.put(MSG_BREAKPOINT_UPDATED);
+}
+
 void 
 CPU::setEnableBreakpoint(isize nr, bool value)
 {
@@ -325,6 +349,24 @@ CPU::toggleWatchpoint(isize nr)
     debugger.watchpoints.isEnabled(nr) ? disableWatchpoint(nr) : enableWatchpoint(nr);
 }
 
+void
+CPU::setWatchpointCondition(isize nr, const string &cond)
+{
+    if (!debugger.watchpoints.guardNr(nr)) throw Error(VC64ERROR_WP_NOT_FOUND, nr);
+    if (!debugger.watchpoints.setCondition(nr, cond)) throw Error(VC64ERROR_GUARD_SYNTAX, cond);
+
+    msgQueue.put(MSG_WATCHPOINT_UPDATED);
+}
+
+void
+CPU::deleteWatchpointCondition(isize nr)
+{
+    if (!debugger.watchpoints.guardNr(nr)) throw Error(VC64ERROR_WP_NOT_FOUND, nr);
+
+    debugger.watchpoints.removeCondition(nr);
+    msgQueue.put(MSG_WATCHPOINT_UPDATED);
+}
+
 void
 CPU::setEnableWatchpoint(isize nr, bool value)
 {
@@ -408,12 +450,12 @@ CPU::readResetVector()
 namespace vc64::peddle {
 
 #define CHECK_WATCHPOINT \
-if constexpr (PEDDLE_ENABLE_WATCHPOINTS) { \
+if constexpr (D && PEDDLE_ENABLE_WATCHPOINTS) { \
 if ((flags & CPU_CHECK_WP) && debugger.watchpointMatches(addr)) { \
 watchpointReached(addr); \
 }}
 
-template <CPURevision C> u8
+template <CPURevision C, bool D> u8
 Peddle::read(u16 addr)
 {
     CHECK_WATCHPOINT
@@ -427,9 +469,10 @@ Peddle::read(u16 addr)
 template u8 Peddle::read<MOS_6502>(u16 addr);
 template u8 Peddle::read<MOS_6507>(u16 addr);
 template u8 Peddle::read<MOS_6510>(u16 addr);
+template u8 Peddle::read<MOS_6510, false>(u16 addr);
 template u8 Peddle::read<MOS_8502>(u16 addr);
 
-template <CPURevision C> u8
+template <CPURevision C, bool D> u8
 Peddle::readZeroPage(u8 addr)
 {
     CHECK_WATCHPOINT
@@ -446,9 +489,10 @@ Peddle::readZeroPage(u8 addr)
 template u8 Peddle::readZeroPage<MOS_6502>(u8 addr);
 template u8 Peddle::readZeroPage<MOS_6507>(u8 addr);
 template u8 Peddle::readZeroPage<MOS_6510>(u8 addr);
+template u8 Peddle::readZeroPage<MOS_6510, false>(u8 addr);
 template u8 Peddle::readZeroPage<MOS_8502>(u8 addr);
 
-template <CPURevision C> u8
+template <CPURevision C, bool D> u8
 Peddle::readStack(u8 addr)
 {
     CHECK_WATCHPOINT
@@ -465,9 +509,10 @@ Peddle::readStack(u8 addr)
 template u8 Peddle::readStack<MOS_6502>(u8 addr);
 template u8 Peddle::readStack<MOS_6507>(u8 addr);
 template u8 Peddle::readStack<MOS_6510>(u8 addr);
+template u8 Peddle::readStack<MOS_6510, false>(u8 addr);
 template u8 Peddle::readStack<MOS_8502>(u8 addr);
 
-template <CPURevision C> void
+template <CPURevision C, bool D> void
 Peddle::readIdle(u16 addr)
 {
     if (PEDDLE_EMULATE_IDLE_ACCESSES) {
@@ -487,9 +532,10 @@ Peddle::readIdle(u16 addr)
 template void Peddle::readIdle<MOS_6502>(u16 addr);
 template void Peddle::readIdle<MOS_6507>(u16 addr);
 template void Peddle::readIdle<MOS_6510>(u16 addr);
+template void Peddle::readIdle<MOS_6510, false>(u16 addr);
 template void Peddle::readIdle<MOS_8502>(u16 addr);
 
-template <CPURevision C> void
+template <CPURevision C, bool D> void
 Peddle::readZeroPageIdle(u8 addr)
 {
     if (PEDDLE_EMULATE_IDLE_ACCESSES) {
@@ -509,9 +555,10 @@ Peddle::readZeroPageIdle(u8 addr)
 template void Peddle::readZeroPageIdle<MOS_6502>(u8 addr);
 template void Peddle::readZeroPageIdle<MOS_6507>(u8 addr);
 template void Peddle::readZeroPageIdle<MOS_6510>(u8 addr);
+template void Peddle::readZeroPageIdle<MOS_6510, false>(u8 addr);
 template void Peddle::readZeroPageIdle<MOS_8502>(u8 addr);
 
-template <CPURevision C> void
+template <CPURevision C, bool D> void
 Peddle::readStackIdle(u8 addr)
 {
     if (PEDDLE_EMULATE_IDLE_ACCESSES) {
@@ -531,10 +578,11 @@ Peddle::readStackIdle(u8 addr)
 template void Peddle::readStackIdle<MOS_6502>(u8 addr);
 template void Peddle::readStackIdle<MOS_6507>(u8 addr);
 template void Peddle::readStackIdle<MOS_6510>(u8 addr);
+template void Peddle::readStackIdle<MOS_6510, false>(u8 addr);
 template void Peddle::readStackIdle<MOS_8502>(u8 addr);
 
 
-template <CPURevision C> void
+template <CPURevision C, bool D> void
 Peddle::write(u16 addr, u8 val)
 {
     CHECK_WATCHPOINT
@@ -551,9 +599,10 @@ Peddle::write(u16 addr, u8 val)
 template void Peddle::write<MOS_6502>(u16 addr, u8 val);
 template void Peddle::write<MOS_6507>(u16 addr, u8 val);
 template void Peddle::write<MOS_6510>(u16 addr, u8 val);
+template void Peddle::write<MOS_6510, false>(u16 addr, u8 val);
 template void Peddle::write<MOS_8502>(u16 addr, u8 val);
 
-template <CPURevision C> void
+template <CPURevision C, bool D> void
 Peddle::writeZeroPage(u8 addr, u8 val)
 {
     CHECK_WATCHPOINT
@@ -570,9 +619,10 @@ Peddle::writeZeroPage(u8 addr, u8 val)
 template void Peddle::writeZeroPage<MOS_6502>(u8 addr, u8 val);
 template void Peddle::writeZeroPage<MOS_6507>(u8 addr, u8 val);
 template void Peddle::writeZeroPage<MOS_6510>(u8 addr, u8 val);
+template void Peddle::writeZeroPage<MOS_6510, false>(u8 addr, u8 val);
 template void Peddle::writeZeroPage<MOS_8502>(u8 addr, u8 val);
 
-template <CPURevision C> void
+template <CPURevision C, bool D> void
 Peddle::writeStack(u8 addr, u8 val)
 {
     CHECK_WATCHPOINT
@@ -589,6 +639,7 @@ Peddle::writeStack(u8 addr, u8 val)
 template void Peddle::writeStack<MOS_6502>(u8 addr, u8 val);
 template void Peddle::writeStack<MOS_6507>(u8 addr, u8 val);
 template void Peddle::writeStack<MOS_6510>(u8 addr, u8 val);
+template void Peddle::writeStack<MOS_6510, false>(u8 addr, u8 val);
 template void Peddle::writeStack<MOS_8502>(u8 addr, u8 val);
 
 template <CPURevision C> u16
@@ -221,6 +221,7 @@ public:
     virtual void watchpointReached(u16 addr) const override;
     virtual void instructionLogged() const override;
     virtual void jumpedTo(u16 addr) const override;
+    virtual i64 frameCount() const override;
 
 
     //
@@ -275,6 +276,9 @@ public:
 
     void toggleBreakpoint(isize nr) throws;
 
+    void setBreakpointCondition(isize nr, const string &cond) throws;
+    void deleteBreakpointCondition(isize nr) throws;
+
 private:
 
     void setEnableBreakpoint(isize nr, bool value) throws;
@@ -305,6 +309,9 @@ public:
 
     void toggleWatchpoint(isize nr) throws;
 
+    void setWatchpointCondition(isize nr, const string &cond) throws;
+    void deleteWatchpointCondition(isize nr) throws;
+
 private:
 
     void setEnableWatchpoint(isize nr, bool value) throws;
@@ -32,6 +32,7 @@ CPU::_dump(Category category, std::ostream& os) const
 
             if (!guard->enabled) os << " (Disabled)";
             else if (guard->ignore) os << " (Disabled for " << util::dec(guard->ignore) << " hits)";
+            if (!guard->cond.empty()) os << " if " << guard->cond.str();
             os << std::endl;
         }
     };
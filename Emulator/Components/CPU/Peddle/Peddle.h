@@ -25,6 +25,7 @@ class Peddle : public SubComponent {
     friend class Disassembler;
     friend class Breakpoints;
     friend class Watchpoints;
+    friend class Condition;
 
     //
     // Static lookup tables
@@ -255,9 +256,12 @@ public:
     void reset();
     template <CPURevision C> void reset();
 
-    // Exexutes the CPU for a single cycle
+    /* Exexutes the CPU for a single cycle. T selects the dispatch engine and D
+     * enables the debug checks (breakpoints, watchpoints, instruction logging).
+     * D may only be false if no debug flag is set.
+     */
     void execute();
-    template <CPURevision C> void execute();
+    template <CPURevision C, bool T = PEDDLE_THREADED_DISPATCH, bool D = true> void execute();
 
     // Executes the CPU for the specified number of cycles
     void execute(int count);
@@ -278,7 +282,7 @@ public:
 protected:
 
     // Called after the last microcycle has been completed
-    template <CPURevision C> void done();
+    template <CPURevision C, bool D = true> void done();
 
 
     //
@@ -357,17 +361,17 @@ private:
 
 private:
 
-    template <CPURevision C> u8 read(u16 addr);
-    template <CPURevision C> u8 readZeroPage(u8 addr);
-    template <CPURevision C> u8 readStack(u8 sp);
+    template <CPURevision C, bool D = true> u8 read(u16 addr);
+    template <CPURevision C, bool D = true> u8 readZeroPage(u8 addr);
+    template <CPURevision C, bool D = true> u8 readStack(u8 sp);
 
-    template <CPURevision C> void readIdle(u16 addr);
-    template <CPURevision C> void readZeroPageIdle(u8 addr);
-    template <CPURevision C> void readStackIdle(u8 sp);
+    template <CPURevision C, bool D = true> void readIdle(u16 addr);
+    template <CPURevision C, bool D = true> void readZeroPageIdle(u8 addr);
+    template <CPURevision C, bool D = true> void readStackIdle(u8 sp);
 
-    template <CPURevision C> void write(u16 addr, u8 value);
-    template <CPURevision C> void writeZeroPage(u8 addr, u8 value);
-    template <CPURevision C> void writeStack(u8 sp, u8 value);
+    template <CPURevision C, bool D = true> void write(u16 addr, u8 value);
+    template <CPURevision C, bool D = true> void writeZeroPage(u8 addr, u8 value);
+    template <CPURevision C, bool D = true> void writeStack(u8 sp, u8 value);
 
     template <CPURevision C> u16 readDasm(u16 addr) const;
 
@@ -430,6 +434,9 @@ protected:
     virtual void instructionLogged() const { }
     virtual void jumpedTo(u16 addr) const { }
 
+    // Data provider for the 'frame' operand in guard conditions
+    virtual i64 frameCount() const { return 0; }
+
 
     //
     // Operating the Arithmetical Logical Unit (ALU)
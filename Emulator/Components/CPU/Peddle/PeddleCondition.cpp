@@ -0,0 +1,288 @@
+// -----------------------------------------------------------------------------
+// This file is part of Peddle - A MOS 65xx CPU emulator
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Published under the terms of the MIT License
+// -----------------------------------------------------------------------------
+
+#include "PeddleConfig.h"
+#include "Peddle.h"
+#include <cctype>
+
+namespace vc64::peddle {
+
+// Recursive descent parser translating an expression into stack machine code
+class ConditionParser {
+
+    using Op = Condition::Op;
+
+    const string &src;
+    usize pos = 0;
+
+    std::vector<Condition::Instr> &code;
+    isize depth = 0;
+    isize maxDepth = 0;
+
+public:
+
+    ConditionParser(const string &s, std::vector<Condition::Instr> &c) : src(s), code(c) { }
+
+    bool parse() {
+
+        if (!parseOr()) return false;
+
+        skip();
+        return pos == src.size() && maxDepth <= Condition::stackSize;
+    }
+
+private:
+
+    void skip() {
+
+        while (pos < src.size() && isspace(src[pos])) pos++;
+    }
+
+    bool accept(const char *token) {
+
+        skip();
+        auto len = strlen(token);
+        if (src.compare(pos, len, token) != 0) return false;
+
+        // Don't mistake '<=' for '<' or '&&' for '&'
+        if (len == 1 && pos + 1 < src.size()) {
+
+            char c = src[pos], n = src[pos + 1];
+            if ((c == '<' || c == '>' || c == '!' || c == '=') && n == '=') return false;
+            if ((c == '&' || c == '|') && n == c) return false;
+        }
+        pos += len;
+        return true;
+    }
+
+    void emit(Op op, i64 arg = 0) {
+
+        switch (op) {
+
+            case Op::Push: case Op::A: case Op::X: case Op::Y: case Op::SP:
+            case Op::P: case Op::PC: case Op::Cycle: case Op::Frame: case Op::Hits:
+
+                depth++;
+                break;
+
+            case Op::Peek: case Op::Neg: case Op::Not: case Op::Inv:
+
+                break;
+
+            default:
+
+                depth--;
+        }
+        if (depth > maxDepth) maxDepth = depth;
+        code.push_back({ op, arg });
+    }
+
+    bool parseOr() {
+
+        if (!parseAnd()) return false;
+        while (accept("||")) { if (!parseAnd()) return false; emit(Op::LOr); }
+        return true;
+    }
+
+    bool parseAnd() {
+
+        if (!parseBitOr()) return false;
+        while (accept("&&")) { if (!parseBitOr()) return false; emit(Op::LAnd); }
+        return true;
+    }
+
+    bool parseBitOr() {
+
+        if (!parseBitXor()) return false;
+        while (accept("|")) { if (!parseBitXor()) return false; emit(Op::Or); }
+        return true;
+    }
+
+    bool parseBitXor() {
+
+        if (!parseBitAnd()) return false;
+        while (accept("^")) { if (!parseBitAnd()) return false; emit(Op::Xor); }
+        return true;
+    }
+
+    bool parseBitAnd() {
+
+        if (!parseEquality()) return false;
+        while (accept("&")) { if (!parseEquality()) return false; emit(Op::And); }
+        return true;
+    }
+
+    bool parseEquality() {
+
+        if (!parseRelation()) return false;
+        while (true) {
+
+            Op op;
+            if (accept("==")) op = Op::Eq;
+            else if (accept("!=")) op = Op::Ne;
+            else return true;
+
+            if (!parseRelation()) return false;
+            emit(op);
+        }
+    }
+
+    bool parseRelation() {
+
+        if (!parseSum()) return false;
+        while (true) {
+
+            Op op;
+            if (accept("<=")) op = Op::Le;
+            else if (accept(">=")) op = Op::Ge;
+            else if (accept("<")) op = Op::Lt;
+            else if (accept(">")) op = Op::Gt;
+            else return true;
+
+            if (!parseSum()) return false;
+            emit(op);
+        }
+    }
+
+    bool parseSum() {
+
+        if (!parseUnary()) return false;
+        while (true) {
+
+            Op op;
+            if (accept("+")) op = Op::Add;
+            else if (accept("-")) op = Op::Sub;
+            else return true;
+
+            if (!parseUnary()) return false;
+            emit(op);
+        }
+    }
+
+    bool parseUnary() {
+
+        if (accept("!")) { if (!parseUnary()) return false; emit(Op::Not); return true; }
+        if (accept("~")) { if (!parseUnary()) return false; emit(Op::Inv); return true; }
+        if (accept("-")) { if (!parseUnary()) return false; emit(Op::Neg); return true; }
+        return parsePrimary();
+    }
+
+    bool parsePrimary() {
+
+        if (accept("(")) return parseOr() && accept(")");
+        if (accept("[")) { if (!parseOr() || !accept("]")) return false; emit(Op::Peek); return true; }
+
+        skip();
+        if (pos >= src.size()) return false;
+
+        if (isalpha(src[pos])) {
+
+            string id;
+            while (pos < src.size() && isalnum(src[pos])) id += char(tolower(src[pos++]));
+
+            if (id == "a") emit(Op::A);
+            else if (id == "x") emit(Op::X);
+            else if (id == "y") emit(Op::Y);
+            else if (id == "sp") emit(Op::SP);
+            else if (id == "p") emit(Op::P);
+            else if (id == "pc") emit(Op::PC);
+            else if (id == "cycle") emit(Op::Cycle);
+            else if (id == "frame") emit(Op::Frame);
+            else if (id == "hits") emit(Op::Hits);
+            else return false;
+            return true;
+        }
+
+        return parseNumber();
+    }
+
+    bool parseNumber() {
+
+        int base = 10;
+
+        if (src[pos] == '$') { base = 16; pos++; }
+        else if (src[pos] == '%') { base = 2; pos++; }
+        else if (src.compare(pos, 2, "0x") == 0) { base = 16; pos += 2; }
+
+        i64 value = 0;
+        isize digits = 0;
+
+        for (; pos < src.size(); pos++, digits++) {
+
+            char c = char(tolower(src[pos]));
+            int digit =
+            isdigit(c) ? c - '0' : (c >= 'a' && c <= 'f') ? c - 'a' + 10 : base;
+
+            if (digit >= base) break;
+            value = value * base + digit;
+        }
+
+        if (digits == 0) return false;
+        emit(Op::Push, value);
+        return true;
+    }
+};
+
+bool
+Condition::compile(const string &expr)
+{
+    std::vector<Instr> program;
+
+    if (!ConditionParser(expr, program).parse()) return false;
+
+    code = program;
+    source = expr;
+    return true;
+}
+
+bool
+Condition::eval(const Peddle &cpu, long hits) const
+{
+    i64 stack[stackSize];
+    isize sp = -1;
+
+    for (auto &instr : code) {
+
+        switch (instr.op) {
+
+            case Op::Push:  stack[++sp] = instr.arg; break;
+            case Op::A:     stack[++sp] = cpu.reg.a; break;
+            case Op::X:     stack[++sp] = cpu.reg.x; break;
+            case Op::Y:     stack[++sp] = cpu.reg.y; break;
+            case Op::SP:    stack[++sp] = cpu.reg.sp; break;
+            case Op::P:     stack[++sp] = cpu.getP(); break;
+            case Op::PC:    stack[++sp] = cpu.reg.pc0; break;
+            case Op::Cycle: stack[++sp] = cpu.clock; break;
+            case Op::Frame: stack[++sp] = cpu.frameCount(); break;
+            case Op::Hits:  stack[++sp] = hits; break;
+
+            case Op::Peek:  stack[sp] = cpu.readDasm(u16(stack[sp])); break;
+            case Op::Neg:   stack[sp] = -stack[sp]; break;
+            case Op::Not:   stack[sp] = !stack[sp]; break;
+            case Op::Inv:   stack[sp] = ~stack[sp]; break;
+
+            case Op::Add:   sp--; stack[sp] = stack[sp] + stack[sp + 1]; break;
+            case Op::Sub:   sp--; stack[sp] = stack[sp] - stack[sp + 1]; break;
+            case Op::And:   sp--; stack[sp] = stack[sp] & stack[sp + 1]; break;
+            case Op::Xor:   sp--; stack[sp] = stack[sp] ^ stack[sp + 1]; break;
+            case Op::Or:    sp--; stack[sp] = stack[sp] | stack[sp + 1]; break;
+            case Op::Eq:    sp--; stack[sp] = stack[sp] == stack[sp + 1]; break;
+            case Op::Ne:    sp--; stack[sp] = stack[sp] != stack[sp + 1]; break;
+            case Op::Lt:    sp--; stack[sp] = stack[sp] < stack[sp + 1]; break;
+            case Op::Le:    sp--; stack[sp] = stack[sp] <= stack[sp + 1]; break;
+            case Op::Gt:    sp--; stack[sp] = stack[sp] > stack[sp + 1]; break;
+            case Op::Ge:    sp--; stack[sp] = stack[sp] >= stack[sp + 1]; break;
+            case Op::LAnd:  sp--; stack[sp] = stack[sp] && stack[sp + 1]; break;
+            case Op::LOr:   sp--; stack[sp] = stack[sp] || stack[sp + 1]; break;
+        }
+    }
+
+    assert(sp == 0);
+    return stack[0] != 0;
+}
+
+}
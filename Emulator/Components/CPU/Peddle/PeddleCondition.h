@@ -0,0 +1,85 @@
+// -----------------------------------------------------------------------------
+// This file is part of Peddle - A MOS 65xx CPU emulator
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Published under the terms of the MIT License
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#include "BasicTypes.h"
+#include <vector>
+
+namespace vc64::peddle {
+
+/* Compiled guard condition
+ *
+ * A condition is a boolean expression which is attached to a breakpoint or
+ * watchpoint. It is translated once into a compact stack machine program
+ * and evaluated directly in the emulator thread whenever the guard hits.
+ * The guard only triggers if the condition evaluates to a non-zero value.
+ *
+ * Syntax (C-style operator precedence):
+ *
+ *     Operands:  Numbers ($hex, 0xhex, %binary, decimal)
+ *                a, x, y, sp, p, pc         (CPU registers)
+ *                cycle, frame, hits         (CPU clock, frame, hit counter)
+ *                [expr]                     (Memory contents at expr)
+ *
+ *     Operators: ! ~ - (unary), + -, &, ^, |,
+ *                == != < <= > >=, &&, ||, ( )
+ *
+ * Example: "a == $10 && [$d020] != 0 && cycle >= 100000"
+ */
+class Condition {
+
+    friend class ConditionParser;
+
+    enum class Op : u8 {
+
+        Push, A, X, Y, SP, P, PC, Cycle, Frame, Hits, Peek,
+        Neg, Not, Inv,
+        Add, Sub, And, Xor, Or,
+        Eq, Ne, Lt, Le, Gt, Ge, LAnd, LOr
+    };
+
+    struct Instr { Op op; i64 arg; };
+
+    // Maximum depth of the evaluation stack
+    static constexpr isize stackSize = 16;
+
+    // The compiled program
+    std::vector<Instr> code;
+
+    // The condition in textual form
+    string source;
+
+
+    //
+    // Compiling
+    //
+
+public:
+
+    // Translates an expression. Returns false if a syntax error is detected
+    bool compile(const string &expr);
+
+    // Removes the condition
+    void clear() { code.clear(); source.clear(); }
+
+
+    //
+    // Evaluating
+    //
+
+    // Indicates if a condition is present
+    bool empty() const { return code.empty(); }
+
+    // Returns the condition in textual form
+    const string &str() const { return source; }
+
+    // Evaluates the condition
+    bool eval(const class Peddle &cpu, long hits) const;
+};
+
+}
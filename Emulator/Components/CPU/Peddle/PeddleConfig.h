@@ -68,3 +68,24 @@
  * only be decided after the CPU has completed its current cycle.
  */
 #define PEDDLE_ASYNC_READS false
+
+/* Threaded dispatch
+ *
+ * Peddle executes a single microinstruction per call to execute(). By default,
+ * the handler is selected by a large switch statement on the next
+ * microinstruction. Alternatively, Peddle can jump to the handler directly via
+ * a table of label addresses, which omits the range check of the switch
+ * statement and gives each entry point its own jump target. The feature relies
+ * on computed gotos, a GCC and Clang extension. On other compilers, the switch
+ * statement is used regardless of this setting.
+ *
+ * The benefit depends on the host CPU and the compiler. Run 'vc64Bench -d' to
+ * compare both engines on a particular machine.
+ */
+#define PEDDLE_THREADED_DISPATCH false
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PEDDLE_COMPUTED_GOTO true
+#else
+#define PEDDLE_COMPUTED_GOTO false
+#endif
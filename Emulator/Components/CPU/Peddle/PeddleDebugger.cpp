@@ -19,11 +19,11 @@ namespace vc64::peddle {
 //
 
 bool
-Guard::eval(u32 addr)
+Guard::eval(u32 addr, const Peddle &cpu)
 {
     if (this->addr == addr && this->enabled) {
         if (++hits > ignore) {
-            return true;
+            return cond.empty() || cond.eval(cpu, hits);
         }
     }
     return false;
@@ -81,7 +81,9 @@ Guards::setAt(u32 addr, long skip)
     guards[count].enabled = true;
     guards[count].hits = 0;
     guards[count].ignore = skip;
+    guards[count].cond.clear();
     count++;
+    updateFilter();
     setNeedsCheck(true);
 }
 
@@ -103,6 +105,7 @@ Guards::removeAt(u32 addr)
             break;
         }
     }
+    updateFilter();
     setNeedsCheck(count != 0);
 }
 
@@ -111,6 +114,7 @@ Guards::moveTo(long nr, u32 newAddr)
 {
     if (nr >= count || isSetAt(newAddr)) return;
     guards[nr].moveTo(newAddr);
+    updateFilter();
 }
 
 bool
@@ -145,6 +149,7 @@ void
 Guards::setEnable(long nr, bool val)
 {
     if (nr < count) guards[nr].enabled = val;
+    updateFilter();
 }
 
 void
@@ -152,6 +157,7 @@ Guards::setEnableAt(u32 addr, bool val)
 {
     Guard *guard = guardAt(addr);
     if (guard) guard->enabled = val;
+    updateFilter();
 }
 
 void 
@@ -161,6 +167,7 @@ Guards::setEnableAll(bool val)
     for (isize i = 0; guard != nullptr; guard = guardNr(++i)) {
         guard->enabled = val;
     }
+    updateFilter();
 }
 
 void
@@ -170,15 +177,45 @@ Guards::ignore(long nr, long count)
     if (guard) guard->ignore = count;
 }
 
+bool
+Guards::setCondition(long nr, const string &expr)
+{
+    Guard *guard = guardNr(nr);
+    return guard && guard->cond.compile(expr);
+}
+
+void
+Guards::removeCondition(long nr)
+{
+    Guard *guard = guardNr(nr);
+    if (guard) guard->cond.clear();
+}
+
 bool
 Guards::eval(u32 addr)
 {
+    if (!mayHit(addr)) return false;
+
     for (int i = 0; i < count; i++)
-        if (guards[i].eval(addr)) return true;
+        if (guards[i].eval(addr, cpu)) return true;
 
     return false;
 }
 
+void
+Guards::updateFilter()
+{
+    for (isize i = 0; i < 1024; i++) filter[i] = 0;
+
+    for (long i = 0; i < count; i++) {
+
+        if (!guards[i].enabled) continue;
+
+        u32 addr = guards[i].addr;
+        filter[(addr >> 6) & 1023] |= u64(1) << (addr & 63);
+    }
+}
+
 void
 Breakpoints::setNeedsCheck(bool value)
 {
@@ -244,7 +281,7 @@ Debugger::breakpointMatches(u32 addr)
 }
 
 bool
-Debugger::watchpointMatches(u32 addr)
+Debugger::watchpointHits(u32 addr)
 {
     if (!watchpoints.eval(addr)) return false;
     
@@ -57,6 +57,14 @@ protected:
     // Number of currently stored guards
     long count = 0;
 
+    /* Address filter (one bit per 16-bit address)
+     * A bit is set if at least one enabled guard observes the address. It
+     * allows eval() to reject the vast majority of addresses with a single
+     * bit test, no matter how many guards are set. Hit and ignore counters
+     * are only touched if the bit test succeeds.
+     */
+    u64 filter[1024] = { };
+
     // Indicates if guard checking is necessary
     virtual void setNeedsCheck(bool value) = 0;
     
@@ -94,7 +102,7 @@ public:
 
     void remove(long nr);
     void removeAt(u32 addr);
-    void removeAll() { count = 0; setNeedsCheck(false); }
+    void removeAll() { count = 0; updateFilter(); setNeedsCheck(false); }
 
 
     //
@@ -121,14 +129,33 @@ public:
     void ignore(long nr, long count);
 
 
+    //
+    // Managing conditions
+    //
+
+    // Attaches a condition. Returns false if the expression is malformed
+    bool setCondition(long nr, const string &expr);
+    void removeCondition(long nr);
+
+
     //
     // Checking a guard
     //
-    
+
+public:
+
+    // Returns false if no enabled guard observes the provided address
+    bool mayHit(u32 addr) const {
+        return (filter[(addr >> 6) & 1023] >> (addr & 63)) & 1;
+    }
+
 private:
     
     // Returns true if the guard hits
     bool eval(u32 addr);
+
+    // Rebuilds the address filter from the guard list
+    void updateFilter();
 };
 
 class Breakpoints : public Guards {
@@ -213,7 +240,15 @@ public:
     bool breakpointMatches(u32 addr);
 
     // Returns true if a watchpoint hits at the provides address
-    bool watchpointMatches(u32 addr);
+    bool watchpointMatches(u32 addr) {
+        return watchpoints.mayHit(addr) && watchpointHits(addr);
+    }
+
+private:
+
+    bool watchpointHits(u32 addr);
+
+public:
     
     
     //
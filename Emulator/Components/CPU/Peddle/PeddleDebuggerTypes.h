@@ -8,6 +8,7 @@
 #pragma once
 
 #include "BasicTypes.h"
+#include "PeddleCondition.h"
 
 namespace vc64::peddle {
 
@@ -26,10 +27,13 @@ struct Guard {
     // Ignore counter
     long ignore;
 
+    // Optional condition (the guard only triggers if it evaluates to true)
+    Condition cond;
+
 public:
 
     // Returns true if the guard hits
-    bool eval(u32 addr);
+    bool eval(u32 addr, const class Peddle &cpu);
 
     // Replaces the address by another
     void moveTo(u32 newAddr);
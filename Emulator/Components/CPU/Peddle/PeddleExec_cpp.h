@@ -61,73 +61,73 @@ Peddle::concludeRead(u8 x)
 #endif
 
 #define FETCH_IR \
-if (likely(!rdyLine)) { LATCH_INSTR(read<C>(reg.pc++)); } else return;
+if (likely(!rdyLine)) { LATCH_INSTR((read<C, D>(reg.pc++))); } else return;
 #define FETCH_ADDR_LO \
-if (likely(!rdyLine)) { LATCH_ADL(read<C>(reg.pc++)); } else return;
+if (likely(!rdyLine)) { LATCH_ADL((read<C, D>(reg.pc++))); } else return;
 #define FETCH_ADDR_HI \
-if (likely(!rdyLine)) { LATCH_ADH(read<C>(reg.pc++)); } else return;
+if (likely(!rdyLine)) { LATCH_ADH((read<C, D>(reg.pc++))); } else return;
 #define FETCH_POINTER_ADDR \
-if (likely(!rdyLine)) { LATCH_IDL(read<C>(reg.pc++)); } else return;
+if (likely(!rdyLine)) { LATCH_IDL((read<C, D>(reg.pc++))); } else return;
 #define FETCH_ADDR_LO_INDIRECT \
-if (likely(!rdyLine)) { LATCH_ADL(read<C>((u16)reg.idl++)); } else return;
+if (likely(!rdyLine)) { LATCH_ADL((read<C, D>((u16)reg.idl++))); } else return;
 #define FETCH_ADDR_HI_INDIRECT \
-if (likely(!rdyLine)) { LATCH_ADH(read<C>((u16)reg.idl++)); } else return;
+if (likely(!rdyLine)) { LATCH_ADH((read<C, D>((u16)reg.idl++))); } else return;
 #define IDLE_FETCH \
-if (likely(!rdyLine)) readIdle<C>(reg.pc); else return;
+if (likely(!rdyLine)) readIdle<C, D>(reg.pc); else return;
 
 #define READ_RELATIVE \
-if (likely(!rdyLine)) { LATCH_D(read<C>(reg.pc)); } else return;
+if (likely(!rdyLine)) { LATCH_D((read<C, D>(reg.pc))); } else return;
 #define READ_IMMEDIATE \
-if (likely(!rdyLine)) { LATCH_D(read<C>(reg.pc++)); } else return;
+if (likely(!rdyLine)) { LATCH_D((read<C, D>(reg.pc++))); } else return;
 #define READ_FROM(x) \
-if (likely(!rdyLine)) { LATCH_D(read<C>(x)); } else return;
+if (likely(!rdyLine)) { LATCH_D((read<C, D>(x))); } else return;
 #define READ_FROM_ADDRESS \
-if (likely(!rdyLine)) { LATCH_D(read<C>(HI_LO(reg.adh, reg.adl))); } else return;
+if (likely(!rdyLine)) { LATCH_D((read<C, D>(HI_LO(reg.adh, reg.adl)))); } else return;
 #define READ_FROM_ZERO_PAGE \
-if (likely(!rdyLine)) { LATCH_D(readZeroPage<C>(reg.adl)); } else return;
+if (likely(!rdyLine)) { LATCH_D((readZeroPage<C, D>(reg.adl))); } else return;
 #define READ_FROM_ADDRESS_INDIRECT \
-if (likely(!rdyLine)) { LATCH_D(readZeroPage<C>(reg.dl)); } else return;
+if (likely(!rdyLine)) { LATCH_D((readZeroPage<C, D>(reg.dl))); } else return;
 
 #define IDLE_READ_IMPLIED \
-if (likely(!rdyLine)) readIdle<C>(reg.pc); else return;
+if (likely(!rdyLine)) readIdle<C, D>(reg.pc); else return;
 #define IDLE_READ_IMMEDIATE \
-if (likely(!rdyLine)) readIdle<C>(reg.pc++); else return;
+if (likely(!rdyLine)) readIdle<C, D>(reg.pc++); else return;
 #define IDLE_READ_FROM(x) \
-if (likely(!rdyLine)) readIdle<C>(x); else return;
+if (likely(!rdyLine)) readIdle<C, D>(x); else return;
 #define IDLE_READ_FROM_ADDRESS \
-if (likely(!rdyLine)) readIdle<C>(HI_LO(reg.adh, reg.adl)); else return;
+if (likely(!rdyLine)) readIdle<C, D>(HI_LO(reg.adh, reg.adl)); else return;
 #define IDLE_READ_FROM_ZERO_PAGE \
-if (likely(!rdyLine)) readZeroPageIdle<C>(reg.adl); else return;
+if (likely(!rdyLine)) readZeroPageIdle<C, D>(reg.adl); else return;
 #define IDLE_READ_FROM_ADDRESS_INDIRECT \
-if (likely(!rdyLine)) readZeroPageIdle<C>(reg.idl); else return;
+if (likely(!rdyLine)) readZeroPageIdle<C, D>(reg.idl); else return;
 
 #define PULL_PCL if \
-(likely(!rdyLine)) { LATCH_PCL(readStack<C>(reg.sp)); } else return;
+(likely(!rdyLine)) { LATCH_PCL((readStack<C, D>(reg.sp))); } else return;
 #define PULL_PCH \
-if (likely(!rdyLine)) { LATCH_PCH(readStack<C>(reg.sp)); } else return;
+if (likely(!rdyLine)) { LATCH_PCH((readStack<C, D>(reg.sp))); } else return;
 #define PULL_P \
-if (likely(!rdyLine)) { LATCH_P(readStack<C>(reg.sp)); } else return;
+if (likely(!rdyLine)) { LATCH_P((readStack<C, D>(reg.sp))); } else return;
 #define PULL_A \
-if (likely(!rdyLine)) { LATCH_A(readStack<C>(reg.sp)); } else return;
+if (likely(!rdyLine)) { LATCH_A((readStack<C, D>(reg.sp))); } else return;
 #define IDLE_PULL \
-if (likely(!rdyLine)) { readStackIdle<C>(reg.sp); } else return;
+if (likely(!rdyLine)) { readStackIdle<C, D>(reg.sp); } else return;
 
 // Write
 
 #define WRITE_TO_ADDRESS \
-write<C>(HI_LO(reg.adh, reg.adl), reg.d);
+write<C, D>(HI_LO(reg.adh, reg.adl), reg.d);
 #define WRITE_TO_ADDRESS_AND_SET_FLAGS \
-write<C>(HI_LO(reg.adh, reg.adl), reg.d); setN(reg.d & 0x80); setZ(reg.d == 0);
+write<C, D>(HI_LO(reg.adh, reg.adl), reg.d); setN(reg.d & 0x80); setZ(reg.d == 0);
 #define WRITE_TO_ZERO_PAGE \
-writeZeroPage<C>(reg.adl, reg.d);
+writeZeroPage<C, D>(reg.adl, reg.d);
 #define WRITE_TO_ZERO_PAGE_AND_SET_FLAGS \
-writeZeroPage<C>(reg.adl, reg.d); setN(reg.d & 0x80); setZ(reg.d == 0);
+writeZeroPage<C, D>(reg.adl, reg.d); setN(reg.d & 0x80); setZ(reg.d == 0);
 
-#define PUSH_PCL writeStack<C>(reg.sp--, LO_BYTE(reg.pc));
-#define PUSH_PCH writeStack<C>(reg.sp--, HI_BYTE(reg.pc));
-#define PUSH_P writeStack<C>(reg.sp--, getP());
-#define PUSH_P_WITH_B_SET writeStack<C>(reg.sp--, getP() | B_FLAG);
-#define PUSH_A writeStack<C>(reg.sp--, reg.a);
+#define PUSH_PCL writeStack<C, D>(reg.sp--, LO_BYTE(reg.pc));
+#define PUSH_PCH writeStack<C, D>(reg.sp--, HI_BYTE(reg.pc));
+#define PUSH_P writeStack<C, D>(reg.sp--, getP());
+#define PUSH_P_WITH_B_SET writeStack<C, D>(reg.sp--, getP() | B_FLAG);
+#define PUSH_A writeStack<C, D>(reg.sp--, reg.a);
 
 #define SET_PCL(lo) reg.pc = (u16)((reg.pc & 0xff00) | (lo));
 #define SET_PCH(hi) reg.pc = (u16)((reg.pc & 0x00ff) | (hi) << 8);
@@ -151,7 +151,14 @@ doNmi |= (edgeDetector.delayed() != 0);
 #define FIX_ADDR_HI reg.adh++;
 
 #define CONTINUE next = (MicroInstruction)((int)next+1); return;
-#define DONE     done<C>(); return;
+#define DONE     done<C, D>(); return;
+
+// Microinstruction entry points (switch label and computed-goto target)
+#if PEDDLE_COMPUTED_GOTO == true
+#define CASE(x) case x: L_##x:
+#else
+#define CASE(x) case x:
+#endif
 
 void
 Peddle::adc(u8 op)
@@ -359,12 +366,30 @@ Peddle::execute()
     }
 }
 
-template <CPURevision C> void
+template <CPURevision C, bool T, bool D> void
 Peddle::execute()
 {
+#if PEDDLE_COMPUTED_GOTO == true
+
+    if constexpr (T) {
+
+        // Jump table (generated from the same list as the MicroInstruction enum)
+        static const void *dispatch[] = {
+
+#define X(name) &&L_##name,
+            PEDDLE_MICRO_INSTRUCTIONS(X)
+#undef X
+        };
+
+        // Jump directly to the handler of the next microinstruction
+        goto *dispatch[next];
+    }
+
+#endif
+
     switch (next) {
             
-        case fetch:
+        CASE(fetch)
 
             if constexpr (C != MOS_6507) {
 
@@ -398,12 +423,12 @@ Peddle::execute()
             // Illegal instructions
             //
             
-        case JAM:
+        CASE(JAM)
 
             cpuDidJam();
             CONTINUE
 
-        case JAM_2:
+        CASE(JAM_2)
             
             POLL_INT
             DONE
@@ -412,17 +437,17 @@ Peddle::execute()
             // IRQ handling
             //
             
-        case irq_2:
+        CASE(irq_2)
             
             IDLE_READ_IMPLIED
             CONTINUE
             
-        case irq_3:
+        CASE(irq_3)
             
             PUSH_PCH
             CONTINUE
             
-        case irq_4:
+        CASE(irq_4)
             
             PUSH_PCL
             // Check for interrupt hijacking
@@ -436,19 +461,19 @@ Peddle::execute()
             }
             CONTINUE
             
-        case irq_5:
+        CASE(irq_5)
             
-            write<C>(0x100+(reg.sp--), getPWithClearedB());
+            write<C, D>(0x100+(reg.sp--), getPWithClearedB());
             CONTINUE
             
-        case irq_6:
+        CASE(irq_6)
             
             READ_FROM(0xFFFE)
             SET_PCL(reg.d);
             setI(1);
             CONTINUE
             
-        case irq_7:
+        CASE(irq_7)
             
             READ_FROM(0xFFFF)
             SET_PCH(reg.d);
@@ -459,34 +484,34 @@ Peddle::execute()
             // NMI handling
             //
 
-        case nmi_2:
+        CASE(nmi_2)
 
             IDLE_READ_IMPLIED
             CONTINUE
             
-        case nmi_3:
+        CASE(nmi_3)
             
             PUSH_PCH
             CONTINUE
             
-        case nmi_4:
+        CASE(nmi_4)
             
             PUSH_PCL
             CONTINUE
             
-        case nmi_5:
+        CASE(nmi_5)
             
-            write<C>(0x100+(reg.sp--), getPWithClearedB());
+            write<C, D>(0x100+(reg.sp--), getPWithClearedB());
             CONTINUE
             
-        case nmi_6:
+        CASE(nmi_6)
             
             READ_FROM(0xFFFA)
             SET_PCL(reg.d);
             setI(1);
             CONTINUE
             
-        case nmi_7:
+        CASE(nmi_7)
 
             READ_FROM(0xFFFB)
             SET_PCH(reg.d);
@@ -497,7 +522,7 @@ Peddle::execute()
             // Adressing mode: Immediate (shared behavior)
             //
 
-        case BRK: case RTI: case RTS:
+        CASE(BRK) CASE(RTI) CASE(RTS)
             
             IDLE_READ_IMMEDIATE
             CONTINUE
@@ -506,7 +531,7 @@ Peddle::execute()
             // Adressing mode: Implied (shared behavior)
             //
 
-        case PHA: case PHP: case PLA: case PLP:
+        CASE(PHA) CASE(PHP) CASE(PLA) CASE(PLP)
             
             IDLE_READ_IMPLIED
             CONTINUE
@@ -515,21 +540,21 @@ Peddle::execute()
             // Adressing mode: Zero-Page  (shared behavior)
             //
 
-        case ADC_zpg: case AND_zpg: case ASL_zpg: case BIT_zpg:
-        case CMP_zpg: case CPX_zpg: case CPY_zpg: case DEC_zpg:
-        case EOR_zpg: case INC_zpg: case LDA_zpg: case LDX_zpg:
-        case LDY_zpg: case LSR_zpg: case NOP_zpg: case ORA_zpg:
-        case ROL_zpg: case ROR_zpg: case SBC_zpg: case STA_zpg:
-        case STX_zpg: case STY_zpg: case DCP_zpg: case ISC_zpg:
-        case LAX_zpg: case RLA_zpg: case RRA_zpg: case SAX_zpg:
-        case SLO_zpg: case SRE_zpg:
+        CASE(ADC_zpg) CASE(AND_zpg) CASE(ASL_zpg) CASE(BIT_zpg)
+        CASE(CMP_zpg) CASE(CPX_zpg) CASE(CPY_zpg) CASE(DEC_zpg)
+        CASE(EOR_zpg) CASE(INC_zpg) CASE(LDA_zpg) CASE(LDX_zpg)
+        CASE(LDY_zpg) CASE(LSR_zpg) CASE(NOP_zpg) CASE(ORA_zpg)
+        CASE(ROL_zpg) CASE(ROR_zpg) CASE(SBC_zpg) CASE(STA_zpg)
+        CASE(STX_zpg) CASE(STY_zpg) CASE(DCP_zpg) CASE(ISC_zpg)
+        CASE(LAX_zpg) CASE(RLA_zpg) CASE(RRA_zpg) CASE(SAX_zpg)
+        CASE(SLO_zpg) CASE(SRE_zpg)
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case ASL_zpg_2: case DEC_zpg_2: case INC_zpg_2: case LSR_zpg_2:
-        case ROL_zpg_2: case ROR_zpg_2: case DCP_zpg_2: case ISC_zpg_2:
-        case RLA_zpg_2: case RRA_zpg_2: case SLO_zpg_2: case SRE_zpg_2:
+        CASE(ASL_zpg_2) CASE(DEC_zpg_2) CASE(INC_zpg_2) CASE(LSR_zpg_2)
+        CASE(ROL_zpg_2) CASE(ROR_zpg_2) CASE(DCP_zpg_2) CASE(ISC_zpg_2)
+        CASE(RLA_zpg_2) CASE(RRA_zpg_2) CASE(SLO_zpg_2) CASE(SRE_zpg_2)
             
             READ_FROM_ZERO_PAGE
             CONTINUE
@@ -538,38 +563,38 @@ Peddle::execute()
             // Adressing mode: Zero-Page Indexed (shared behavior)
             //
             
-        case ADC_zpg_x: case AND_zpg_x: case ASL_zpg_x: case CMP_zpg_x:
-        case DEC_zpg_x: case EOR_zpg_x: case INC_zpg_x: case LDA_zpg_x:
-        case LDY_zpg_x: case LSR_zpg_x: case NOP_zpg_x: case ORA_zpg_x:
-        case ROL_zpg_x: case ROR_zpg_x: case SBC_zpg_x: case STA_zpg_x:
-        case STY_zpg_x: case DCP_zpg_x: case ISC_zpg_x: case RLA_zpg_x:
-        case RRA_zpg_x: case SLO_zpg_x: case SRE_zpg_x:
+        CASE(ADC_zpg_x) CASE(AND_zpg_x) CASE(ASL_zpg_x) CASE(CMP_zpg_x)
+        CASE(DEC_zpg_x) CASE(EOR_zpg_x) CASE(INC_zpg_x) CASE(LDA_zpg_x)
+        CASE(LDY_zpg_x) CASE(LSR_zpg_x) CASE(NOP_zpg_x) CASE(ORA_zpg_x)
+        CASE(ROL_zpg_x) CASE(ROR_zpg_x) CASE(SBC_zpg_x) CASE(STA_zpg_x)
+        CASE(STY_zpg_x) CASE(DCP_zpg_x) CASE(ISC_zpg_x) CASE(RLA_zpg_x)
+        CASE(RRA_zpg_x) CASE(SLO_zpg_x) CASE(SRE_zpg_x)
 
-        case LDX_zpg_y: case STX_zpg_y: case LAX_zpg_y: case SAX_zpg_y:
+        CASE(LDX_zpg_y) CASE(STX_zpg_y) CASE(LAX_zpg_y) CASE(SAX_zpg_y)
             
             FETCH_ADDR_LO
             CONTINUE
 
-        case ADC_zpg_x_2: case AND_zpg_x_2: case ASL_zpg_x_2: case CMP_zpg_x_2:
-        case DEC_zpg_x_2: case EOR_zpg_x_2: case INC_zpg_x_2: case LDA_zpg_x_2:
-        case LDY_zpg_x_2: case LSR_zpg_x_2: case NOP_zpg_x_2: case ORA_zpg_x_2:
-        case ROL_zpg_x_2: case ROR_zpg_x_2: case SBC_zpg_x_2: case DCP_zpg_x_2:
-        case ISC_zpg_x_2: case RLA_zpg_x_2: case RRA_zpg_x_2: case SLO_zpg_x_2:
-        case SRE_zpg_x_2: case STA_zpg_x_2: case STY_zpg_x_2:
+        CASE(ADC_zpg_x_2) CASE(AND_zpg_x_2) CASE(ASL_zpg_x_2) CASE(CMP_zpg_x_2)
+        CASE(DEC_zpg_x_2) CASE(EOR_zpg_x_2) CASE(INC_zpg_x_2) CASE(LDA_zpg_x_2)
+        CASE(LDY_zpg_x_2) CASE(LSR_zpg_x_2) CASE(NOP_zpg_x_2) CASE(ORA_zpg_x_2)
+        CASE(ROL_zpg_x_2) CASE(ROR_zpg_x_2) CASE(SBC_zpg_x_2) CASE(DCP_zpg_x_2)
+        CASE(ISC_zpg_x_2) CASE(RLA_zpg_x_2) CASE(RRA_zpg_x_2) CASE(SLO_zpg_x_2)
+        CASE(SRE_zpg_x_2) CASE(STA_zpg_x_2) CASE(STY_zpg_x_2)
             
             READ_FROM_ZERO_PAGE
             ADD_INDEX_X
             CONTINUE
 
-        case LDX_zpg_y_2: case LAX_zpg_y_2: case STX_zpg_y_2: case SAX_zpg_y_2:
+        CASE(LDX_zpg_y_2) CASE(LAX_zpg_y_2) CASE(STX_zpg_y_2) CASE(SAX_zpg_y_2)
             
             READ_FROM_ZERO_PAGE
             ADD_INDEX_Y
             CONTINUE
 
-        case ASL_zpg_x_3: case DEC_zpg_x_3: case INC_zpg_x_3: case LSR_zpg_x_3:
-        case ROL_zpg_x_3: case ROR_zpg_x_3: case DCP_zpg_x_3: case ISC_zpg_x_3:
-        case RLA_zpg_x_3: case RRA_zpg_x_3: case SLO_zpg_x_3: case SRE_zpg_x_3:
+        CASE(ASL_zpg_x_3) CASE(DEC_zpg_x_3) CASE(INC_zpg_x_3) CASE(LSR_zpg_x_3)
+        CASE(ROL_zpg_x_3) CASE(ROR_zpg_x_3) CASE(DCP_zpg_x_3) CASE(ISC_zpg_x_3)
+        CASE(RLA_zpg_x_3) CASE(RRA_zpg_x_3) CASE(SLO_zpg_x_3) CASE(SRE_zpg_x_3)
             
             READ_FROM_ZERO_PAGE
             CONTINUE
@@ -579,33 +604,33 @@ Peddle::execute()
             // Adressing mode: Absolute (shared behavior)
             //
             
-        case ADC_abs: case AND_abs: case ASL_abs: case BIT_abs:
-        case CMP_abs: case CPX_abs: case CPY_abs: case DEC_abs:
-        case EOR_abs: case INC_abs: case LDA_abs: case LDX_abs:
-        case LDY_abs: case LSR_abs: case NOP_abs: case ORA_abs:
-        case ROL_abs: case ROR_abs: case SBC_abs: case STA_abs:
-        case STX_abs: case STY_abs: case DCP_abs: case ISC_abs:
-        case LAX_abs: case RLA_abs: case RRA_abs: case SAX_abs:
-        case SLO_abs: case SRE_abs:
+        CASE(ADC_abs) CASE(AND_abs) CASE(ASL_abs) CASE(BIT_abs)
+        CASE(CMP_abs) CASE(CPX_abs) CASE(CPY_abs) CASE(DEC_abs)
+        CASE(EOR_abs) CASE(INC_abs) CASE(LDA_abs) CASE(LDX_abs)
+        CASE(LDY_abs) CASE(LSR_abs) CASE(NOP_abs) CASE(ORA_abs)
+        CASE(ROL_abs) CASE(ROR_abs) CASE(SBC_abs) CASE(STA_abs)
+        CASE(STX_abs) CASE(STY_abs) CASE(DCP_abs) CASE(ISC_abs)
+        CASE(LAX_abs) CASE(RLA_abs) CASE(RRA_abs) CASE(SAX_abs)
+        CASE(SLO_abs) CASE(SRE_abs)
             
             FETCH_ADDR_LO
             CONTINUE
 
-        case ADC_abs_2: case AND_abs_2: case ASL_abs_2: case BIT_abs_2:
-        case CMP_abs_2: case CPX_abs_2: case CPY_abs_2: case DEC_abs_2:
-        case EOR_abs_2: case INC_abs_2: case LDA_abs_2: case LDX_abs_2:
-        case LDY_abs_2: case LSR_abs_2: case NOP_abs_2: case ORA_abs_2:
-        case ROL_abs_2: case ROR_abs_2: case SBC_abs_2: case STA_abs_2:
-        case STX_abs_2: case STY_abs_2: case DCP_abs_2: case ISC_abs_2:
-        case LAX_abs_2: case RLA_abs_2: case RRA_abs_2: case SAX_abs_2:
-        case SLO_abs_2: case SRE_abs_2:
+        CASE(ADC_abs_2) CASE(AND_abs_2) CASE(ASL_abs_2) CASE(BIT_abs_2)
+        CASE(CMP_abs_2) CASE(CPX_abs_2) CASE(CPY_abs_2) CASE(DEC_abs_2)
+        CASE(EOR_abs_2) CASE(INC_abs_2) CASE(LDA_abs_2) CASE(LDX_abs_2)
+        CASE(LDY_abs_2) CASE(LSR_abs_2) CASE(NOP_abs_2) CASE(ORA_abs_2)
+        CASE(ROL_abs_2) CASE(ROR_abs_2) CASE(SBC_abs_2) CASE(STA_abs_2)
+        CASE(STX_abs_2) CASE(STY_abs_2) CASE(DCP_abs_2) CASE(ISC_abs_2)
+        CASE(LAX_abs_2) CASE(RLA_abs_2) CASE(RRA_abs_2) CASE(SAX_abs_2)
+        CASE(SLO_abs_2) CASE(SRE_abs_2)
             
             FETCH_ADDR_HI
             CONTINUE
             
-        case ASL_abs_3: case DEC_abs_3: case INC_abs_3: case LSR_abs_3:
-        case ROL_abs_3: case ROR_abs_3: case DCP_abs_3: case ISC_abs_3:
-        case RLA_abs_3: case RRA_abs_3: case SLO_abs_3: case SRE_abs_3:
+        CASE(ASL_abs_3) CASE(DEC_abs_3) CASE(INC_abs_3) CASE(LSR_abs_3)
+        CASE(ROL_abs_3) CASE(ROR_abs_3) CASE(DCP_abs_3) CASE(ISC_abs_3)
+        CASE(RLA_abs_3) CASE(RRA_abs_3) CASE(SLO_abs_3) CASE(SRE_abs_3)
             
             READ_FROM_ADDRESS
             CONTINUE
@@ -614,63 +639,63 @@ Peddle::execute()
             // Adressing mode: Absolute Indexed (shared behavior)
             //
             
-        case ADC_abs_x: case AND_abs_x: case ASL_abs_x: case CMP_abs_x:
-        case DEC_abs_x: case EOR_abs_x: case INC_abs_x: case LDA_abs_x:
-        case LDY_abs_x: case LSR_abs_x: case NOP_abs_x: case ORA_abs_x:
-        case ROL_abs_x: case ROR_abs_x: case SBC_abs_x: case STA_abs_x:
-        case DCP_abs_x: case ISC_abs_x: case RLA_abs_x: case RRA_abs_x:
-        case SHY_abs_x: case SLO_abs_x: case SRE_abs_x:
+        CASE(ADC_abs_x) CASE(AND_abs_x) CASE(ASL_abs_x) CASE(CMP_abs_x)
+        CASE(DEC_abs_x) CASE(EOR_abs_x) CASE(INC_abs_x) CASE(LDA_abs_x)
+        CASE(LDY_abs_x) CASE(LSR_abs_x) CASE(NOP_abs_x) CASE(ORA_abs_x)
+        CASE(ROL_abs_x) CASE(ROR_abs_x) CASE(SBC_abs_x) CASE(STA_abs_x)
+        CASE(DCP_abs_x) CASE(ISC_abs_x) CASE(RLA_abs_x) CASE(RRA_abs_x)
+        CASE(SHY_abs_x) CASE(SLO_abs_x) CASE(SRE_abs_x)
             
-        case ADC_abs_y: case AND_abs_y: case CMP_abs_y: case EOR_abs_y:
-        case LDA_abs_y: case LDX_abs_y: case LSR_abs_y: case ORA_abs_y:
-        case SBC_abs_y: case STA_abs_y: case DCP_abs_y: case ISC_abs_y:
-        case LAS_abs_y: case LAX_abs_y: case RLA_abs_y: case RRA_abs_y:
-        case SHA_abs_y: case SHX_abs_y: case SLO_abs_y: case SRE_abs_y:
-        case TAS_abs_y:
+        CASE(ADC_abs_y) CASE(AND_abs_y) CASE(CMP_abs_y) CASE(EOR_abs_y)
+        CASE(LDA_abs_y) CASE(LDX_abs_y) CASE(LSR_abs_y) CASE(ORA_abs_y)
+        CASE(SBC_abs_y) CASE(STA_abs_y) CASE(DCP_abs_y) CASE(ISC_abs_y)
+        CASE(LAS_abs_y) CASE(LAX_abs_y) CASE(RLA_abs_y) CASE(RRA_abs_y)
+        CASE(SHA_abs_y) CASE(SHX_abs_y) CASE(SLO_abs_y) CASE(SRE_abs_y)
+        CASE(TAS_abs_y)
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case ADC_abs_x_2: case AND_abs_x_2: case ASL_abs_x_2: case CMP_abs_x_2:
-        case DEC_abs_x_2: case EOR_abs_x_2: case INC_abs_x_2: case LDA_abs_x_2:
-        case LDY_abs_x_2: case LSR_abs_x_2: case NOP_abs_x_2: case ORA_abs_x_2:
-        case ROL_abs_x_2: case ROR_abs_x_2: case SBC_abs_x_2: case STA_abs_x_2:
-        case DCP_abs_x_2: case ISC_abs_x_2: case RLA_abs_x_2: case RRA_abs_x_2:
-        case SHY_abs_x_2: case SLO_abs_x_2: case SRE_abs_x_2:
+        CASE(ADC_abs_x_2) CASE(AND_abs_x_2) CASE(ASL_abs_x_2) CASE(CMP_abs_x_2)
+        CASE(DEC_abs_x_2) CASE(EOR_abs_x_2) CASE(INC_abs_x_2) CASE(LDA_abs_x_2)
+        CASE(LDY_abs_x_2) CASE(LSR_abs_x_2) CASE(NOP_abs_x_2) CASE(ORA_abs_x_2)
+        CASE(ROL_abs_x_2) CASE(ROR_abs_x_2) CASE(SBC_abs_x_2) CASE(STA_abs_x_2)
+        CASE(DCP_abs_x_2) CASE(ISC_abs_x_2) CASE(RLA_abs_x_2) CASE(RRA_abs_x_2)
+        CASE(SHY_abs_x_2) CASE(SLO_abs_x_2) CASE(SRE_abs_x_2)
             
             FETCH_ADDR_HI
             ADD_INDEX_X
             CONTINUE
             
-        case ADC_abs_y_2: case AND_abs_y_2: case CMP_abs_y_2: case EOR_abs_y_2:
-        case LDA_abs_y_2: case LDX_abs_y_2: case LSR_abs_y_2: case ORA_abs_y_2:
-        case SBC_abs_y_2: case STA_abs_y_2: case DCP_abs_y_2: case ISC_abs_y_2:
-        case LAS_abs_y_2: case LAX_abs_y_2: case RLA_abs_y_2: case RRA_abs_y_2:
-        case SHA_abs_y_2: case SHX_abs_y_2: case SLO_abs_y_2: case SRE_abs_y_2:
-        case TAS_abs_y_2:
+        CASE(ADC_abs_y_2) CASE(AND_abs_y_2) CASE(CMP_abs_y_2) CASE(EOR_abs_y_2)
+        CASE(LDA_abs_y_2) CASE(LDX_abs_y_2) CASE(LSR_abs_y_2) CASE(ORA_abs_y_2)
+        CASE(SBC_abs_y_2) CASE(STA_abs_y_2) CASE(DCP_abs_y_2) CASE(ISC_abs_y_2)
+        CASE(LAS_abs_y_2) CASE(LAX_abs_y_2) CASE(RLA_abs_y_2) CASE(RRA_abs_y_2)
+        CASE(SHA_abs_y_2) CASE(SHX_abs_y_2) CASE(SLO_abs_y_2) CASE(SRE_abs_y_2)
+        CASE(TAS_abs_y_2)
             
             FETCH_ADDR_HI
             ADD_INDEX_Y
             CONTINUE
             
-        case ASL_abs_x_3: case DEC_abs_x_3: case INC_abs_x_3: case LSR_abs_x_3:
-        case ROL_abs_x_3: case ROR_abs_x_3: case DCP_abs_x_3: case ISC_abs_x_3:
-        case RLA_abs_x_3: case RRA_abs_x_3: case STA_abs_x_3: case SLO_abs_x_3:
-        case SRE_abs_x_3:
+        CASE(ASL_abs_x_3) CASE(DEC_abs_x_3) CASE(INC_abs_x_3) CASE(LSR_abs_x_3)
+        CASE(ROL_abs_x_3) CASE(ROR_abs_x_3) CASE(DCP_abs_x_3) CASE(ISC_abs_x_3)
+        CASE(RLA_abs_x_3) CASE(RRA_abs_x_3) CASE(STA_abs_x_3) CASE(SLO_abs_x_3)
+        CASE(SRE_abs_x_3)
 
-        case LSR_abs_y_3: case STA_abs_y_3: case DCP_abs_y_3: case ISC_abs_y_3:
-        case RLA_abs_y_3: case RRA_abs_y_3: case SLO_abs_y_3: case SRE_abs_y_3:
+        CASE(LSR_abs_y_3) CASE(STA_abs_y_3) CASE(DCP_abs_y_3) CASE(ISC_abs_y_3)
+        CASE(RLA_abs_y_3) CASE(RRA_abs_y_3) CASE(SLO_abs_y_3) CASE(SRE_abs_y_3)
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) { FIX_ADDR_HI }
             CONTINUE
             
-        case ASL_abs_x_4: case DEC_abs_x_4: case INC_abs_x_4: case LSR_abs_x_4:
-        case ROL_abs_x_4: case ROR_abs_x_4: case DCP_abs_x_4: case ISC_abs_x_4:
-        case RLA_abs_x_4: case RRA_abs_x_4: case SLO_abs_x_4: case SRE_abs_x_4:
+        CASE(ASL_abs_x_4) CASE(DEC_abs_x_4) CASE(INC_abs_x_4) CASE(LSR_abs_x_4)
+        CASE(ROL_abs_x_4) CASE(ROR_abs_x_4) CASE(DCP_abs_x_4) CASE(ISC_abs_x_4)
+        CASE(RLA_abs_x_4) CASE(RRA_abs_x_4) CASE(SLO_abs_x_4) CASE(SRE_abs_x_4)
             
-        case DCP_abs_y_4: case LSR_abs_y_4: case ISC_abs_y_4: case RLA_abs_y_4:
-        case RRA_abs_y_4: case SLO_abs_y_4: case SRE_abs_y_4:
+        CASE(DCP_abs_y_4) CASE(LSR_abs_y_4) CASE(ISC_abs_y_4) CASE(RLA_abs_y_4)
+        CASE(RRA_abs_y_4) CASE(SLO_abs_y_4) CASE(SRE_abs_y_4)
             
             READ_FROM_ADDRESS
             CONTINUE
@@ -679,50 +704,50 @@ Peddle::execute()
             // Adressing mode: Indexed Indirect (shared behavior)
             //
 
-        case ADC_ind_x: case AND_ind_x: case ASL_ind_x: case CMP_ind_x:
-        case DEC_ind_x: case EOR_ind_x: case INC_ind_x: case LDA_ind_x:
-        case LDX_ind_x: case LDY_ind_x: case LSR_ind_x: case ORA_ind_x:
-        case ROL_ind_x: case ROR_ind_x: case SBC_ind_x: case STA_ind_x:
-        case DCP_ind_x: case ISC_ind_x: case LAX_ind_x: case RLA_ind_x:
-        case RRA_ind_x: case SAX_ind_x: case SLO_ind_x: case SRE_ind_x:
+        CASE(ADC_ind_x) CASE(AND_ind_x) CASE(ASL_ind_x) CASE(CMP_ind_x)
+        CASE(DEC_ind_x) CASE(EOR_ind_x) CASE(INC_ind_x) CASE(LDA_ind_x)
+        CASE(LDX_ind_x) CASE(LDY_ind_x) CASE(LSR_ind_x) CASE(ORA_ind_x)
+        CASE(ROL_ind_x) CASE(ROR_ind_x) CASE(SBC_ind_x) CASE(STA_ind_x)
+        CASE(DCP_ind_x) CASE(ISC_ind_x) CASE(LAX_ind_x) CASE(RLA_ind_x)
+        CASE(RRA_ind_x) CASE(SAX_ind_x) CASE(SLO_ind_x) CASE(SRE_ind_x)
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case ADC_ind_x_2: case AND_ind_x_2: case ASL_ind_x_2: case CMP_ind_x_2:
-        case DEC_ind_x_2: case EOR_ind_x_2: case INC_ind_x_2: case LDA_ind_x_2:
-        case LDX_ind_x_2: case LDY_ind_x_2: case LSR_ind_x_2: case ORA_ind_x_2:
-        case ROL_ind_x_2: case ROR_ind_x_2: case SBC_ind_x_2: case STA_ind_x_2:
-        case DCP_ind_x_2: case ISC_ind_x_2: case LAX_ind_x_2: case RLA_ind_x_2:
-        case RRA_ind_x_2: case SAX_ind_x_2: case SLO_ind_x_2: case SRE_ind_x_2:
+        CASE(ADC_ind_x_2) CASE(AND_ind_x_2) CASE(ASL_ind_x_2) CASE(CMP_ind_x_2)
+        CASE(DEC_ind_x_2) CASE(EOR_ind_x_2) CASE(INC_ind_x_2) CASE(LDA_ind_x_2)
+        CASE(LDX_ind_x_2) CASE(LDY_ind_x_2) CASE(LSR_ind_x_2) CASE(ORA_ind_x_2)
+        CASE(ROL_ind_x_2) CASE(ROR_ind_x_2) CASE(SBC_ind_x_2) CASE(STA_ind_x_2)
+        CASE(DCP_ind_x_2) CASE(ISC_ind_x_2) CASE(LAX_ind_x_2) CASE(RLA_ind_x_2)
+        CASE(RRA_ind_x_2) CASE(SAX_ind_x_2) CASE(SLO_ind_x_2) CASE(SRE_ind_x_2)
             
             IDLE_READ_FROM_ADDRESS_INDIRECT
             ADD_INDEX_X_INDIRECT
             CONTINUE
             
-        case ADC_ind_x_3: case AND_ind_x_3: case ASL_ind_x_3: case CMP_ind_x_3:
-        case DEC_ind_x_3: case EOR_ind_x_3: case INC_ind_x_3: case LDA_ind_x_3:
-        case LDX_ind_x_3: case LDY_ind_x_3: case LSR_ind_x_3: case ORA_ind_x_3:
-        case ROL_ind_x_3: case ROR_ind_x_3: case SBC_ind_x_3: case STA_ind_x_3:
-        case DCP_ind_x_3: case ISC_ind_x_3: case LAX_ind_x_3: case RLA_ind_x_3:
-        case RRA_ind_x_3: case SAX_ind_x_3: case SLO_ind_x_3: case SRE_ind_x_3:
+        CASE(ADC_ind_x_3) CASE(AND_ind_x_3) CASE(ASL_ind_x_3) CASE(CMP_ind_x_3)
+        CASE(DEC_ind_x_3) CASE(EOR_ind_x_3) CASE(INC_ind_x_3) CASE(LDA_ind_x_3)
+        CASE(LDX_ind_x_3) CASE(LDY_ind_x_3) CASE(LSR_ind_x_3) CASE(ORA_ind_x_3)
+        CASE(ROL_ind_x_3) CASE(ROR_ind_x_3) CASE(SBC_ind_x_3) CASE(STA_ind_x_3)
+        CASE(DCP_ind_x_3) CASE(ISC_ind_x_3) CASE(LAX_ind_x_3) CASE(RLA_ind_x_3)
+        CASE(RRA_ind_x_3) CASE(SAX_ind_x_3) CASE(SLO_ind_x_3) CASE(SRE_ind_x_3)
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case ADC_ind_x_4: case AND_ind_x_4: case ASL_ind_x_4: case CMP_ind_x_4:
-        case DEC_ind_x_4: case EOR_ind_x_4: case INC_ind_x_4: case LDA_ind_x_4:
-        case LDX_ind_x_4: case LDY_ind_x_4: case LSR_ind_x_4: case ORA_ind_x_4:
-        case ROL_ind_x_4: case ROR_ind_x_4: case SBC_ind_x_4: case STA_ind_x_4:
-        case DCP_ind_x_4: case ISC_ind_x_4: case LAX_ind_x_4: case RLA_ind_x_4:
-        case RRA_ind_x_4: case SAX_ind_x_4: case SLO_ind_x_4: case SRE_ind_x_4:
+        CASE(ADC_ind_x_4) CASE(AND_ind_x_4) CASE(ASL_ind_x_4) CASE(CMP_ind_x_4)
+        CASE(DEC_ind_x_4) CASE(EOR_ind_x_4) CASE(INC_ind_x_4) CASE(LDA_ind_x_4)
+        CASE(LDX_ind_x_4) CASE(LDY_ind_x_4) CASE(LSR_ind_x_4) CASE(ORA_ind_x_4)
+        CASE(ROL_ind_x_4) CASE(ROR_ind_x_4) CASE(SBC_ind_x_4) CASE(STA_ind_x_4)
+        CASE(DCP_ind_x_4) CASE(ISC_ind_x_4) CASE(LAX_ind_x_4) CASE(RLA_ind_x_4)
+        CASE(RRA_ind_x_4) CASE(SAX_ind_x_4) CASE(SLO_ind_x_4) CASE(SRE_ind_x_4)
             
             FETCH_ADDR_HI_INDIRECT
             CONTINUE
             
-        case ASL_ind_x_5: case DEC_ind_x_5: case INC_ind_x_5: case LSR_ind_x_5:
-        case ROL_ind_x_5: case ROR_ind_x_5: case DCP_ind_x_5: case ISC_ind_x_5:
-        case RLA_ind_x_5: case RRA_ind_x_5: case SLO_ind_x_5: case SRE_ind_x_5:
+        CASE(ASL_ind_x_5) CASE(DEC_ind_x_5) CASE(INC_ind_x_5) CASE(LSR_ind_x_5)
+        CASE(ROL_ind_x_5) CASE(ROR_ind_x_5) CASE(DCP_ind_x_5) CASE(ISC_ind_x_5)
+        CASE(RLA_ind_x_5) CASE(RRA_ind_x_5) CASE(SLO_ind_x_5) CASE(SRE_ind_x_5)
             
             READ_FROM_ADDRESS
             CONTINUE
@@ -731,43 +756,43 @@ Peddle::execute()
             // Adressing mode: Indirect Indexed (shared behavior)
             //
             
-        case ADC_ind_y: case AND_ind_y: case CMP_ind_y: case EOR_ind_y:
-        case LDA_ind_y: case LDX_ind_y: case LDY_ind_y: case LSR_ind_y:
-        case ORA_ind_y: case SBC_ind_y: case STA_ind_y: case DCP_ind_y:
-        case ISC_ind_y: case LAX_ind_y: case RLA_ind_y: case RRA_ind_y:
-        case SHA_ind_y: case SLO_ind_y: case SRE_ind_y:
+        CASE(ADC_ind_y) CASE(AND_ind_y) CASE(CMP_ind_y) CASE(EOR_ind_y)
+        CASE(LDA_ind_y) CASE(LDX_ind_y) CASE(LDY_ind_y) CASE(LSR_ind_y)
+        CASE(ORA_ind_y) CASE(SBC_ind_y) CASE(STA_ind_y) CASE(DCP_ind_y)
+        CASE(ISC_ind_y) CASE(LAX_ind_y) CASE(RLA_ind_y) CASE(RRA_ind_y)
+        CASE(SHA_ind_y) CASE(SLO_ind_y) CASE(SRE_ind_y)
             
             FETCH_POINTER_ADDR
             CONTINUE
 
-        case ADC_ind_y_2: case AND_ind_y_2: case CMP_ind_y_2: case EOR_ind_y_2:
-        case LDA_ind_y_2: case LDX_ind_y_2: case LDY_ind_y_2: case LSR_ind_y_2:
-        case ORA_ind_y_2: case SBC_ind_y_2: case STA_ind_y_2: case DCP_ind_y_2:
-        case ISC_ind_y_2: case LAX_ind_y_2: case RLA_ind_y_2: case RRA_ind_y_2:
-        case SHA_ind_y_2: case SLO_ind_y_2: case SRE_ind_y_2:
+        CASE(ADC_ind_y_2) CASE(AND_ind_y_2) CASE(CMP_ind_y_2) CASE(EOR_ind_y_2)
+        CASE(LDA_ind_y_2) CASE(LDX_ind_y_2) CASE(LDY_ind_y_2) CASE(LSR_ind_y_2)
+        CASE(ORA_ind_y_2) CASE(SBC_ind_y_2) CASE(STA_ind_y_2) CASE(DCP_ind_y_2)
+        CASE(ISC_ind_y_2) CASE(LAX_ind_y_2) CASE(RLA_ind_y_2) CASE(RRA_ind_y_2)
+        CASE(SHA_ind_y_2) CASE(SLO_ind_y_2) CASE(SRE_ind_y_2)
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case ADC_ind_y_3: case AND_ind_y_3: case CMP_ind_y_3: case EOR_ind_y_3:
-        case LDA_ind_y_3: case LDX_ind_y_3: case LDY_ind_y_3: case LSR_ind_y_3:
-        case ORA_ind_y_3: case SBC_ind_y_3: case STA_ind_y_3: case DCP_ind_y_3:
-        case ISC_ind_y_3: case LAX_ind_y_3: case RLA_ind_y_3: case RRA_ind_y_3:
-        case SHA_ind_y_3: case SLO_ind_y_3: case SRE_ind_y_3:
+        CASE(ADC_ind_y_3) CASE(AND_ind_y_3) CASE(CMP_ind_y_3) CASE(EOR_ind_y_3)
+        CASE(LDA_ind_y_3) CASE(LDX_ind_y_3) CASE(LDY_ind_y_3) CASE(LSR_ind_y_3)
+        CASE(ORA_ind_y_3) CASE(SBC_ind_y_3) CASE(STA_ind_y_3) CASE(DCP_ind_y_3)
+        CASE(ISC_ind_y_3) CASE(LAX_ind_y_3) CASE(RLA_ind_y_3) CASE(RRA_ind_y_3)
+        CASE(SHA_ind_y_3) CASE(SLO_ind_y_3) CASE(SRE_ind_y_3)
             
             FETCH_ADDR_HI_INDIRECT
             ADD_INDEX_Y
             CONTINUE
 
-        case LSR_ind_y_4: case STA_ind_y_4: case DCP_ind_y_4: case ISC_ind_y_4:
-        case RLA_ind_y_4: case RRA_ind_y_4: case SLO_ind_y_4: case SRE_ind_y_4:
+        CASE(LSR_ind_y_4) CASE(STA_ind_y_4) CASE(DCP_ind_y_4) CASE(ISC_ind_y_4)
+        CASE(RLA_ind_y_4) CASE(RRA_ind_y_4) CASE(SLO_ind_y_4) CASE(SRE_ind_y_4)
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) { FIX_ADDR_HI }
             CONTINUE
             
-        case LSR_ind_y_5: case DCP_ind_y_5: case ISC_ind_y_5: case RLA_ind_y_5:
-        case RRA_ind_y_5: case SLO_ind_y_5: case SRE_ind_y_5:
+        CASE(LSR_ind_y_5) CASE(DCP_ind_y_5) CASE(ISC_ind_y_5) CASE(RLA_ind_y_5)
+        CASE(RRA_ind_y_5) CASE(SLO_ind_y_5) CASE(SRE_ind_y_5)
             
             READ_FROM_ADDRESS
             CONTINUE
@@ -776,8 +801,8 @@ Peddle::execute()
             // Adressing mode: Relative (shared behavior)
             //
             
-        case BCC_rel_2: case BCS_rel_2: case BEQ_rel_2: case BMI_rel_2:
-        case BNE_rel_2: case BPL_rel_2: case BVC_rel_2: case BVS_rel_2:
+        CASE(BCC_rel_2) CASE(BCS_rel_2) CASE(BEQ_rel_2) CASE(BMI_rel_2)
+        CASE(BNE_rel_2) CASE(BPL_rel_2) CASE(BVC_rel_2) CASE(BVS_rel_2)
         {
             IDLE_READ_IMPLIED
             u8 pc_hi = HI_BYTE(reg.pc);
@@ -790,13 +815,13 @@ Peddle::execute()
             DONE
         }
             
-        case branch_3_underflow:
+        CASE(branch_3_underflow)
             
             IDLE_READ_FROM(reg.pc + 0x100)
             POLL_INT_AGAIN
             DONE
             
-        case branch_3_overflow:
+        CASE(branch_3_overflow)
             
             IDLE_READ_FROM(reg.pc - 0x100)
             POLL_INT_AGAIN
@@ -810,24 +835,24 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / / - - /
 
-        case ADC_imm:
+        CASE(ADC_imm)
 
             READ_IMMEDIATE
             adc(reg.d);
             POLL_INT
             DONE
 
-        case ADC_zpg_2:
-        case ADC_zpg_x_3:
+        CASE(ADC_zpg_2)
+        CASE(ADC_zpg_x_3)
             
             READ_FROM_ZERO_PAGE
             adc(reg.d);
             POLL_INT
             DONE
 
-        case ADC_abs_x_3:
-        case ADC_abs_y_3:
-        case ADC_ind_y_4:
+        CASE(ADC_abs_x_3)
+        CASE(ADC_abs_y_3)
+        CASE(ADC_ind_y_4)
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -839,11 +864,11 @@ Peddle::execute()
                 DONE
             }
             
-        case ADC_abs_3:
-        case ADC_abs_x_4:
-        case ADC_abs_y_4:
-        case ADC_ind_x_5:
-        case ADC_ind_y_5:
+        CASE(ADC_abs_3)
+        CASE(ADC_abs_x_4)
+        CASE(ADC_abs_y_4)
+        CASE(ADC_ind_x_5)
+        CASE(ADC_ind_y_5)
             
             READ_FROM_ADDRESS
             adc(reg.d);
@@ -858,24 +883,24 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / - - - -
 
-        case AND_imm:
+        CASE(AND_imm)
             
             READ_IMMEDIATE
             loadA(reg.a & reg.d);
             POLL_INT
             DONE
 
-        case AND_zpg_2:
-        case AND_zpg_x_3:
+        CASE(AND_zpg_2)
+        CASE(AND_zpg_x_3)
             
             READ_FROM_ZERO_PAGE
             loadA(reg.a & reg.d);
             POLL_INT
             DONE
             
-        case AND_abs_x_3:
-        case AND_abs_y_3:
-        case AND_ind_y_4:
+        CASE(AND_abs_x_3)
+        CASE(AND_abs_y_3)
+        CASE(AND_ind_y_4)
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -887,11 +912,11 @@ Peddle::execute()
                 DONE
             }
             
-        case AND_abs_3:
-        case AND_abs_x_4:
-        case AND_abs_y_4:
-        case AND_ind_x_5:
-        case AND_ind_y_5:
+        CASE(AND_abs_3)
+        CASE(AND_abs_x_4)
+        CASE(AND_abs_y_4)
+        CASE(AND_ind_x_5)
+        CASE(AND_ind_y_5)
             
             READ_FROM_ADDRESS
             loadA(reg.a & reg.d);
@@ -909,38 +934,38 @@ Peddle::execute()
 #define DO_ASL_ACC setC(reg.a & 0x80); loadA((u8)(reg.a << 1));
 #define DO_ASL setC(reg.d & 0x80); reg.d = (u8)(reg.d << 1);
 
-        case ASL_acc:
+        CASE(ASL_acc)
             
             IDLE_READ_IMPLIED
             DO_ASL_ACC
             POLL_INT
             DONE
             
-        case ASL_zpg_3:
-        case ASL_zpg_x_4:
+        CASE(ASL_zpg_3)
+        CASE(ASL_zpg_x_4)
             
             WRITE_TO_ZERO_PAGE
             DO_ASL
             CONTINUE
 
-        case ASL_abs_4:
-        case ASL_abs_x_5:
-        case ASL_ind_x_6:
+        CASE(ASL_abs_4)
+        CASE(ASL_abs_x_5)
+        CASE(ASL_ind_x_6)
             
             WRITE_TO_ADDRESS
             DO_ASL
             CONTINUE
             
-        case ASL_zpg_4:
-        case ASL_zpg_x_5:
+        CASE(ASL_zpg_4)
+        CASE(ASL_zpg_x_5)
             
             WRITE_TO_ZERO_PAGE_AND_SET_FLAGS
             POLL_INT
             DONE
             
-        case ASL_abs_5:
-        case ASL_abs_x_6:
-        case ASL_ind_x_7:
+        CASE(ASL_abs_5)
+        CASE(ASL_abs_x_6)
+        CASE(ASL_ind_x_7)
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             POLL_INT
@@ -954,7 +979,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              - - - - - -
 
-        case BCC_rel:
+        CASE(BCC_rel)
             
             READ_IMMEDIATE
             POLL_INT
@@ -973,7 +998,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              - - - - - -
 
-        case BCS_rel:
+        CASE(BCS_rel)
             
             READ_IMMEDIATE
             POLL_INT
@@ -992,7 +1017,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              - - - - - -
             
-        case BEQ_rel:
+        CASE(BEQ_rel)
             
             READ_IMMEDIATE
             POLL_INT
@@ -1011,7 +1036,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / - - - /
             
-        case BIT_zpg_2:
+        CASE(BIT_zpg_2)
             
             READ_FROM_ZERO_PAGE
             setN(reg.d & 128);
@@ -1020,7 +1045,7 @@ Peddle::execute()
             POLL_INT
             DONE
 
-        case BIT_abs_3:
+        CASE(BIT_abs_3)
             
             READ_FROM_ADDRESS
             setN(reg.d & 128);
@@ -1037,7 +1062,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              - - - - - -
 
-        case BMI_rel:
+        CASE(BMI_rel)
             
             READ_IMMEDIATE
             POLL_INT
@@ -1056,7 +1081,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              - - - - - -
             
-        case BNE_rel:
+        CASE(BNE_rel)
             
             READ_IMMEDIATE
             POLL_INT
@@ -1075,7 +1100,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              - - - - - -
 
-        case BPL_rel:
+        CASE(BPL_rel)
             
             READ_IMMEDIATE
             POLL_INT
@@ -1094,13 +1119,13 @@ Peddle::execute()
             // Flags:       N Z C I D V    B
             //              - - - 1 - -    1
             
-        case BRK_2:
+        CASE(BRK_2)
             
             setB(1);
             PUSH_PCH
             CONTINUE
             
-        case BRK_3:
+        CASE(BRK_3)
 
             PUSH_PCL
             
@@ -1117,19 +1142,19 @@ Peddle::execute()
                 CONTINUE
             }
             
-        case BRK_4:
+        CASE(BRK_4)
             
             PUSH_P
             CONTINUE
             
-        case BRK_5:
+        CASE(BRK_5)
             
             READ_FROM(0xFFFE);
             SET_PCL(reg.d);
             setI(1);
             CONTINUE
             
-        case BRK_6:
+        CASE(BRK_6)
             
             READ_FROM(0xFFFF);
             SET_PCH(reg.d);
@@ -1139,19 +1164,19 @@ Peddle::execute()
             // after a BRK command, but not NMIs.
             DONE
             
-        case BRK_nmi_4:
+        CASE(BRK_nmi_4)
             
             PUSH_P
             CONTINUE
             
-        case BRK_nmi_5:
+        CASE(BRK_nmi_5)
             
             READ_FROM(0xFFFA);
             SET_PCL(reg.d);
             setI(1);
             CONTINUE
             
-        case BRK_nmi_6:
+        CASE(BRK_nmi_6)
             
             READ_FROM(0xFFFB);
             SET_PCH(reg.d);
@@ -1166,7 +1191,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              - - - - - -
 
-        case BVC_rel:
+        CASE(BVC_rel)
             
             READ_IMMEDIATE
             POLL_INT
@@ -1185,7 +1210,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              - - - - - -
 
-        case BVS_rel:
+        CASE(BVS_rel)
             
             READ_IMMEDIATE
             POLL_INT
@@ -1204,7 +1229,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              - - 0 - - -
 
-        case CLC:
+        CASE(CLC)
             
             IDLE_READ_IMPLIED
             setC(0);
@@ -1219,7 +1244,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              - - - - 0 -
 
-        case CLD:
+        CASE(CLD)
             
             IDLE_READ_IMPLIED
             setD(0);
@@ -1234,7 +1259,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              - - - 0 - -
 
-        case CLI:
+        CASE(CLI)
             
             POLL_INT
             setI(0);
@@ -1249,7 +1274,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              - - - - - 0
 
-        case CLV:
+        CASE(CLV)
             
             IDLE_READ_IMPLIED
             setV(0);
@@ -1264,24 +1289,24 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / / - - -
 
-        case CMP_imm:
+        CASE(CMP_imm)
             
             READ_IMMEDIATE
             cmp(reg.a, reg.d);
             POLL_INT
             DONE
 
-        case CMP_zpg_2:
-        case CMP_zpg_x_3:
+        CASE(CMP_zpg_2)
+        CASE(CMP_zpg_x_3)
             
             READ_FROM_ZERO_PAGE
             cmp(reg.a, reg.d);
             POLL_INT
             DONE
 
-        case CMP_abs_x_3:
-        case CMP_abs_y_3:
-        case CMP_ind_y_4:
+        CASE(CMP_abs_x_3)
+        CASE(CMP_abs_y_3)
+        CASE(CMP_ind_y_4)
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -1293,11 +1318,11 @@ Peddle::execute()
                 DONE
             }
             
-        case CMP_abs_3:
-        case CMP_abs_x_4:
-        case CMP_abs_y_4:
-        case CMP_ind_x_5:
-        case CMP_ind_y_5:
+        CASE(CMP_abs_3)
+        CASE(CMP_abs_x_4)
+        CASE(CMP_abs_y_4)
+        CASE(CMP_ind_x_5)
+        CASE(CMP_ind_y_5)
             
             READ_FROM_ADDRESS
             cmp(reg.a, reg.d);
@@ -1312,21 +1337,21 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / / - - -
 
-        case CPX_imm:
+        CASE(CPX_imm)
             
             READ_IMMEDIATE
             cmp(reg.x, reg.d);
             POLL_INT
             DONE
             
-        case CPX_zpg_2:
+        CASE(CPX_zpg_2)
             
             READ_FROM_ZERO_PAGE
             cmp(reg.x, reg.d);
             POLL_INT
             DONE
             
-        case CPX_abs_3:
+        CASE(CPX_abs_3)
             
             READ_FROM_ADDRESS
             cmp(reg.x, reg.d);
@@ -1341,21 +1366,21 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / / - - -
 
-        case CPY_imm:
+        CASE(CPY_imm)
             
             READ_IMMEDIATE
             cmp(reg.y, reg.d);
             POLL_INT
             DONE
 
-        case CPY_zpg_2:
+        CASE(CPY_zpg_2)
             
             READ_FROM_ZERO_PAGE
             cmp(reg.y, reg.d);
             POLL_INT
             DONE
 
-        case CPY_abs_3:
+        CASE(CPY_abs_3)
             
             READ_FROM_ADDRESS
             cmp(reg.y, reg.d);
@@ -1372,31 +1397,31 @@ Peddle::execute()
             
 #define DO_DEC reg.d--;
             
-        case DEC_zpg_3:
-        case DEC_zpg_x_4:
+        CASE(DEC_zpg_3)
+        CASE(DEC_zpg_x_4)
             
             WRITE_TO_ZERO_PAGE
             DO_DEC
             CONTINUE
             
-        case DEC_zpg_4:
-        case DEC_zpg_x_5:
+        CASE(DEC_zpg_4)
+        CASE(DEC_zpg_x_5)
             
             WRITE_TO_ZERO_PAGE_AND_SET_FLAGS
             POLL_INT
             DONE
             
-        case DEC_abs_4:
-        case DEC_abs_x_5:
-        case DEC_ind_x_6:
+        CASE(DEC_abs_4)
+        CASE(DEC_abs_x_5)
+        CASE(DEC_ind_x_6)
             
             WRITE_TO_ADDRESS
             DO_DEC
             CONTINUE
             
-        case DEC_abs_5:
-        case DEC_abs_x_6:
-        case DEC_ind_x_7:
+        CASE(DEC_abs_5)
+        CASE(DEC_abs_x_6)
+        CASE(DEC_ind_x_7)
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             POLL_INT
@@ -1410,7 +1435,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / - - - -
 
-        case DEX:
+        CASE(DEX)
             
             IDLE_READ_IMPLIED
             loadX(reg.x - 1);
@@ -1425,7 +1450,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / - - - -
 
-        case DEY:
+        CASE(DEY)
             
             IDLE_READ_IMPLIED
             loadY(reg.y - 1);
@@ -1442,24 +1467,24 @@ Peddle::execute()
 
 #define DO_EOR loadA(reg.a ^ reg.d);
             
-        case EOR_imm:
+        CASE(EOR_imm)
             
             READ_IMMEDIATE
             DO_EOR
             POLL_INT
             DONE
             
-        case EOR_zpg_2:
-        case EOR_zpg_x_3:
+        CASE(EOR_zpg_2)
+        CASE(EOR_zpg_x_3)
             
             READ_FROM_ZERO_PAGE
             DO_EOR
             POLL_INT
             DONE
             
-        case EOR_abs_x_3:
-        case EOR_abs_y_3:
-        case EOR_ind_y_4:
+        CASE(EOR_abs_x_3)
+        CASE(EOR_abs_y_3)
+        CASE(EOR_ind_y_4)
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -1471,11 +1496,11 @@ Peddle::execute()
                 DONE
             }
 
-        case EOR_abs_3:
-        case EOR_abs_x_4:
-        case EOR_abs_y_4:
-        case EOR_ind_x_5:
-        case EOR_ind_y_5:
+        CASE(EOR_abs_3)
+        CASE(EOR_abs_x_4)
+        CASE(EOR_abs_y_4)
+        CASE(EOR_ind_x_5)
+        CASE(EOR_ind_y_5)
             
             READ_FROM_ADDRESS
             DO_EOR
@@ -1492,31 +1517,31 @@ Peddle::execute()
             
 #define DO_INC reg.d++;
             
-        case INC_zpg_3:
-        case INC_zpg_x_4:
+        CASE(INC_zpg_3)
+        CASE(INC_zpg_x_4)
             
             WRITE_TO_ZERO_PAGE
             DO_INC
             CONTINUE
             
-        case INC_zpg_4:
-        case INC_zpg_x_5:
+        CASE(INC_zpg_4)
+        CASE(INC_zpg_x_5)
             
             WRITE_TO_ZERO_PAGE_AND_SET_FLAGS
             POLL_INT
             DONE
 
-        case INC_abs_4:
-        case INC_abs_x_5:
-        case INC_ind_x_6:
+        CASE(INC_abs_4)
+        CASE(INC_abs_x_5)
+        CASE(INC_ind_x_6)
             
             WRITE_TO_ADDRESS
             DO_INC
             CONTINUE
             
-        case INC_abs_5:
-        case INC_abs_x_6:
-        case INC_ind_x_7:
+        CASE(INC_abs_5)
+        CASE(INC_abs_x_6)
+        CASE(INC_ind_x_7)
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             POLL_INT
@@ -1530,7 +1555,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / - - - -
 
-        case INX:
+        CASE(INX)
             
             IDLE_READ_IMPLIED
             loadX(reg.x + 1);
@@ -1545,7 +1570,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / - - - -
 
-        case INY:
+        CASE(INY)
             
             IDLE_READ_IMPLIED
             loadY(reg.y + 1);
@@ -1560,36 +1585,36 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              - - - - - -
 
-        case JMP_abs:
+        CASE(JMP_abs)
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case JMP_abs_2:
+        CASE(JMP_abs_2)
             
             FETCH_ADDR_HI
             reg.pc = LO_HI(reg.adl, reg.adh);
             POLL_INT
             DONE
 
-        case JMP_abs_ind:
+        CASE(JMP_abs_ind)
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case JMP_abs_ind_2:
+        CASE(JMP_abs_ind_2)
             
             FETCH_ADDR_HI
             CONTINUE
             
-        case JMP_abs_ind_3:
+        CASE(JMP_abs_ind_3)
             
             READ_FROM_ADDRESS
             SET_PCL(reg.d);
             reg.adl++;
             CONTINUE
             
-        case JMP_abs_ind_4:
+        CASE(JMP_abs_ind_4)
             
             READ_FROM_ADDRESS
             SET_PCH(reg.d);
@@ -1604,27 +1629,27 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              - - - - - -
             
-        case JSR:
+        CASE(JSR)
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case JSR_2:
+        CASE(JSR_2)
             
             IDLE_PULL
             CONTINUE
             
-        case JSR_3:
+        CASE(JSR_3)
             
             PUSH_PCH
             CONTINUE
             
-        case JSR_4:
+        CASE(JSR_4)
             
             PUSH_PCL
             CONTINUE
             
-        case JSR_5:
+        CASE(JSR_5)
             
             FETCH_ADDR_HI
             reg.pc = LO_HI(reg.adl, reg.adh);
@@ -1639,24 +1664,24 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / - - - -
 
-        case LDA_imm:
+        CASE(LDA_imm)
             
             READ_IMMEDIATE
             loadA(reg.d);
             POLL_INT
             DONE
 
-        case LDA_zpg_2:
-        case LDA_zpg_x_3:
+        CASE(LDA_zpg_2)
+        CASE(LDA_zpg_x_3)
             
             READ_FROM_ZERO_PAGE
             loadA(reg.d);
             POLL_INT
             DONE
 
-        case LDA_abs_x_3:
-        case LDA_abs_y_3:
-        case LDA_ind_y_4:
+        CASE(LDA_abs_x_3)
+        CASE(LDA_abs_y_3)
+        CASE(LDA_ind_y_4)
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -1668,11 +1693,11 @@ Peddle::execute()
                 DONE
             }
             
-        case LDA_abs_3:
-        case LDA_abs_x_4:
-        case LDA_abs_y_4:
-        case LDA_ind_x_5:
-        case LDA_ind_y_5:
+        CASE(LDA_abs_3)
+        CASE(LDA_abs_x_4)
+        CASE(LDA_abs_y_4)
+        CASE(LDA_ind_x_5)
+        CASE(LDA_ind_y_5)
             
             READ_FROM_ADDRESS
             loadA(reg.d);
@@ -1687,23 +1712,23 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / - - - -
 
-        case LDX_imm:
+        CASE(LDX_imm)
             
             READ_IMMEDIATE
             loadX(reg.d);
             POLL_INT
             DONE
 
-        case LDX_zpg_2:
-        case LDX_zpg_y_3:
+        CASE(LDX_zpg_2)
+        CASE(LDX_zpg_y_3)
             
             READ_FROM_ZERO_PAGE
             loadX(reg.d);
             POLL_INT
             DONE
 
-        case LDX_abs_y_3:
-        case LDX_ind_y_4:
+        CASE(LDX_abs_y_3)
+        CASE(LDX_ind_y_4)
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -1715,10 +1740,10 @@ Peddle::execute()
                 DONE
             }
             
-        case LDX_abs_3:
-        case LDX_abs_y_4:
-        case LDX_ind_x_5:
-        case LDX_ind_y_5:
+        CASE(LDX_abs_3)
+        CASE(LDX_abs_y_4)
+        CASE(LDX_ind_x_5)
+        CASE(LDX_ind_y_5)
             
             READ_FROM_ADDRESS
             loadX(reg.d);
@@ -1733,23 +1758,23 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / - - - -
 
-        case LDY_imm:
+        CASE(LDY_imm)
             
             READ_IMMEDIATE
             loadY(reg.d);
             POLL_INT
             DONE
             
-        case LDY_zpg_2:
-        case LDY_zpg_x_3:
+        CASE(LDY_zpg_2)
+        CASE(LDY_zpg_x_3)
             
             READ_FROM_ZERO_PAGE
             loadY(reg.d);
             POLL_INT
             DONE
 
-        case LDY_abs_x_3:
-        case LDY_ind_y_4:
+        CASE(LDY_abs_x_3)
+        CASE(LDY_ind_y_4)
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -1761,10 +1786,10 @@ Peddle::execute()
                 DONE
             }
 
-        case LDY_abs_3:
-        case LDY_abs_x_4:
-        case LDY_ind_x_5:
-        case LDY_ind_y_5:
+        CASE(LDY_abs_3)
+        CASE(LDY_abs_x_4)
+        CASE(LDY_ind_x_5)
+        CASE(LDY_ind_y_5)
             
             READ_FROM_ADDRESS
             loadY(reg.d);
@@ -1779,42 +1804,42 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              0 / / - - -
 
-        case LSR_acc:
+        CASE(LSR_acc)
             
             IDLE_READ_IMPLIED
             setC(reg.a & 1); loadA(reg.a >> 1);
             POLL_INT
             DONE
 
-        case LSR_zpg_3:
-        case LSR_zpg_x_4:
+        CASE(LSR_zpg_3)
+        CASE(LSR_zpg_x_4)
             
             WRITE_TO_ZERO_PAGE
             setC(reg.d & 1); reg.d = reg.d >> 1;
             CONTINUE
             
-        case LSR_zpg_4:
-        case LSR_zpg_x_5:
+        CASE(LSR_zpg_4)
+        CASE(LSR_zpg_x_5)
             
             WRITE_TO_ZERO_PAGE_AND_SET_FLAGS
             POLL_INT
             DONE
             
-        case LSR_abs_4:
-        case LSR_abs_x_5:
-        case LSR_abs_y_5:
-        case LSR_ind_x_6:
-        case LSR_ind_y_6:
+        CASE(LSR_abs_4)
+        CASE(LSR_abs_x_5)
+        CASE(LSR_abs_y_5)
+        CASE(LSR_ind_x_6)
+        CASE(LSR_ind_y_6)
             
             WRITE_TO_ADDRESS
             setC(reg.d & 1); reg.d = reg.d >> 1;
             CONTINUE
             
-        case LSR_abs_5:
-        case LSR_abs_x_6:
-        case LSR_abs_y_6:
-        case LSR_ind_x_7:
-        case LSR_ind_y_7:
+        CASE(LSR_abs_5)
+        CASE(LSR_abs_x_6)
+        CASE(LSR_abs_y_6)
+        CASE(LSR_ind_x_7)
+        CASE(LSR_ind_y_7)
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             POLL_INT
@@ -1828,26 +1853,26 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              - - - - - -
 
-        case NOP:
+        CASE(NOP)
             
             IDLE_READ_IMPLIED
             POLL_INT
             DONE
 
-        case NOP_imm:
+        CASE(NOP_imm)
             
             IDLE_READ_IMMEDIATE
             POLL_INT
             DONE
 
-        case NOP_zpg_2:
-        case NOP_zpg_x_3:
+        CASE(NOP_zpg_2)
+        CASE(NOP_zpg_x_3)
             
             IDLE_READ_FROM_ZERO_PAGE
             POLL_INT
             DONE
             
-        case NOP_abs_x_3:
+        CASE(NOP_abs_x_3)
             
             IDLE_READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -1858,8 +1883,8 @@ Peddle::execute()
                 DONE
             }
             
-        case NOP_abs_3:
-        case NOP_abs_x_4:
+        CASE(NOP_abs_3)
+        CASE(NOP_abs_x_4)
             
             IDLE_READ_FROM_ADDRESS
             POLL_INT
@@ -1873,24 +1898,24 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / - - - -
 
-        case ORA_imm:
+        CASE(ORA_imm)
             
             READ_IMMEDIATE
             loadA(reg.a | reg.d);
             POLL_INT
             DONE
             
-        case ORA_zpg_2:
-        case ORA_zpg_x_3:
+        CASE(ORA_zpg_2)
+        CASE(ORA_zpg_x_3)
             
             READ_FROM_ZERO_PAGE
             loadA(reg.a | reg.d);
             POLL_INT
             DONE
 
-        case ORA_abs_x_3:
-        case ORA_abs_y_3:
-        case ORA_ind_y_4:
+        CASE(ORA_abs_x_3)
+        CASE(ORA_abs_y_3)
+        CASE(ORA_ind_y_4)
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -1902,11 +1927,11 @@ Peddle::execute()
                 DONE
             }
             
-        case ORA_abs_3:
-        case ORA_abs_x_4:
-        case ORA_abs_y_4:
-        case ORA_ind_x_5:
-        case ORA_ind_y_5:
+        CASE(ORA_abs_3)
+        CASE(ORA_abs_x_4)
+        CASE(ORA_abs_y_4)
+        CASE(ORA_ind_x_5)
+        CASE(ORA_ind_y_5)
             
             READ_FROM_ADDRESS
             loadA(reg.a | reg.d);
@@ -1921,7 +1946,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              - - - - - -
             
-        case PHA_2:
+        CASE(PHA_2)
             
             PUSH_A
             POLL_INT
@@ -1935,7 +1960,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              - - - - - -
             
-        case PHP_2:
+        CASE(PHP_2)
             
             PUSH_P
             POLL_INT
@@ -1949,12 +1974,12 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              - - - - - -
             
-        case PLA_2:
+        CASE(PLA_2)
             
             reg.sp++;
             CONTINUE
             
-        case PLA_3:
+        CASE(PLA_3)
             
             PULL_A
             POLL_INT
@@ -1968,13 +1993,13 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / / / / /
             
-        case PLP_2:
+        CASE(PLP_2)
 
             IDLE_PULL
             reg.sp++;
             CONTINUE
             
-        case PLP_3:
+        CASE(PLP_3)
 
             POLL_INT // Interrupts are polled before P is pulled
             PULL_P
@@ -1993,38 +2018,38 @@ Peddle::execute()
 #define DO_ROL_ACC { u8 c = !!getC(); setC(reg.a & 0x80); loadA((u8)(reg.a << 1 | c)); }
 #define DO_ROL { u8 c = !!getC(); setC(reg.d & 0x80); reg.d = (u8)(reg.d << 1 | c); }
 
-        case ROL_acc:
+        CASE(ROL_acc)
             
             IDLE_READ_IMPLIED
             DO_ROL_ACC
             POLL_INT
             DONE
             
-        case ROL_zpg_3:
-        case ROL_zpg_x_4:
+        CASE(ROL_zpg_3)
+        CASE(ROL_zpg_x_4)
             
             WRITE_TO_ZERO_PAGE
             DO_ROL
             CONTINUE
             
-        case ROL_zpg_4:
-        case ROL_zpg_x_5:
+        CASE(ROL_zpg_4)
+        CASE(ROL_zpg_x_5)
             
             WRITE_TO_ZERO_PAGE_AND_SET_FLAGS
             POLL_INT
             DONE
             
-        case ROL_abs_4:
-        case ROL_abs_x_5:
-        case ROL_ind_x_6:
+        CASE(ROL_abs_4)
+        CASE(ROL_abs_x_5)
+        CASE(ROL_ind_x_6)
             
             WRITE_TO_ADDRESS
             DO_ROL
             CONTINUE
             
-        case ROL_abs_5:
-        case ROL_abs_x_6:
-        case ROL_ind_x_7:
+        CASE(ROL_abs_5)
+        CASE(ROL_abs_x_6)
+        CASE(ROL_ind_x_7)
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             POLL_INT
@@ -2043,38 +2068,38 @@ Peddle::execute()
 #define DO_ROR_ACC { u8 c = !!getC(); setC(reg.a & 0x1); loadA((u8)(reg.a >> 1 | c << 7)); }
 #define DO_ROR { u8 c = !!getC(); setC(reg.d & 0x1); reg.d = (u8)(reg.d >> 1 | c << 7); }
             
-        case ROR_acc:
+        CASE(ROR_acc)
             
             IDLE_READ_IMPLIED
             DO_ROR_ACC
             POLL_INT
             DONE
             
-        case ROR_zpg_3:
-        case ROR_zpg_x_4:
+        CASE(ROR_zpg_3)
+        CASE(ROR_zpg_x_4)
             
             WRITE_TO_ZERO_PAGE
             DO_ROR
             CONTINUE
             
-        case ROR_zpg_4:
-        case ROR_zpg_x_5:
+        CASE(ROR_zpg_4)
+        CASE(ROR_zpg_x_5)
             
             WRITE_TO_ZERO_PAGE_AND_SET_FLAGS
             POLL_INT
             DONE
             
-        case ROR_abs_4:
-        case ROR_abs_x_5:
-        case ROR_ind_x_6:
+        CASE(ROR_abs_4)
+        CASE(ROR_abs_x_5)
+        CASE(ROR_ind_x_6)
             
             WRITE_TO_ADDRESS
             DO_ROR
             CONTINUE
             
-        case ROR_abs_5:
-        case ROR_abs_x_6:
-        case ROR_ind_x_7:
+        CASE(ROR_abs_5)
+        CASE(ROR_abs_x_6)
+        CASE(ROR_ind_x_7)
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             POLL_INT
@@ -2088,25 +2113,25 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / / / / /
             
-        case RTI_2:
+        CASE(RTI_2)
             
             IDLE_PULL
             reg.sp++;
             CONTINUE
             
-        case RTI_3:
+        CASE(RTI_3)
             
             PULL_P
             reg.sp++;
             CONTINUE
             
-        case RTI_4:
+        CASE(RTI_4)
             
             PULL_PCL
             reg.sp++;
             CONTINUE
             
-        case RTI_5:
+        CASE(RTI_5)
             
             PULL_PCH
             POLL_INT
@@ -2120,24 +2145,24 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              - - - - - -
             
-        case RTS_2:
+        CASE(RTS_2)
             
             IDLE_PULL
             reg.sp++;
             CONTINUE
             
-        case RTS_3:
+        CASE(RTS_3)
             
             PULL_PCL
             reg.sp++;
             CONTINUE
             
-        case RTS_4:
+        CASE(RTS_4)
             
             PULL_PCH
             CONTINUE
             
-        case RTS_5:
+        CASE(RTS_5)
             
             IDLE_READ_IMMEDIATE
             POLL_INT
@@ -2151,24 +2176,24 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / / - - /
 
-        case SBC_imm:
+        CASE(SBC_imm)
             
             READ_IMMEDIATE
             sbc(reg.d);
             POLL_INT
             DONE
             
-        case SBC_zpg_2:
-        case SBC_zpg_x_3:
+        CASE(SBC_zpg_2)
+        CASE(SBC_zpg_x_3)
             
             READ_FROM_ZERO_PAGE
             sbc(reg.d);
             POLL_INT
             DONE
             
-        case SBC_abs_x_3:
-        case SBC_abs_y_3:
-        case SBC_ind_y_4:
+        CASE(SBC_abs_x_3)
+        CASE(SBC_abs_y_3)
+        CASE(SBC_ind_y_4)
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -2180,11 +2205,11 @@ Peddle::execute()
                 DONE
             }
             
-        case SBC_abs_3:
-        case SBC_abs_x_4:
-        case SBC_abs_y_4:
-        case SBC_ind_x_5:
-        case SBC_ind_y_5:
+        CASE(SBC_abs_3)
+        CASE(SBC_abs_x_4)
+        CASE(SBC_abs_y_4)
+        CASE(SBC_ind_x_5)
+        CASE(SBC_ind_y_5)
             
             READ_FROM_ADDRESS
             sbc(reg.d);
@@ -2199,7 +2224,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              - - 1 - - -
 
-        case SEC:
+        CASE(SEC)
             
             IDLE_READ_IMPLIED
             setC(1);
@@ -2214,7 +2239,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              - - - - 1 -
 
-        case SED:
+        CASE(SED)
             
             IDLE_READ_IMPLIED
             setD(1);
@@ -2229,13 +2254,13 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              - - - 1 - -
 
-        case SEI:
+        CASE(SEI)
             
             POLL_IRQ
             setI(1);
             [[fallthrough]];
             
-        case SEI_cont:
+        CASE(SEI_cont)
             
             next = SEI_cont;
             IDLE_READ_IMPLIED
@@ -2250,25 +2275,25 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              - - - - - -
             
-        case STA_zpg_2:
-        case STA_zpg_x_3:
+        CASE(STA_zpg_2)
+        CASE(STA_zpg_x_3)
             
             reg.d = reg.a;
             WRITE_TO_ZERO_PAGE
             POLL_INT
             DONE
             
-        case STA_abs_3:
-        case STA_abs_x_4:
+        CASE(STA_abs_3)
+        CASE(STA_abs_x_4)
             
             reg.d = reg.a;
             WRITE_TO_ADDRESS
             POLL_INT
             DONE
             
-        case STA_abs_y_4:
-        case STA_ind_x_5:
-        case STA_ind_y_5:
+        CASE(STA_abs_y_4)
+        CASE(STA_ind_x_5)
+        CASE(STA_ind_y_5)
             
             reg.d = reg.a;
             WRITE_TO_ADDRESS
@@ -2283,15 +2308,15 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              - - - - - -
             
-        case STX_zpg_2:
-        case STX_zpg_y_3:
+        CASE(STX_zpg_2)
+        CASE(STX_zpg_y_3)
             
             reg.d = reg.x;
             WRITE_TO_ZERO_PAGE
             POLL_INT
             DONE
             
-        case STX_abs_3:
+        CASE(STX_abs_3)
             
             reg.d = reg.x;
             WRITE_TO_ADDRESS
@@ -2306,15 +2331,15 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              - - - - - -
             
-        case STY_zpg_2:
-        case STY_zpg_x_3:
+        CASE(STY_zpg_2)
+        CASE(STY_zpg_x_3)
             
             reg.d = reg.y;
             WRITE_TO_ZERO_PAGE
             POLL_INT
             DONE
             
-        case STY_abs_3:
+        CASE(STY_abs_3)
             
             reg.d = reg.y;
             WRITE_TO_ADDRESS
@@ -2329,7 +2354,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / - - - -
 
-        case TAX:
+        CASE(TAX)
             
             IDLE_READ_IMPLIED
             loadX(reg.a);
@@ -2344,7 +2369,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / - - - -
 
-        case TAY:
+        CASE(TAY)
             
             IDLE_READ_IMPLIED
             loadY(reg.a);
@@ -2359,7 +2384,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / - - - -
 
-        case TSX:
+        CASE(TSX)
             
             IDLE_READ_IMPLIED
             loadX(reg.sp);
@@ -2374,7 +2399,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / - - - -
 
-        case TXA:
+        CASE(TXA)
             
             IDLE_READ_IMPLIED
             loadA(reg.x);
@@ -2389,7 +2414,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              - - - - - -
 
-        case TXS:
+        CASE(TXS)
             
             IDLE_READ_IMPLIED
             reg.sp = reg.x;
@@ -2404,7 +2429,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / - - - -
 
-        case TYA:
+        CASE(TYA)
             
             IDLE_READ_IMPLIED
             loadA(reg.y);
@@ -2424,7 +2449,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / / - - -
 
-        case ALR_imm:
+        CASE(ALR_imm)
             
             READ_IMMEDIATE
             reg.a = reg.a & reg.d;
@@ -2441,7 +2466,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / / - - -
 
-        case ANC_imm:
+        CASE(ANC_imm)
             
             READ_IMMEDIATE
             loadA(reg.a & reg.d);
@@ -2457,7 +2482,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / / - - /
 
-        case ARR_imm:
+        CASE(ARR_imm)
         {
             READ_IMMEDIATE
             
@@ -2498,7 +2523,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / / - - -
 
-        case AXS_imm:
+        CASE(AXS_imm)
         {
             READ_IMMEDIATE
             
@@ -2519,36 +2544,36 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / / - - -
             
-        case DCP_zpg_3:
-        case DCP_zpg_x_4:
+        CASE(DCP_zpg_3)
+        CASE(DCP_zpg_x_4)
             
             WRITE_TO_ZERO_PAGE
             reg.d--;
             CONTINUE
             
-        case DCP_zpg_4:
-        case DCP_zpg_x_5:
+        CASE(DCP_zpg_4)
+        CASE(DCP_zpg_x_5)
             
             WRITE_TO_ZERO_PAGE_AND_SET_FLAGS
             cmp(reg.a, reg.d);
             POLL_INT
             DONE
             
-        case DCP_abs_4:
-        case DCP_abs_x_5:
-        case DCP_abs_y_5:
-        case DCP_ind_x_6:
-        case DCP_ind_y_6:
+        CASE(DCP_abs_4)
+        CASE(DCP_abs_x_5)
+        CASE(DCP_abs_y_5)
+        CASE(DCP_ind_x_6)
+        CASE(DCP_ind_y_6)
             
             WRITE_TO_ADDRESS
             reg.d--;
             CONTINUE
             
-        case DCP_abs_5:
-        case DCP_abs_x_6:
-        case DCP_abs_y_6:
-        case DCP_ind_x_7:
-        case DCP_ind_y_7:
+        CASE(DCP_abs_5)
+        CASE(DCP_abs_x_6)
+        CASE(DCP_abs_y_6)
+        CASE(DCP_ind_x_7)
+        CASE(DCP_ind_y_7)
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             cmp(reg.a, reg.d);
@@ -2563,36 +2588,36 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / / - - /
             
-        case ISC_zpg_3:
-        case ISC_zpg_x_4:
+        CASE(ISC_zpg_3)
+        CASE(ISC_zpg_x_4)
             
             WRITE_TO_ZERO_PAGE
             reg.d++;
             CONTINUE
             
-        case ISC_zpg_4:
-        case ISC_zpg_x_5:
+        CASE(ISC_zpg_4)
+        CASE(ISC_zpg_x_5)
             
             WRITE_TO_ZERO_PAGE_AND_SET_FLAGS
             sbc(reg.d);
             POLL_INT
             DONE
 
-        case ISC_abs_4:
-        case ISC_abs_x_5:
-        case ISC_abs_y_5:
-        case ISC_ind_x_6:
-        case ISC_ind_y_6:
+        CASE(ISC_abs_4)
+        CASE(ISC_abs_x_5)
+        CASE(ISC_abs_y_5)
+        CASE(ISC_ind_x_6)
+        CASE(ISC_ind_y_6)
             
             WRITE_TO_ADDRESS
             reg.d++;
             CONTINUE
             
-        case ISC_abs_5:
-        case ISC_abs_x_6:
-        case ISC_abs_y_6:
-        case ISC_ind_x_7:
-        case ISC_ind_y_7:
+        CASE(ISC_abs_5)
+        CASE(ISC_abs_x_6)
+        CASE(ISC_abs_y_6)
+        CASE(ISC_ind_x_7)
+        CASE(ISC_ind_y_7)
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             sbc(reg.d);
@@ -2607,7 +2632,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / - - - -
             
-        case LAS_abs_y_3:
+        CASE(LAS_abs_y_3)
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -2622,7 +2647,7 @@ Peddle::execute()
                 DONE
             }
             
-        case LAS_abs_y_4:
+        CASE(LAS_abs_y_4)
             
             READ_FROM_ADDRESS
             reg.d &= reg.sp;
@@ -2640,8 +2665,8 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / - - - -
             
-        case LAX_zpg_2:
-        case LAX_zpg_y_3:
+        CASE(LAX_zpg_2)
+        CASE(LAX_zpg_y_3)
             
             READ_FROM_ZERO_PAGE
             loadA(reg.d);
@@ -2649,8 +2674,8 @@ Peddle::execute()
             POLL_INT
             DONE
             
-        case LAX_abs_y_3:
-        case LAX_ind_y_4:
+        CASE(LAX_abs_y_3)
+        CASE(LAX_ind_y_4)
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -2663,10 +2688,10 @@ Peddle::execute()
                 DONE
             }
             
-        case LAX_abs_3:
-        case LAX_abs_y_4:
-        case LAX_ind_x_5:
-        case LAX_ind_y_5:
+        CASE(LAX_abs_3)
+        CASE(LAX_abs_y_4)
+        CASE(LAX_ind_x_5)
+        CASE(LAX_ind_y_5)
             
             READ_FROM_ADDRESS;
             loadA(reg.d);
@@ -2682,36 +2707,36 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / / - - -
             
-        case RLA_zpg_3:
-        case RLA_zpg_x_4:
+        CASE(RLA_zpg_3)
+        CASE(RLA_zpg_x_4)
             
             WRITE_TO_ZERO_PAGE
             DO_ROL
             CONTINUE
             
-        case RLA_zpg_4:
-        case RLA_zpg_x_5:
+        CASE(RLA_zpg_4)
+        CASE(RLA_zpg_x_5)
             
             WRITE_TO_ZERO_PAGE
             loadA(reg.a & reg.d);
             POLL_INT
             DONE
             
-        case RLA_abs_4:
-        case RLA_abs_x_5:
-        case RLA_abs_y_5:
-        case RLA_ind_x_6:
-        case RLA_ind_y_6:
+        CASE(RLA_abs_4)
+        CASE(RLA_abs_x_5)
+        CASE(RLA_abs_y_5)
+        CASE(RLA_ind_x_6)
+        CASE(RLA_ind_y_6)
             
             WRITE_TO_ADDRESS
             DO_ROL
             CONTINUE
             
-        case RLA_abs_5:
-        case RLA_abs_x_6:
-        case RLA_abs_y_6:
-        case RLA_ind_x_7:
-        case RLA_ind_y_7:
+        CASE(RLA_abs_5)
+        CASE(RLA_abs_x_6)
+        CASE(RLA_abs_y_6)
+        CASE(RLA_ind_x_7)
+        CASE(RLA_ind_y_7)
             
             WRITE_TO_ADDRESS
             loadA(reg.a & reg.d);
@@ -2725,36 +2750,36 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / / - - /
             
-        case RRA_zpg_3:
-        case RRA_zpg_x_4:
+        CASE(RRA_zpg_3)
+        CASE(RRA_zpg_x_4)
             
             WRITE_TO_ZERO_PAGE
             DO_ROR
             CONTINUE
             
-        case RRA_zpg_4:
-        case RRA_zpg_x_5:
+        CASE(RRA_zpg_4)
+        CASE(RRA_zpg_x_5)
             
             WRITE_TO_ZERO_PAGE
             adc(reg.d);
             POLL_INT
             DONE
 
-        case RRA_abs_4:
-        case RRA_abs_x_5:
-        case RRA_abs_y_5:
-        case RRA_ind_x_6:
-        case RRA_ind_y_6:
+        CASE(RRA_abs_4)
+        CASE(RRA_abs_x_5)
+        CASE(RRA_abs_y_5)
+        CASE(RRA_ind_x_6)
+        CASE(RRA_ind_y_6)
             
             WRITE_TO_ADDRESS
             DO_ROR
             CONTINUE
             
-        case RRA_abs_5:
-        case RRA_abs_x_6:
-        case RRA_abs_y_6:
-        case RRA_ind_x_7:
-        case RRA_ind_y_7:
+        CASE(RRA_abs_5)
+        CASE(RRA_abs_x_6)
+        CASE(RRA_abs_y_6)
+        CASE(RRA_ind_x_7)
+        CASE(RRA_ind_y_7)
             
             WRITE_TO_ADDRESS
             adc(reg.d);
@@ -2769,16 +2794,16 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              - - - - - -
             
-        case SAX_zpg_2:
-        case SAX_zpg_y_3:
+        CASE(SAX_zpg_2)
+        CASE(SAX_zpg_y_3)
             
             reg.d = reg.a & reg.x;
             WRITE_TO_ZERO_PAGE
             POLL_INT
             DONE
 
-        case SAX_abs_3:
-        case SAX_ind_x_5:
+        CASE(SAX_abs_3)
+        CASE(SAX_ind_x_5)
             
             reg.d = reg.a & reg.x;
             WRITE_TO_ADDRESS
@@ -2793,7 +2818,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              - - - - - -
             
-        case SHA_abs_y_3:
+        CASE(SHA_abs_y_3)
             
             IDLE_READ_FROM_ADDRESS
             
@@ -2816,13 +2841,13 @@ Peddle::execute()
             
             CONTINUE
             
-        case SHA_abs_y_4:
+        CASE(SHA_abs_y_4)
             
             WRITE_TO_ADDRESS
             POLL_INT
             DONE
             
-        case SHA_ind_y_4:
+        CASE(SHA_ind_y_4)
             
             IDLE_READ_FROM_ADDRESS
             
@@ -2845,7 +2870,7 @@ Peddle::execute()
 
             CONTINUE
             
-        case SHA_ind_y_5:
+        CASE(SHA_ind_y_5)
             
             WRITE_TO_ADDRESS
             POLL_INT
@@ -2859,7 +2884,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              - - - - - -
 
-        case SHX_abs_y_3:
+        CASE(SHX_abs_y_3)
             
             IDLE_READ_FROM_ADDRESS
             
@@ -2882,7 +2907,7 @@ Peddle::execute()
             
             CONTINUE
 
-        case SHX_abs_y_4:
+        CASE(SHX_abs_y_4)
             
             WRITE_TO_ADDRESS
             POLL_INT
@@ -2896,7 +2921,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              - - - - - -
             
-        case SHY_abs_x_3:
+        CASE(SHY_abs_x_3)
             
             IDLE_READ_FROM_ADDRESS
             
@@ -2919,7 +2944,7 @@ Peddle::execute()
 
             CONTINUE
             
-        case SHY_abs_x_4:
+        CASE(SHY_abs_x_4)
             
             WRITE_TO_ADDRESS
             POLL_INT
@@ -2935,36 +2960,36 @@ Peddle::execute()
 
 #define DO_SLO setC(reg.d & 128); reg.d <<= 1;
 
-        case SLO_zpg_3:
-        case SLO_zpg_x_4:
+        CASE(SLO_zpg_3)
+        CASE(SLO_zpg_x_4)
             
             WRITE_TO_ZERO_PAGE
             DO_SLO
             CONTINUE
             
-        case SLO_zpg_4:
-        case SLO_zpg_x_5:
+        CASE(SLO_zpg_4)
+        CASE(SLO_zpg_x_5)
             
             WRITE_TO_ZERO_PAGE
             loadA(reg.a | reg.d);
             POLL_INT
             DONE
             
-        case SLO_abs_4:
-        case SLO_abs_x_5:
-        case SLO_abs_y_5:
-        case SLO_ind_x_6:
-        case SLO_ind_y_6:
+        CASE(SLO_abs_4)
+        CASE(SLO_abs_x_5)
+        CASE(SLO_abs_y_5)
+        CASE(SLO_ind_x_6)
+        CASE(SLO_ind_y_6)
             
             WRITE_TO_ADDRESS
             DO_SLO
             CONTINUE
             
-        case SLO_abs_5:
-        case SLO_abs_x_6:
-        case SLO_abs_y_6:
-        case SLO_ind_x_7:
-        case SLO_ind_y_7:
+        CASE(SLO_abs_5)
+        CASE(SLO_abs_x_6)
+        CASE(SLO_abs_y_6)
+        CASE(SLO_ind_x_7)
+        CASE(SLO_ind_y_7)
             
             WRITE_TO_ADDRESS
             loadA(reg.a | reg.d);
@@ -2981,36 +3006,36 @@ Peddle::execute()
 
 #define DO_SRE setC(reg.d & 1); reg.d >>= 1;
 
-        case SRE_zpg_3:
-        case SRE_zpg_x_4:
+        CASE(SRE_zpg_3)
+        CASE(SRE_zpg_x_4)
             
             WRITE_TO_ZERO_PAGE
             DO_SRE
             CONTINUE
             
-        case SRE_zpg_4:
-        case SRE_zpg_x_5:
+        CASE(SRE_zpg_4)
+        CASE(SRE_zpg_x_5)
             
             WRITE_TO_ZERO_PAGE
             loadA(reg.a ^ reg.d);
             POLL_INT
             DONE
             
-        case SRE_abs_4:
-        case SRE_abs_x_5:
-        case SRE_abs_y_5:
-        case SRE_ind_x_6:
-        case SRE_ind_y_6:
+        CASE(SRE_abs_4)
+        CASE(SRE_abs_x_5)
+        CASE(SRE_abs_y_5)
+        CASE(SRE_ind_x_6)
+        CASE(SRE_ind_y_6)
             
             WRITE_TO_ADDRESS
             DO_SRE
             CONTINUE
             
-        case SRE_abs_5:
-        case SRE_abs_x_6:
-        case SRE_abs_y_6:
-        case SRE_ind_x_7:
-        case SRE_ind_y_7:
+        CASE(SRE_abs_5)
+        CASE(SRE_abs_x_6)
+        CASE(SRE_abs_y_6)
+        CASE(SRE_ind_x_7)
+        CASE(SRE_ind_y_7)
             
             WRITE_TO_ADDRESS
             loadA(reg.a ^ reg.d);
@@ -3025,7 +3050,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              - - - - - -
             
-        case TAS_abs_y_3:
+        CASE(TAS_abs_y_3)
             
             IDLE_READ_FROM_ADDRESS
             
@@ -3050,7 +3075,7 @@ Peddle::execute()
 
             CONTINUE
             
-        case TAS_abs_y_4:
+        CASE(TAS_abs_y_4)
             
             WRITE_TO_ADDRESS
             POLL_INT
@@ -3063,7 +3088,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / - - - -
 
-        case ANE_imm:
+        CASE(ANE_imm)
             
             READ_IMMEDIATE
             loadA(reg.x & reg.d & (reg.a | 0xEE));
@@ -3078,7 +3103,7 @@ Peddle::execute()
             // Flags:       N Z C I D V
             //              / / - - - -
 
-        case LXA_imm:
+        CASE(LXA_imm)
             
             READ_IMMEDIATE
             reg.x = reg.d & (reg.a | 0xEE);
@@ -3092,6 +3117,17 @@ Peddle::execute()
     }
 }
 
+template void Peddle::execute<MOS_6502, false>();
+template void Peddle::execute<MOS_6502, true>();
+template void Peddle::execute<MOS_6507, false>();
+template void Peddle::execute<MOS_6507, true>();
+template void Peddle::execute<MOS_6510, false>();
+template void Peddle::execute<MOS_6510, true>();
+template void Peddle::execute<MOS_6510, false, false>();
+template void Peddle::execute<MOS_6510, true, false>();
+template void Peddle::execute<MOS_8502, false>();
+template void Peddle::execute<MOS_8502, true>();
+
 void
 Peddle::execute(int count)
 {
@@ -3180,10 +3216,10 @@ Peddle::finishInstruction()
     while (!inFetchPhase()) execute<C>();
 }
 
-template <CPURevision C> void
+template <CPURevision C, bool D> void
 Peddle::done() {
 
-    if (flags) {
+    if (D && flags) {
 
         if (flags & CPU_LOG_INSTRUCTION) {
 
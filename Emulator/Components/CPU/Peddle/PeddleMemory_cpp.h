@@ -6,14 +6,14 @@
 // -----------------------------------------------------------------------------
 
 #define CHECK_WATCHPOINT \
-if constexpr (PEDDLE_ENABLE_WATCHPOINTS) { \
+if constexpr (D && PEDDLE_ENABLE_WATCHPOINTS) { \
 if ((flags & CPU_CHECK_WP) && debugger.watchpointMatches(addr)) { \
 watchpointReached(addr); \
 }}
 
 #if PEDDLE_SIMPLE_MEMORY_API == true
 
-template <CPURevision C> u8
+template <CPURevision C, bool D> u8
 Peddle::read(u16 addr)
 {
     CHECK_WATCHPOINT
@@ -25,7 +25,7 @@ Peddle::read(u16 addr)
     return read(addr & addrMask<C>());
 }
 
-template <CPURevision C> u8
+template <CPURevision C, bool D> u8
 Peddle::readZeroPage(u8 addr)
 {
     CHECK_WATCHPOINT
@@ -37,14 +37,14 @@ Peddle::readZeroPage(u8 addr)
     return read(addr & addrMask<C>());
 }
 
-template <CPURevision C> u8
+template <CPURevision C, bool D> u8
 Peddle::readStack(u8 addr)
 {
     CHECK_WATCHPOINT
     return read(u16(addr) + 0x100);
 }
 
-template <CPURevision C> void
+template <CPURevision C, bool D> void
 Peddle::readIdle(u16 addr)
 {
     if (PEDDLE_EMULATE_IDLE_ACCESSES) {
@@ -59,7 +59,7 @@ Peddle::readIdle(u16 addr)
     }
 }
 
-template <CPURevision C> void
+template <CPURevision C, bool D> void
 Peddle::readZeroPageIdle(u8 addr)
 {
     if (PEDDLE_EMULATE_IDLE_ACCESSES) {
@@ -74,7 +74,7 @@ Peddle::readZeroPageIdle(u8 addr)
     }
 }
 
-template <CPURevision C> void
+template <CPURevision C, bool D> void
 Peddle::readStackIdle(u8 addr)
 {
     if (PEDDLE_EMULATE_IDLE_ACCESSES) {
@@ -84,7 +84,7 @@ Peddle::readStackIdle(u8 addr)
     }
 }
 
-template <CPURevision C> void
+template <CPURevision C, bool D> void
 Peddle::write(u16 addr, u8 val)
 {
     CHECK_WATCHPOINT
@@ -96,7 +96,7 @@ Peddle::write(u16 addr, u8 val)
     write(addr & addrMask<C>(), val);
 }
 
-template <CPURevision C> void
+template <CPURevision C, bool D> void
 Peddle::writeZeroPage(u8 addr, u8 val)
 {
     CHECK_WATCHPOINT
@@ -108,7 +108,7 @@ Peddle::writeZeroPage(u8 addr, u8 val)
     write(u16(addr), val);
 }
 
-template <CPURevision C> void
+template <CPURevision C, bool D> void
 Peddle::writeStack(u8 addr, u8 val)
 {
     CHECK_WATCHPOINT
@@ -124,11 +124,29 @@ Emulator::revertToFactorySettings()
 }
 
 u32 *
-Emulator::getTexture() const
+Emulator::getTexture(i64 *nr) const
 {
     return main.config.runAhead && isRunning() ?
-    ahead.videoPort.getTexture() :
-    main.videoPort.getTexture();
+    ahead.videoPort.getTexture(nr) :
+    main.videoPort.getTexture(nr);
+}
+
+void
+Emulator::copyTexture(u32 *dst, i64 *nr) const
+{
+    if (main.config.runAhead && isRunning()) {
+        ahead.videoPort.copyFrontTexture(dst, nr);
+    } else {
+        main.videoPort.copyFrontTexture(dst, nr);
+    }
+}
+
+i64
+Emulator::getLatestFrame() const
+{
+    return main.config.runAhead && isRunning() ?
+    ahead.videoPort.getLatestFrame() :
+    main.videoPort.getLatestFrame();
 }
 
 u32 *
@@ -139,6 +157,13 @@ Emulator::getDmaTexture() const
     main.videoPort.getDmaTexture();
 }
 
+void
+Emulator::requestFrame()
+{
+    main.requestFrame();
+    ahead.requestFrame();
+}
+
 void
 Emulator::put(const Cmd &cmd)
 {
@@ -175,8 +175,13 @@ public:
     // Audio and Video
     //
 
-    u32 *getTexture() const;
+    u32 *getTexture(i64 *nr = nullptr) const;
+    void copyTexture(u32 *dst, i64 *nr = nullptr) const;
     u32 *getDmaTexture() const;
+    i64 getLatestFrame() const;
+
+    // Requests the next frame to be rendered if frames are skipped
+    void requestFrame();
 
 
     //
@@ -13,6 +13,7 @@
 #include "config.h"
 #include "Emulator.h"
 #include "Option.h"
+#include <iomanip>
 
 namespace vc64 {
 
@@ -74,6 +75,29 @@ Emulator::_dump(Category category, std::ostream& os) const
         os << bol(isTracking()) << std::endl;
         os << std::endl;
     }
+
+    if (category == Category::Stats) {
+
+        auto stats = getStats();
+        auto share = [&](double value) {
+            return stats.nsPerCycle > 0 ? 100.0 * value / stats.nsPerCycle : 0.0;
+        };
+
+        os << tab("Profiler");
+        os << bol(stats.profiling, "enabled", "disabled") << std::endl;
+        os << tab("Profiled cycles");
+        os << dec(stats.profiledCycles) << std::endl;
+        os << tab("Host time per cycle");
+        os << std::fixed << std::setprecision(2) << stats.nsPerCycle << " ns" << std::endl;
+        os << std::endl;
+
+        for (isize i = ProfilerSlotEnum::minVal; i <= ProfilerSlotEnum::maxVal; i++) {
+
+            os << tab(ProfilerSlotEnum::key(i));
+            os << std::fixed << std::setprecision(2) << stats.profile[i] << " ns  (";
+            os << std::setprecision(1) << share(stats.profile[i]) << "%)" << std::endl;
+        }
+    }
 }
 
 void
@@ -101,6 +125,21 @@ Emulator::cacheStats(EmulatorStats &result) const
         result.resyncs = resyncs;
     }
 
+    // Get the profiling data published by the emulator thread
+    C64::Profile profile;
+    result.profiling = main.getProfile(profile);
+
+    // Convert the collected time stamp counter ticks into nanoseconds
+    auto elapsed = (util::Time::now() - profile.startTime).asNanoseconds();
+    auto ticks = util::rdtsc() - profile.startTicks;
+    auto nsPerTick = ticks ? double(elapsed) / double(ticks) : 0.0;
+    auto cycles = profile.cycles ? double(profile.cycles) : 1.0;
+
+    result.profiledCycles = profile.cycles;
+    result.nsPerCycle = double(profile.total) * nsPerTick / cycles;
+    for (isize i = 0; i < PROF_COUNT; i++) {
+        result.profile[i] = double(profile.ticks[i]) * nsPerTick / cycles;
+    }
 }
 
 }
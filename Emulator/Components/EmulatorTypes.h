@@ -322,6 +322,12 @@ typedef struct
     double cpuLoad;         ///< Measured CPU load
     double fps;             ///< Measured frames per seconds
     isize resyncs;          ///< Number of out-of-sync conditions
+
+    // Execution profile (only recorded if the profiler is enabled)
+    bool profiling;                 ///< Indicates if the profiler is enabled
+    i64 profiledCycles;             ///< Number of profiled cycles
+    double nsPerCycle;              ///< Host time per emulated cycle (ns)
+    double profile[PROF_COUNT];     ///< Host time per emulated cycle per slot (ns)
 }
 EmulatorStats;
 
@@ -116,6 +116,14 @@ Memory::_didReset(bool hard)
             colorRam[i] = u8(seed);
         }
     }
+
+    updateAccessPointers();
+}
+
+void
+Memory::_didLoad()
+{
+    updateAccessPointers();
 }
 
 void 
@@ -224,6 +232,44 @@ Memory::updatePeekPokeLookupTables()
     
     // Call the Cartridge's delegation method
     expansionPort.updatePeekPokeLookupTables();
+
+    // Derive the direct access pointers
+    updateAccessPointers();
+}
+
+void
+Memory::updateAccessPointers()
+{
+    for (isize bank = 0; bank < 16; bank++) {
+
+        peekPtr[bank] = pokePtr[bank] = nullptr;
+
+        // Route all accesses through the slow path if the heatmap is enabled
+        if (config.heatmap) continue;
+
+        switch (peekSrc[bank]) {
+
+            case M_RAM:
+            case M_PP:      peekPtr[bank] = ram; break;
+            case M_BASIC:
+            case M_CHAR:
+            case M_KERNAL:  peekPtr[bank] = rom; break;
+
+            default:
+                break;
+        }
+        switch (pokeTarget[bank]) {
+
+            case M_RAM:
+            case M_PP:
+            case M_BASIC:
+            case M_CHAR:
+            case M_KERNAL:  pokePtr[bank] = ram; break;
+
+            default:
+                break;
+        }
+    }
 }
 
 u8
@@ -279,26 +325,6 @@ Memory::peek(u16 addr, bool gameLine, bool exromLine)
     return peek(addr, bankMap[index][addr >> 12]);
 }
 
-u8
-Memory::peekZP(u8 addr)
-{
-    if (config.heatmap) stats.reads[addr]++;
-
-    if (likely(addr >= 0x02)) {
-        return ram[addr];
-    } else {
-        return addr ? cpu.readPort() : cpu.readPortDir();
-    }
-}
-
-u8
-Memory::peekStack(u8 sp)
-{
-    if (config.heatmap) stats.reads[sp]++;
-
-    return ram[0x100 + sp];
-}
-
 u8
 Memory::peekIO(u16 addr)
 {
@@ -505,28 +531,6 @@ Memory::poke(u16 addr, u8 value, bool gameLine, bool exromLine)
     poke(addr, value, bankMap[index][addr >> 12]);
 }
 
-void
-Memory::pokeZP(u8 addr, u8 value)
-{
-    if (config.heatmap) stats.writes[addr]++;
-
-    if (likely(addr >= 0x02)) {
-        ram[addr] = value;
-    } else if (addr == 0x00) {
-        cpu.writePortDir(value);
-    } else {
-        cpu.writePort(value);
-    }
-}
-
-void
-Memory::pokeStack(u8 sp, u8 value)
-{
-    if (config.heatmap) stats.writes[sp]++;
-
-    ram[0x100 + sp] = value;
-}
-
 void
 Memory::pokeIO(u16 addr, u8 value)
 {
@@ -79,6 +79,18 @@ public:
     // Poke target lookup table
     MemoryType pokeTarget[16];
 
+    /* Direct access lookup tables
+     *
+     * These tables are derived from peekSrc and pokeTarget. For each bank
+     * mapped to RAM or Rom, they store a pointer to the backing array which
+     * is indexed with the full address. All other banks (I/O, cartridge,
+     * unmapped) store a nullptr, meaning that the access takes the slow path.
+     * If the heatmap is enabled, all entries are nullptr to route all accesses
+     * through the slow path where the access counters are updated.
+     */
+    u8 *peekPtr[16] = { };
+    u8 *pokePtr[16] = { };
+
     // Indicates if watchpoints should be checked
     bool checkWatchpoints = false;
 
@@ -105,6 +117,7 @@ public:
 
         CLONE(config)
 
+        updateAccessPointers();
         return *this;
     }
 
@@ -156,6 +169,7 @@ private:
 
     void _dump(Category category, std::ostream& os) const override;
     void _didReset(bool hard) override;
+    void _didLoad() override;
 
 
     //
@@ -194,6 +208,9 @@ public:
      */
     void updatePeekPokeLookupTables();
 
+    // Updates the direct access lookup tables
+    void updateAccessPointers();
+
     // Returns the current peek source of the specified memory address
     MemoryType getPeekSource(u16 addr) { return peekSrc[addr >> 12]; }
 
@@ -203,9 +220,12 @@ public:
     // Reads a value from memory
     u8 peek(u16 addr, MemoryType source);
     u8 peek(u16 addr, bool gameLine, bool exromLine);
-    u8 peek(u16 addr) { return peek(addr, peekSrc[addr >> 12]); }
-    u8 peekZP(u8 addr);
-    u8 peekStack(u8 sp);
+    u8 peek(u16 addr) {
+        auto *ptr = peekPtr[addr >> 12];
+        return likely(ptr && addr > 1) ? ptr[addr] : peek(addr, peekSrc[addr >> 12]);
+    }
+    u8 peekZP(u8 addr) { return peek(u16(addr)); }
+    u8 peekStack(u8 sp) { return peek(u16(0x100 + sp)); }
     u8 peekIO(u16 addr);
 
     // Reads a value from memory and discards the result (idle access)
@@ -223,9 +243,12 @@ public:
     // Writing a value into memory
     void poke(u16 addr, u8 value, MemoryType target);
     void poke(u16 addr, u8 value, bool gameLine, bool exromLine);
-    void poke(u16 addr, u8 value) { poke(addr, value, pokeTarget[addr >> 12]); }
-    void pokeZP(u8 addr, u8 value);
-    void pokeStack(u8 sp, u8 value);
+    void poke(u16 addr, u8 value) {
+        auto *ptr = pokePtr[addr >> 12];
+        if (likely(ptr && addr > 1)) { ptr[addr] = value; } else { poke(addr, value, pokeTarget[addr >> 12]); }
+    }
+    void pokeZP(u8 addr, u8 value) { poke(u16(addr), value); }
+    void pokeStack(u8 sp, u8 value) { poke(u16(0x100 + sp), value); }
     void pokeIO(u16 addr, u8 value);
 
     // Reads a vector address from memory
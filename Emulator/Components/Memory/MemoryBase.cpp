@@ -125,6 +125,7 @@ Memory::setOption(Option opt, i64 value)
         case OPT_MEM_HEATMAP:
 
             config.heatmap = (bool)value;
+            updateAccessPointers();
             return;
 
         case OPT_MEM_SAVE_ROMS:
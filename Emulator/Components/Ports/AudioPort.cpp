@@ -13,13 +13,130 @@
 #include "config.h"
 #include "SIDBridge.h"
 #include "Emulator.h"
+#include <cmath>
+#include <thread>
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
 
 namespace vc64 {
 
+// Number of samples the mixer processes in a single block
+static constexpr isize mixBlockSize = 256;
+
+// Copies n samples out of a SID stream (missing samples are filled with zeroes)
+static void
+fetch(SampleStream &stream, short *dst, isize n)
+{
+    auto cnt = std::min(n, stream.count());
+    auto len = std::min(cnt, stream.cap() - stream.begin());
+
+    std::memcpy(dst, stream.elements + stream.begin(), len * sizeof(short));
+    std::memcpy(dst + len, stream.elements, (cnt - len) * sizeof(short));
+    std::memset(dst + cnt, 0, (n - cnt) * sizeof(short));
+    stream.skip(cnt);
+}
+
+/* Mixes a block of samples from N SIDs into stereo sample pairs. The master
+ * volumes are passed in per sample if the volume is fading and as a single
+ * value otherwise. The vectorized routine (V = true) processes four samples
+ * at a time with the same sequence of floating point operations as the
+ * scalar routine. Hence, both routines produce identical results.
+ */
+template <isize N, bool fading, bool V> static void
+mixBlock(SamplePair *dst, const short (*src)[mixBlockSize],
+         const float *vol, const float *panL, const float *panR,
+         const float *volL, const float *volR, isize n)
+{
+    isize i = 0;
+
+    if constexpr (V) {
+
+#if defined(__aarch64__)
+
+        for (; i + 4 <= n; i += 4) {
+
+            float32x4x2_t lr = { vdupq_n_f32(0), vdupq_n_f32(0) };
+
+            for (isize k = 0; k < N; k++) {
+
+                auto ch = vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vld1_s16(src[k] + i))), vol[k]);
+                lr.val[0] = k ? vaddq_f32(lr.val[0], vmulq_n_f32(ch, panL[k])) : vmulq_n_f32(ch, panL[k]);
+                lr.val[1] = k ? vaddq_f32(lr.val[1], vmulq_n_f32(ch, panR[k])) : vmulq_n_f32(ch, panR[k]);
+            }
+
+            lr.val[0] = vmulq_f32(lr.val[0], fading ? vld1q_f32(volL + i) : vdupq_n_f32(*volL));
+            lr.val[1] = vmulq_f32(lr.val[1], fading ? vld1q_f32(volR + i) : vdupq_n_f32(*volR));
+
+            vst2q_f32((float *)(dst + i), lr);
+        }
+
+#elif defined(__SSE2__) || defined(_M_X64)
+
+        for (; i + 4 <= n; i += 4) {
+
+            __m128 l = _mm_setzero_ps(), r = _mm_setzero_ps();
+
+            for (isize k = 0; k < N; k++) {
+
+                auto s = _mm_loadl_epi64((const __m128i *)(src[k] + i));
+                auto ch = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16)), _mm_set1_ps(vol[k]));
+                l = k ? _mm_add_ps(l, _mm_mul_ps(ch, _mm_set1_ps(panL[k]))) : _mm_mul_ps(ch, _mm_set1_ps(panL[k]));
+                r = k ? _mm_add_ps(r, _mm_mul_ps(ch, _mm_set1_ps(panR[k]))) : _mm_mul_ps(ch, _mm_set1_ps(panR[k]));
+            }
+
+            l = _mm_mul_ps(l, fading ? _mm_loadu_ps(volL + i) : _mm_set1_ps(*volL));
+            r = _mm_mul_ps(r, fading ? _mm_loadu_ps(volR + i) : _mm_set1_ps(*volR));
+
+            _mm_storeu_ps((float *)(dst + i), _mm_unpacklo_ps(l, r));
+            _mm_storeu_ps((float *)(dst + i) + 4, _mm_unpackhi_ps(l, r));
+        }
+
+#endif
+    }
+
+    // Process all remaining samples one by one
+    for (; i < n; i++) {
+
+        // Compute left and right channel output
+        float ch = (float)src[0][i] * vol[0];
+        float l = ch * panL[0];
+        float r = ch * panR[0];
+
+        for (isize k = 1; k < N; k++) {
+
+            ch = (float)src[k][i] * vol[k];
+            l += ch * panL[k];
+            r += ch * panR[k];
+        }
+
+        // Apply master volume
+        l *= fading ? volL[i] : *volL;
+        r *= fading ? volR[i] : *volR;
+
+        // Prevent hearing loss
+        assert(std::abs(l) < 1.0);
+        assert(std::abs(r) < 1.0);
+
+        dst[i] = SamplePair { l, r };
+    }
+}
+
 void
 AudioPort::alignWritePtr()
 {
-    this->align(this->cap() / 2);
+    static const SamplePair silence[512] = { };
+
+    // Pad the buffer with zeroes until the alignment level is reached
+    for (isize missing = alignedCount - count(); missing > 0;) {
+
+        auto written = tryWrite(silence, std::min(missing, isize(512)));
+        if (!written) break;
+        missing -= written;
+    }
 }
 
 void
@@ -30,27 +147,10 @@ AudioPort::handleBufferUnderflow()
     // (1) The consumer runs slightly faster than the producer.
     // (2) The producer is halted or not startet yet.
 
-    trace(AUDBUF_DEBUG, "BUFFER UNDERFLOW (r: %ld w: %ld)\n", r, w);
-
-    // Wipe out the buffer and reset the write pointer
-    clear(SamplePair{0,0});
-    alignWritePtr();
-
-    // Determine the elapsed seconds since the last pointer adjustment
-    auto elapsedTime = util::Time::now() - lastAlignment;
-    lastAlignment = util::Time::now();
+    trace(AUDBUF_DEBUG, "BUFFER UNDERFLOW (r: %ld w: %ld)\n", r.load(), w.load());
 
-    // Check for condition (1)
-    if (elapsedTime.asSeconds() > 10.0) {
-
-        /*
-        // Increase the sample rate based on what we've measured
-        sampleRateCorrection += count() / elapsedTime.asSeconds();
-         */
-        stats.bufferUnderflows++;
-        warn("Last underflow: %f seconds ago\n", elapsedTime.asSeconds());
-        // warn("New sample rate correction: %f\n", sampleRateCorrection);
-    }
+    // Ask the producer to realign the write pointer
+    if (!padRequest.exchange(true)) underflows++;
 }
 
 void
@@ -61,40 +161,23 @@ AudioPort::handleBufferOverflow()
     // (1) The consumer runs slightly slower than the producer
     // (2) The consumer is halted or not startet yet
 
-    trace(AUDBUF_DEBUG, "BUFFER OVERFLOW (r: %ld w: %ld)\n", r, w);
-
-    // Reset the write pointer
-    alignWritePtr();
+    trace(AUDBUF_DEBUG, "BUFFER OVERFLOW (r: %ld w: %ld)\n", r.load(), w.load());
 
-    // Determine the number of elapsed seconds since the last adjustment
-    auto elapsedTime = util::Time::now() - lastAlignment;
-    lastAlignment = util::Time::now();
-
-    // Adjust the sample rate, if condition (1) holds
-    if (elapsedTime.asSeconds() > 10.0) {
-
-        /*
-        // Decrease the sample rate based on what we've measured
-        sampleRateCorrection -= count() / elapsedTime.asSeconds();
-         */
-        stats.bufferOverflows++;
-        warn("Last overflow: %f seconds ago\n", elapsedTime.asSeconds());
-        // warn("New sample rate correction: %f\n", sampleRateCorrection);
-    }
+    // Ask the consumer to drop the oldest samples
+    if (trimRequest.exchange(alignedCount) < 0) overflows++;
 }
 
 void 
 AudioPort::clamp(isize maxSamples)
 {
-    SYNCHRONIZED
-
-    while (count() > maxSamples) read();
+    if (auto surplus = count() - maxSamples; surplus > 0) skip(surplus);
 }
 
 void
 AudioPort::generateSamples()
 {
-    SYNCHRONIZED
+    // Serve a pending realignment request
+    if (padRequest.exchange(false)) alignWritePtr();
 
     // Check how many samples can be generated
     auto s0 = sid0.stream.count();
@@ -107,6 +190,11 @@ AudioPort::generateSamples()
     if (s2) numSamples = std::min(numSamples, s2);
     if (s3) numSamples = std::min(numSamples, s3);
 
+    // Determine the resampling step
+    updateSampleRateCorrection();
+    auto rate = sid0.getSampleRate();
+    resampleStep = rate / (rate + sampleRateCorrection);
+
     // Generate the samples
     bool fading = volL.isFading() || volR.isFading();
 
@@ -115,39 +203,96 @@ AudioPort::generateSamples()
     } else {
         fading ? mixSingleSID<true>(numSamples) : mixSingleSID<false>(numSamples);
     }
+
+    // Hand the new samples over to the consumer
+    flush();
 }
 
 void
-AudioPort::fadeOut()
+AudioPort::updateSampleRateCorrection()
 {
-    SYNCHRONIZED
+    // Only adjust the rate while the host callback consumes samples
+    auto counter = r.load(std::memory_order_relaxed);
+    auto consuming = counter != lastReadCounter && !takeover.load() && !emulator.isWarping();
+    lastReadCounter = counter;
+
+    if (!consuming) { sampleRateCorrection = 0.0; return; }
+
+    // Produce more samples if the buffer runs low and less if it fills up
+    auto deviation = double(alignedCount - count()) / double(alignedCount);
+    auto target = std::clamp(deviation, -1.0, 1.0) * maxCorrection * sid0.getSampleRate();
+
+    // Approach the target smoothly to avoid audible pitch jumps
+    sampleRateCorrection += (target - sampleRateCorrection) / 16.0;
+
+    trace(AUDBUF_DEBUG, "Fill level: %ld Correction: %f Hz\n", count(), sampleRateCorrection);
+}
 
+void
+AudioPort::fadeOut()
+{
     debug(AUDVOL_DEBUG, "Fading out (%ld samples)...\n", count());
 
     volL.set(0.0);
     volR.set(0.0);
 
-    float scale = 1.0f;
-    float delta = 1.0f / count();
+    // Ask the consumer to rescale all samples that have been produced so far
+    flush();
+    fadeRequest.store(w.load(std::memory_order_relaxed), std::memory_order_release);
+}
 
-    // Rescale the existing samples
-    for (isize i = begin(); i != end(); i = next(i)) {
+void
+AudioPort::put(const SamplePair &pair)
+{
+    auto emit = [&](const SamplePair &sample) {
 
-        scale -= delta;
-        assert(scale >= -0.1 && scale < 1.0);
+        block[blockCount++] = sample;
+        if (blockCount == isize(std::size(block))) flush();
+    };
 
-        elements[i].l *= scale;
-        elements[i].r *= scale;
-    }
+    if (resampleStep == 1.0) {
+
+        // Fast path: No sample rate correction
+        emit(pair);
+
+    } else {
+
+        auto &[xm1, x0, x1] = resampleHist;
 
-    // Wipe out the rest of the buffer
-    for (isize i = end(); i != begin(); i = next(i)) {
+        // Interpolates between x0 and x1 (Catmull-Rom spline)
+        auto hermite = [](float ym1, float y0, float y1, float y2, float t) {
 
-        elements[i] = SamplePair { 0, 0 };
+            auto c1 = 0.5f * (y1 - ym1);
+            auto c2 = ym1 - 2.5f * y0 + 2.0f * y1 - 0.5f * y2;
+            auto c3 = 0.5f * (y2 - ym1) + 1.5f * (y0 - y1);
+            return ((c3 * t + c2) * t + c1) * t + y0;
+        };
+
+        // Emit all output samples located between x0 and x1
+        for (; resamplePhase < 1.0; resamplePhase += resampleStep) {
+
+            auto t = float(resamplePhase);
+            emit(SamplePair {
+                hermite(xm1.l, x0.l, x1.l, pair.l, t),
+                hermite(xm1.r, x0.r, x1.r, pair.r, t) });
+        }
+        resamplePhase -= 1.0;
     }
+
+    resampleHist[0] = resampleHist[1];
+    resampleHist[1] = resampleHist[2];
+    resampleHist[2] = pair;
+}
+
+void
+AudioPort::flush()
+{
+    // Samples that don't fit into the buffer are dropped
+    tryWrite(block, blockCount);
+    blockCount = 0;
 }
 
-template <bool fading> void
+template <bool fading, bool V> void
 AudioPort::mixSingleSID(isize numSamples)
 {
     auto vol0 = vol[0];
@@ -159,7 +304,7 @@ AudioPort::mixSingleSID(isize numSamples)
     debug(SID_EXEC, "volL: %f volR: %f vol0: %f pan0: %f\n", curL, curR, vol0, pan0);
 
     // Check for buffer overflow
-    if (free() < numSamples) handleBufferOverflow();
+    if (free() < isize(std::ceil(numSamples / resampleStep))) handleBufferOverflow();
 
     if constexpr (fading == false) {
 
@@ -167,7 +312,7 @@ AudioPort::mixSingleSID(isize numSamples)
 
             // Fast path: All samples are zero
             for (isize i = 0; i < numSamples; i++) (void)sid0.stream.read();
-            for (isize i = 0; i < numSamples; i++) write(SamplePair { 0, 0 } );
+            for (isize i = 0; i < numSamples; i++) put(SamplePair { 0, 0 } );
 
             // Send a MUTE message if applicable
             if (!muted) { muted = true; msgQueue.put(MSG_MUTE, true); }
@@ -176,41 +321,19 @@ AudioPort::mixSingleSID(isize numSamples)
     }
 
     // Slow path: There is something to hear
-    for (isize i = 0; i < numSamples; i++) {
-
-        // Read SID sample from ring buffer
-        float ch0 = (float)sidBridge.sid0.stream.read() * vol0;
-
-        // Compute left and right channel output
-        float l = ch0 * (1 - pan0);
-        float r = ch0 * pan0;
-
-        // Modulate the master volume
-        if constexpr (fading) { volL.shift(); curL = volL.current; }
-        if constexpr (fading) { volR.shift(); curR = volR.current; }
-
-        // Apply master volume
-        l *= curL;
-        r *= curR;
-
-        // Prevent hearing loss
-        assert(std::abs(l) < 1.0);
-        assert(std::abs(r) < 1.0);
-
-        write(SamplePair { l, r } );
-    }
+    mix<1, fading, V>(numSamples);
 
     // Send a MUTE message if applicable
     if (muted) { muted = false; msgQueue.put(MSG_MUTE, false); }
 }
 
-template <bool fading> void
+template <bool fading, bool V> void
 AudioPort::mixMultiSID(isize numSamples)
 {
-    auto vol0 = vol[0]; auto pan0 = pan[0];
-    auto vol1 = vol[1]; auto pan1 = pan[1];
-    auto vol2 = vol[2]; auto pan2 = pan[2];
-    auto vol3 = vol[3]; auto pan3 = pan[3];
+    auto vol0 = vol[0];
+    auto vol1 = vol[1];
+    auto vol2 = vol[2];
+    auto vol3 = vol[3];
     auto curL = volL.current;
     auto curR = volR.current;
 
@@ -219,7 +342,7 @@ AudioPort::mixMultiSID(isize numSamples)
     debug(SID_EXEC, "vol0: %f vol1: %f vol2: %f vol3: %f\n", vol0, vol1, vol2, vol3);
 
     // Check for buffer overflow
-    if (free() < numSamples) handleBufferOverflow();
+    if (free() < isize(std::ceil(numSamples / resampleStep))) handleBufferOverflow();
 
     if constexpr (fading == false) {
 
@@ -230,7 +353,7 @@ AudioPort::mixMultiSID(isize numSamples)
             for (isize i = 0; i < numSamples; i++) (void)sid1.stream.read(0);
             for (isize i = 0; i < numSamples; i++) (void)sid2.stream.read(0);
             for (isize i = 0; i < numSamples; i++) (void)sid3.stream.read(0);
-            for (isize i = 0; i < numSamples; i++) write(SamplePair { 0, 0 } );
+            for (isize i = 0; i < numSamples; i++) put(SamplePair { 0, 0 } );
 
             // Send a MUTE message if applicable
             if (!muted) { muted = true; msgQueue.put(MSG_MUTE, true); }
@@ -239,170 +362,272 @@ AudioPort::mixMultiSID(isize numSamples)
     }
 
     // Slow path: There is something to hear
-    for (isize i = 0; i < numSamples; i++) {
+    mix<4, fading, V>(numSamples);
 
-        float ch0, ch1, ch2, ch3, l, r;
+    // Send a MUTE message if applicable
+    if (muted) { muted = false; msgQueue.put(MSG_MUTE, false); }
+}
 
-        ch0 = (float)sid0.stream.read()  * vol0;
-        ch1 = (float)sid1.stream.read(0) * vol1;
-        ch2 = (float)sid2.stream.read(0) * vol2;
-        ch3 = (float)sid3.stream.read(0) * vol3;
+template <isize N, bool fading, bool V> void
+AudioPort::mix(isize numSamples)
+{
+    SampleStream *streams[4] = { &sid0.stream, &sid1.stream, &sid2.stream, &sid3.stream };
 
-        // Compute left and right channel output
-        l = ch0 * (1 - pan0) + ch1 * (1 - pan1) + ch2 * (1 - pan2) + ch3 * (1 - pan3);
-        r = ch0 * pan0 + ch1 * pan1 + ch2 * pan2 + ch3 * pan3;
+    // Collect the channel parameters
+    float chVol[N], chPanL[N], chPanR[N];
+    for (isize k = 0; k < N; k++) {
+
+        chVol[k] = vol[k];
+        chPanL[k] = 1 - pan[k];
+        chPanR[k] = pan[k];
+    }
+
+    short src[N][mixBlockSize];
+    float curL[mixBlockSize];
+    float curR[mixBlockSize];
+    SamplePair dst[mixBlockSize];
+
+    for (isize i = 0; i < numSamples; i += mixBlockSize) {
+
+        auto n = std::min(numSamples - i, mixBlockSize);
+
+        // Read the next block of SID samples
+        for (isize k = 0; k < N; k++) fetch(*streams[k], src[k], n);
 
         // Modulate the master volume
-        if constexpr (fading) { volL.shift(); curL = volL.current; }
-        if constexpr (fading) { volR.shift(); curR = volR.current; }
+        if constexpr (fading) {
 
-        // Apply master volume
-        l *= curL;
-        r *= curR;
+            volL.shift(curL, n);
+            volR.shift(curR, n);
 
-        // Prevent hearing loss
-        assert(abs(l) < 1.0);
-        assert(abs(r) < 1.0);
+        } else {
+
+            curL[0] = volL.current;
+            curR[0] = volR.current;
+        }
+
+        mixBlock<N, fading, V>(dst, src, chVol, chPanL, chPanR, curL, curR, n);
+
+        // Write the mixed samples into the ring buffer
+        if (resampleStep == 1.0) {
 
-        write(SamplePair { l, r } );
+            assert(blockCount == 0);
+            tryWrite(dst, n);
+
+            // Keep the resampler history in sync with the bypassed samples
+            for (isize j = std::max(n - 3, isize(0)); j < n; j++) {
+
+                resampleHist[0] = resampleHist[1];
+                resampleHist[1] = resampleHist[2];
+                resampleHist[2] = dst[j];
+            }
+            resamplePhase = 0.0;
+
+        } else {
+
+            for (isize j = 0; j < n; j++) put(dst[j]);
+        }
     }
+}
 
-    // Send a MUTE message if applicable
-    if (muted) { muted = false; msgQueue.put(MSG_MUTE, false); }
+template void AudioPort::mixSingleSID<false, false>(isize numSamples);
+template void AudioPort::mixSingleSID<false, true>(isize numSamples);
+template void AudioPort::mixSingleSID<true, false>(isize numSamples);
+template void AudioPort::mixSingleSID<true, true>(isize numSamples);
+template void AudioPort::mixMultiSID<false, false>(isize numSamples);
+template void AudioPort::mixMultiSID<false, true>(isize numSamples);
+template void AudioPort::mixMultiSID<true, false>(isize numSamples);
+template void AudioPort::mixMultiSID<true, true>(isize numSamples);
+
+void
+AudioPort::acquireConsumer()
+{
+    assert(!takeover);
+
+    // File the request and wait until the host callback has left the buffer
+    takeover.store(true);
+    while (copying.load()) std::this_thread::yield();
 }
 
-isize
-AudioPort::copyMono(float *buffer, isize n)
+void
+AudioPort::releaseConsumer()
 {
-    {   SYNCHRONIZED
+    takeover.store(false);
+}
 
-        // Be silent when the recorder is running (fill with zeroes)
-        if (recorder.isRecording()) {
+bool
+AudioPort::beginHostCopy()
+{
+    copying.store(true);
+    if (!takeover.load()) return true;
 
-            for (isize i = 0; i < n; i++) { *buffer++ = 0; }
-            return 0;
-        }
+    // Back off, the consumer role has been taken over
+    copying.store(false);
+    return false;
+}
 
-        // Check for buffer underflows
-        if (auto cnt = count(); cnt < n) {
+void
+AudioPort::endHostCopy()
+{
+    copying.store(false);
+}
 
-            // Copy all we have and stepwise lower the volume to minimize cracks
-            for (isize i = 0; i < cnt; i++) {
+isize
+AudioPort::beginCopy(isize n)
+{
+    // Serve a pending trim request
+    if (auto maxSamples = trimRequest.exchange(-1); maxSamples >= 0) clamp(maxSamples);
 
-                SamplePair pair = read();
-                *buffer++ = (pair.l + pair.r) * float(cnt - i) / float(cnt);
-            }
-            assert(isEmpty());
+    copyStart = r.load(std::memory_order_relaxed);
 
-            // Fill the rest with zeroes
-            for (isize i = cnt; i < n; i++) *buffer++ = 0;
+    // Serve a pending fade request
+    if (auto stop = fadeRequest.load(std::memory_order_acquire); stop != fadeStop) {
 
-            // Realign the ring buffer
-            handleBufferUnderflow();
+        fadeStart = copyStart;
+        fadeStop = stop;
+    }
 
-            return cnt;
-        }
+    // Record the fill level
+    auto cnt = count();
+    if (cnt < minCount) minCount = cnt;
+    if (cnt > maxCount) maxCount = cnt;
 
-        // The standard case: We have enough samples. Copy the requested number
-        for (isize i = 0; i < n; i++) {
+    return std::min(cnt, n);
+}
 
-            SamplePair pair = read();
-            *buffer++ = pair.l + pair.r;
-        }
+float
+AudioPort::gain(isize i, isize cnt, isize n) const
+{
+    float result = 1.0f;
 
-        return n;
+    // Fade out the samples that have been produced before the emulator paused
+    if (auto counter = copyStart + i; counter < fadeStop) {
+        result = float(fadeStop - counter) / float(fadeStop - fadeStart);
     }
+
+    // On a buffer underflow, stepwise lower the volume to minimize cracks
+    if (cnt < n) result *= float(cnt - i) / float(cnt);
+
+    return result;
 }
 
 isize
-AudioPort::copyStereo(float *left, float *right, isize n)
+AudioPort::copyMono(float *buffer, isize n)
 {
-    {   SYNCHRONIZED
+    // Be silent when the recorder is running (fill with zeroes)
+    if (!beginHostCopy()) {
 
-        // Be silent when the recorder is running (fill with zeroes)
-        if (recorder.isRecording()) {
+        for (isize i = 0; i < n; i++) { *buffer++ = 0; }
+        return 0;
+    }
 
-            for (isize i = 0; i < n; i++) { *left++ = *right++ = 0; }
-            return 0;
-        }
+    // Copy all we have, but not more than requested
+    auto cnt = beginCopy(n);
+    bool ramp = cnt < n || copyStart < fadeStop;
 
-        // Check for buffer underflows
-        if (auto cnt = count(); cnt < n) {
+    for (isize i = 0; i < cnt; i++) {
 
-            // Copy all we have and stepwise lower the volume to minimize cracks
-            for (isize i = 0; i < cnt; i++) {
+        auto &pair = elements[index(copyStart + i)];
+        *buffer++ = ramp ? (pair.l + pair.r) * gain(i, cnt, n) : pair.l + pair.r;
+    }
+    skip(cnt);
 
-                SamplePair pair = read();
-                *left++ = pair.l * float(cnt - i) / float(cnt);
-                *right++ = pair.r * float(cnt - i) / float(cnt);
-            }
-            assert(isEmpty());
+    // Check for buffer underflows
+    if (cnt < n) {
 
-            // Fill the rest with zeroes
-            for (isize i = cnt; i < n; i++) *left++ = *right++ = 0;
+        // Fill the rest with zeroes
+        for (isize i = cnt; i < n; i++) *buffer++ = 0;
 
-            // Realign the ring buffer
-            handleBufferUnderflow();
+        // Realign the ring buffer
+        handleBufferUnderflow();
+    }
 
-            return cnt;
-        }
+    endHostCopy();
+    return cnt;
+}
 
-        // The standard case: We have enough samples. Copy the requested number
-        for (isize i = 0; i < n; i++) {
+isize
+AudioPort::copyStereo(float *left, float *right, isize n)
+{
+    // Be silent when the recorder is running (fill with zeroes)
+    if (!beginHostCopy()) {
 
-            SamplePair pair = read();
-            *left++ = pair.l;
-            *right++ = pair.r;
-        }
+        for (isize i = 0; i < n; i++) { *left++ = *right++ = 0; }
+        return 0;
+    }
+
+    // Copy all we have, but not more than requested
+    auto cnt = beginCopy(n);
+    bool ramp = cnt < n || copyStart < fadeStop;
 
-        return n;
+    for (isize i = 0; i < cnt; i++) {
+
+        auto &pair = elements[index(copyStart + i)];
+        auto g = ramp ? gain(i, cnt, n) : 1.0f;
+        *left++ = pair.l * g;
+        *right++ = pair.r * g;
     }
+    skip(cnt);
+
+    // Check for buffer underflows
+    if (cnt < n) {
+
+        // Fill the rest with zeroes
+        for (isize i = cnt; i < n; i++) *left++ = *right++ = 0;
+
+        // Realign the ring buffer
+        handleBufferUnderflow();
+    }
+
+    endHostCopy();
+    return cnt;
 }
 
 isize
 AudioPort::copyInterleaved(float *buffer, isize n)
 {
-    {   SYNCHRONIZED
-
-        // Be silent when the recorder is running (fill with zeroes)
-        if (recorder.isRecording()) {
-
-            // Fill with zeroes
-            for (isize i = 0; i < n; i++) { *buffer++ = 0; }
-            return 0;
-        }
+    static_assert(sizeof(SamplePair) == 2 * sizeof(float));
 
-        // Check for buffer underflows
-        if (auto cnt = count(); cnt < n) {
+    // Be silent when the recorder is running (fill with zeroes)
+    if (!beginHostCopy()) {
 
-            // Copy all we have and stepwise lower the volume to minimize cracks
-            for (isize i = 0; i < cnt; i++) {
+        // Fill with zeroes
+        for (isize i = 0; i < 2 * n; i++) { *buffer++ = 0; }
+        return 0;
+    }
 
-                SamplePair pair = read();
-                *buffer++ = pair.l * float(cnt - i) / float(cnt);
-                *buffer++ = pair.r * float(cnt - i) / float(cnt);
-            }
-            assert(isEmpty());
+    // Copy all we have in bulk, but not more than requested
+    auto cnt = tryRead((SamplePair *)buffer, beginCopy(n));
 
-            // Fill the rest with zeroes
-            for (isize i = cnt; i < n; i++) { *buffer++ = 0; *buffer++ = 0; }
+    // Apply volume ramps if needed
+    if (cnt < n || copyStart < fadeStop) {
 
-            // Realign the ring buffer
-            handleBufferUnderflow();
+        for (isize i = 0; i < cnt; i++) {
 
-            return cnt;
+            auto g = gain(i, cnt, n);
+            buffer[2 * i] *= g;
+            buffer[2 * i + 1] *= g;
         }
+    }
 
-        // We have enough samples. Copy over the requested number
-        for (isize i = 0; i < n; i++) {
+    // Check for buffer underflows
+    if (cnt < n) {
 
-            SamplePair pair = read();
-            *buffer++ = pair.l;
-            *buffer++ = pair.r;
-        }
-        
-        return n;
+        // Fill the rest with zeroes
+        for (isize i = 2 * cnt; i < 2 * n; i++) buffer[i] = 0;
+
+        // Realign the ring buffer
+        handleBufferUnderflow();
     }
+
+    endHostCopy();
+    return cnt;
+}
+
+isize
+AudioPort::copy(SamplePair *buffer, isize n)
+{
+    return tryRead(buffer, beginCopy(n));
 }
 
 }
@@ -25,7 +25,9 @@ class SIDBridge;
 class AudioPort final :
 public SubComponent,
 public Inspectable<AudioPortInfo, AudioPortStats>,
-public util::RingBuffer <SamplePair, 12288> {
+public util::SPSCRingBuffer <SamplePair, 16384> {
+
+    friend class Benchmark;
 
     Descriptions descriptions = {{
 
@@ -52,12 +54,76 @@ public util::RingBuffer <SamplePair, 12288> {
     // Current configuration
     AudioPortConfig config = { };
 
-    // Time stamp of the last write pointer alignment
-    util::Time lastAlignment;
+    /* The ring buffer connects the emulator thread (producer) with the audio
+     * thread of the host (consumer) without any locking. Each side only moves
+     * the counter it owns. If one side needs the other side to move its
+     * counter, it files a request that is served when the other side runs.
+     */
+
+    // Number of buffered samples after a realignment
+    static constexpr isize alignedCount = 6144;
+
+    // Requests silence padding after an underflow (filed by the consumer)
+    std::atomic<bool> padRequest = false;
+
+    // Requests dropping all samples beyond the given count (filed by the producer)
+    std::atomic<isize> trimRequest = -1;
+
+    // Requests fading out all samples up to the given write counter (filed by the producer)
+    std::atomic<isize> fadeRequest = 0;
+
+    // The currently faded out range of read counters (owned by the consumer)
+    isize fadeStart = 0;
+    isize fadeStop = 0;
+
+    // Read counter at the beginning of the current copy operation (owned by the consumer)
+    isize copyStart = 0;
 
-    // Sample rate adjustment
+    /* While a recording is in progress, the recorder takes over the consumer
+     * role on the emulator thread. It files a takeover request and waits until
+     * the host callback has left the ring buffer. The host callback flags each
+     * copy operation and backs off as long as the takeover request is set.
+     */
+    std::atomic<bool> takeover = false;
+    std::atomic<bool> copying = false;
+
+    // Mixed samples waiting to be handed over in bulk (owned by the producer)
+    SamplePair block[512];
+    isize blockCount = 0;
+
+    // Fill level extremes since the last inspection (recorded by the consumer)
+    mutable std::atomic<isize> minCount = 0;
+    mutable std::atomic<isize> maxCount = 0;
+
+    // Buffer incident counters
+    std::atomic<u64> underflows = 0;
+    std::atomic<u64> overflows = 0;
+
+    /* Sample rate adjustment. The host consumes the samples with its own
+     * clock, which drifts against the emulated one. The producer compensates
+     * the drift by correcting the sample rate in proportion to the deviation
+     * of the fill level from the aligned count.
+     */
     double sampleRateCorrection = 0.0;
 
+    // Maximum sample rate adjustment (relative to the sample rate)
+    static constexpr double maxCorrection = 0.005;
+
+    // Read counter at the time of the last adjustment (owned by the producer)
+    isize lastReadCounter = 0;
+
+    /* Fractional resampler. The SIDs always produce samples at the host sample
+     * rate. The sample rate correction is applied afterwards by a 4-tap cubic
+     * Hermite interpolator. It interpolates between the two middle samples of
+     * the history and the incoming sample, which delays the output by one
+     * sample. The step is the distance between two output samples, measured
+     * in input samples. The history stores the last three input samples with
+     * the oldest one coming first.
+     */
+    double resampleStep = 1.0;
+    double resamplePhase = 0.0;
+    SamplePair resampleHist[3] = { };
+
     // Channel volumes
     float vol[4] = { };
 
@@ -82,7 +148,6 @@ public:
 
     AudioPort& operator= (const AudioPort& other) {
 
-        CLONE(lastAlignment)
         CLONE(config)
 
         return *this;
@@ -160,22 +225,24 @@ public:
 
 public:
 
-    // Puts the write pointer somewhat ahead of the read pointer
+    // Pads the buffer with silence to put the write pointer ahead of the read pointer
     void alignWritePtr();
 
     /* Handles a buffer underflow condition. A buffer underflow occurs when the
      * audio device of the host machine needs sound samples than SID hasn't
-     * produced, yet.
+     * produced, yet. The function is called by the consumer and asks the
+     * producer to realign the write pointer.
      */
     void handleBufferUnderflow();
 
     /* Handles a buffer overflow condition. A buffer overflow occurs when SID
      * is producing more samples than the audio device of the host machine is
-     * able to consume.
+     * able to consume. The function is called by the producer and asks the
+     * consumer to drop the surplus samples.
      */
     void handleBufferOverflow();
 
-    // Reduces the sample count to the specified number
+    // Reduces the sample count to the specified number (called by the consumer)
     void clamp(isize maxSamples);
 
 
@@ -193,11 +260,23 @@ public:
 
 private:
 
+    // Adjusts the sample rate to the speed of the consumer
+    void updateSampleRateCorrection();
+
     // Generates samples from the audio source with a single active SID
-    template <bool fading> void mixSingleSID(isize numSamples);
+    template <bool fading, bool V = true> void mixSingleSID(isize numSamples);
 
     // Generates samples from the audio source with multiple active SIDs
-    template <bool fading> void mixMultiSID(isize numSamples);
+    template <bool fading, bool V = true> void mixMultiSID(isize numSamples);
+
+    // Mixes the samples of N SIDs block by block (V selects the vectorized routine)
+    template <isize N, bool fading, bool V> void mix(isize numSamples);
+
+    // Writes a sample into the ring buffer (applying the sample rate correction)
+    void put(const SamplePair &pair);
+
+    // Hands all pending samples over to the consumer
+    void flush();
 
 
     //
@@ -227,11 +306,33 @@ public:
     /* Copies n audio samples into a memory buffer. These functions mark the
      * final step in the audio pipeline. They are used to copy the generated
      * sound samples into the buffers of the native sound device. The function
-     * returns the number of copied samples.
+     * returns the number of copied samples. The functions never block.
      */
     isize copyMono(float *buffer, isize n);
     isize copyStereo(float *left, float *right, isize n);
     isize copyInterleaved(float *buffer, isize n);
+
+    // Copies up to n unprocessed samples (used by the recorder)
+    isize copy(SamplePair *buffer, isize n);
+
+    /* Moves the consumer role from the host callback to the calling thread
+     * and back. While the calling thread owns the consumer role, the host
+     * callback receives silence.
+     */
+    void acquireConsumer();
+    void releaseConsumer();
+
+private:
+
+    // Flags a copy operation of the host callback (fails if the role is taken)
+    bool beginHostCopy();
+    void endHostCopy();
+
+    // Serves all pending requests and returns the number of copyable samples
+    isize beginCopy(isize n);
+
+    // Returns the volume scaling factor for the i-th out of cnt copied samples
+    float gain(isize i, isize cnt, isize n) const;
 };
 
 }
@@ -50,6 +50,8 @@ AudioPort::_dump(Category category, std::ostream& os) const
         os << flt(pan[3]) << std::endl;
         os << tab("Sample rate correction");
         os << flt(sampleRateCorrection) << " Hz" << std::endl;
+        os << tab("Buffered samples");
+        os << dec(count()) << " (" << dec(cap()) << " max)" << std::endl;
     }
 }
 
@@ -64,7 +66,13 @@ AudioPort::cacheStats(AudioPortStats &result) const
 {
     {   SYNCHRONIZED
         
+        auto cnt = count();
+
         stats.fillLevel = fillLevel();
+        stats.minFillLevel = double(minCount.exchange(cnt)) / cap();
+        stats.maxFillLevel = double(maxCount.exchange(cnt)) / cap();
+        stats.bufferUnderflows = underflows;
+        stats.bufferOverflows = overflows;
     }
 }
 
@@ -73,21 +81,21 @@ AudioPort::_didReset(bool hard)
 {
     SYNCHRONIZED
 
-    // Wipe out the buffer contents
-    this->clear(SamplePair{0,0});
-
-    // Realign the write pointer
-    alignWritePtr();
-    lastAlignment = util::Time::now();
+    // Ask the consumer to wipe out the buffer contents
+    blockCount = 0;
+    trimRequest = 0;
 
     // Clear statistics
-    if (hard) clearStats();
+    if (hard) { clearStats(); underflows = 0; overflows = 0; }
 }
 
 void 
 AudioPort::_powerOn()
 {
     sampleRateCorrection = 0.0;
+    lastReadCounter = r.load();
+    resamplePhase = 0.0;
+    for (auto &sample : resampleHist) sample = { };
 }
 
 void
@@ -47,6 +47,10 @@ typedef struct
     // Current ring buffer fill level
     double fillLevel;
 
+    // Lowest and highest fill level seen by the consumer since the last inspection
+    double minFillLevel;
+    double maxFillLevel;
+
     // Number of buffer underflows since power up
     u64 bufferUnderflows;
 
@@ -22,15 +22,63 @@ VideoPort::VideoPort(C64 &ref) : SubComponent(ref)
 };
 
 u32 *
-VideoPort::getTexture() const
+VideoPort::getTexture(i64 *nr) const
 {
     if (isPoweredOff()) {
+        if (nr) *nr = -1;
         return config.whiteNoise ? getNoiseTexture() : getBlankTexture();
     } else {
-        return vic.getTexture();
+        return vic.getTexture(nr);
     }
 }
 
+void
+VideoPort::copyFrontTexture(u32 *dst, i64 *nr) const
+{
+    if (isPoweredOff()) {
+
+        auto *src = config.whiteNoise ? getNoiseTexture() : getBlankTexture();
+        std::memcpy(dst, src, Texture::height * Texture::width * sizeof(u32));
+        if (nr) *nr = -1;
+
+    } else {
+
+        vic.copyFrontTexture(dst, nr);
+    }
+}
+
+void
+VideoPort::copyTexture(u32 *dst) const
+{
+    if (isPoweredOff()) {
+
+        auto *src = config.whiteNoise ? getNoiseTexture() : getBlankTexture();
+        std::memcpy(dst, src, Texture::height * Texture::width * sizeof(u32));
+
+    } else {
+
+        vic.copyTexture(dst);
+    }
+}
+
+const u8 *
+VideoPort::getIndexedTexture() const
+{
+    return vic.getIndexedTexture();
+}
+
+void
+VideoPort::computeLut(u32 *lut) const
+{
+    vic.computeLut(lut);
+}
+
+i64
+VideoPort::getLatestFrame() const
+{
+    return isPoweredOff() ? -1 : vic.getLatestFrame();
+}
+
 u32 *
 VideoPort::getDmaTexture() const
 {
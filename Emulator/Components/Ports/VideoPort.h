@@ -99,8 +99,32 @@ public:
 
 public:
 
-    // Returns a pointer to the stable emulator texture
-    u32 *getTexture() const;
+    /* Returns a pointer to the stable emulator texture. If nr is given, the
+     * frame number of the texture is written into it. The number is negative
+     * if the emulator is powered off.
+     */
+    u32 *getTexture(i64 *nr = nullptr) const;
+
+    /* Copies the stable emulator texture into dst. Unlike getTexture(), this
+     * function can be called from any thread and by multiple consumers.
+     */
+    void copyFrontTexture(u32 *dst, i64 *nr = nullptr) const;
+
+    /* Copies the latest completed frame into dst. Unlike getTexture(), this
+     * function doesn't lock. It is meant for consumers on the emulator thread.
+     */
+    void copyTexture(u32 *dst) const;
+
+    /* Returns the latest completed frame with one color index per pixel (see
+     * TEX_COLORS) and the lookup table translating the indices into RGBA
+     * values. Like copyTexture(), these functions are meant for consumers on
+     * the emulator thread. The DMA debugger overlay is not included.
+     */
+    const u8 *getIndexedTexture() const;
+    void computeLut(u32 *lut) const;
+
+    // Returns the number of the latest completed frame
+    i64 getLatestFrame() const;
 
     // Returns a pointer to the stable DMA debugger texture
     u32 *getDmaTexture() const;
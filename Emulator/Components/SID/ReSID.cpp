@@ -119,6 +119,9 @@ ReSID::operator << (SerReader &worker)
 void
 ReSID::operator << (SerWriter &worker)
 {
+    // Apply all cycles that have been skipped in a silent phase
+    sid->end_silence();
+
     st = sid->read_state();
     serialize(worker);
 }
@@ -270,6 +273,18 @@ ReSID::setSamplingMethod(SamplingMethod value)
     assert((SamplingMethod)sid->sampling == samplingMethod);
 }
 
+void
+ReSID::setPowerSave(bool enable)
+{
+    if (powerSave != enable) {
+
+        powerSave = enable;
+        if (!enable) sid->end_silence();
+
+        trace(SID_DEBUG, "%s silence detection.\n", enable ? "Enabling" : "Disabling");
+    }
+}
+
 u8
 ReSID::peek(u16 addr)
 {	
@@ -297,7 +312,15 @@ ReSID::executeCycles(isize numCycles, SampleStream &stream)
     isize samples = 0;
     reSID::cycle_count cycles = (reSID::cycle_count)numCycles;
     while (cycles && samples < buflength) {
-        int resid = sid->clock(cycles, buf + samples, int(buflength) - int(samples));
+
+        int resid;
+
+        // Skip synthesis if the SID is provably silent
+        if (powerSave && sid->detect_silence()) {
+            resid = sid->clock_silence(cycles, buf + samples, int(buflength) - int(samples));
+        } else {
+            resid = sid->clock(cycles, buf + samples, int(buflength) - int(samples));
+        }
         samples += (isize)resid;
     }
     
@@ -24,6 +24,8 @@ namespace vc64 {
  *   List of modifications applied to reSID:
  *
  *     - Changed visibility of some objects from protected to public
+ *     - Vectorized the FIR convolutions in SAMPLE_RESAMPLE mode
+ *     - Added silence detection to skip sample synthesis
  *
  *   Good candidate for testing sound emulation:
  *
@@ -74,6 +76,9 @@ private:
     // Switches filter emulation on or off
     bool emulateFilter = true;
 
+    // Skips sample synthesis while the SID is provably silent
+    bool powerSave = false;
+
     
     //
     // Methods
@@ -91,6 +96,7 @@ public:
         CLONE(clockFrequency)
         CLONE(samplingMethod)
         CLONE(emulateFilter)
+        CLONE(powerSave)
 
         return *this;
     }
@@ -195,6 +201,9 @@ public:
     
     SamplingMethod getSamplingMethod() const;
     void setSamplingMethod(SamplingMethod value);
+
+    bool getPowerSave() const { return powerSave; }
+    void setPowerSave(bool enable);
     
     
     //
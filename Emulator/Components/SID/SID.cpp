@@ -24,10 +24,29 @@ SID::SID(C64 &ref, isize id) : SubComponent(ref, id)
 void
 SID::operator << (SerReader &worker)
 {
+    // Let the audio worker finish all pending jobs
+    sidBridge.sync();
+
     serialize(worker);
+    synthClock = clock;
     stream.clear(0);
 }
 
+void
+SID::operator << (SerWriter &worker)
+{
+    // Let the audio worker finish all pending jobs
+    sidBridge.sync();
+
+    serialize(worker);
+}
+
+void
+SID::_didReset(bool hard)
+{
+    synthClock = clock;
+}
+
 u8
 SID::spypeek(u16 addr) const
 {
@@ -50,7 +69,12 @@ void
 SID::poke(u16 addr, u8 value)
 {
     sidreg[addr & 0x1F] = value;
-    
+    write(addr, value);
+}
+
+void
+SID::write(u16 addr, u8 value)
+{
     switch (config.engine) {
 
         case SIDENGINE_RESID:   resid.poke(addr & 0x1F, value); break;
@@ -62,11 +86,18 @@ SID::poke(u16 addr, u8 value)
 
 void 
 SID::executeUntil(Cycle targetCycle)
+{
+    synthesize(targetCycle);
+    clock = targetCycle;
+}
+
+void
+SID::synthesize(Cycle targetCycle)
 {
     if (isEnabled() && !powerSave()) {
 
         // Compute the number of missing cycles
-        Cycle missing = targetCycle - clock;
+        Cycle missing = targetCycle - synthClock;
 
         // Check if SID is in sync with the CPU
         if (missing < -1000 || missing > 1000000) {
@@ -87,7 +118,7 @@ SID::executeUntil(Cycle targetCycle)
         // trace(true, "Power safe mode\n");
     }
 
-    clock = targetCycle;
+    synthClock = targetCycle;
 }
 
 bool
@@ -23,6 +23,7 @@ class SID final : public SubComponent, public Inspectable<SIDInfo>
 {
     friend class SIDBridge;
     friend class AudioPort;
+    friend class Benchmark;
 
     Descriptions descriptions = {
         {
@@ -59,7 +60,8 @@ class SID final : public SubComponent, public Inspectable<SIDInfo>
         OPT_SID_FILTER,
         OPT_SID_ENGINE,
         OPT_SID_SAMPLING,
-        OPT_SID_POWER_SAVE
+        OPT_SID_POWER_SAVE,
+        OPT_SID_ASYNC
     };
 
     // Current configuration
@@ -71,6 +73,12 @@ class SID final : public SubComponent, public Inspectable<SIDInfo>
     // This SID has been executed up to this cycle
     Cycle clock = 0;
 
+    /* Samples have been synthesized up to this cycle. The value only differs
+     * from clock if synthesis is delegated to the audio worker (which might
+     * lag behind or run ahead a few cycles).
+     */
+    Cycle synthClock = 0;
+
     // The audio stream
     SampleStream stream;
 
@@ -92,6 +100,7 @@ public:
 
         CLONE_ARRAY(sidreg)
         CLONE(clock)
+        CLONE(synthClock)
         CLONE(resid)
 
         CLONE(config)
@@ -132,7 +141,7 @@ public:
     void operator << (SerChecker &worker) override { serialize(worker); }
     void operator << (SerCounter &worker) override { serialize(worker); }
     void operator << (SerReader &worker) override;
-    void operator << (SerWriter &worker) override { serialize(worker); }
+    void operator << (SerWriter &worker) override;
 
 
     //
@@ -146,6 +155,7 @@ public:
 private:
 
     void _dump(Category category, std::ostream& os) const override;
+    void _didReset(bool hard) override;
 
 
     //
@@ -189,6 +199,11 @@ public:
     // Writes a SID register
     void poke(u16 addr, u8 value);
 
+private:
+
+    // Passes a register write to the emulation engine
+    void write(u16 addr, u8 value);
+
 
     //
     // Computing audio samples
@@ -199,6 +214,9 @@ public:
      */
     void executeUntil(Cycle targetCycle);
 
+    // Synthesizes all samples up to a certain cycle
+    void synthesize(Cycle targetCycle);
+
     // Indicates if sample synthesis should be skipped
     bool powerSave() const;
 
@@ -86,6 +86,7 @@ SID::getOption(Option option) const
         case OPT_SID_ENGINE:        return config.engine;
         case OPT_SID_SAMPLING:      return config.sampling;
         case OPT_SID_POWER_SAVE:    return config.powerSave;
+        case OPT_SID_ASYNC:         return config.async;
 
         default:
             fatalError;
@@ -146,6 +147,7 @@ SID::checkOption(Option opt, i64 value)
             return;
 
         case OPT_SID_POWER_SAVE:
+        case OPT_SID_ASYNC:
 
             return;
 
@@ -217,7 +219,23 @@ SID::setOption(Option opt, i64 value)
 
         case OPT_SID_POWER_SAVE:
 
-            config.powerSave = bool(value);
+            if (config.powerSave != bool(value)) {
+
+                // Let the audio worker finish all pending jobs
+                sidBridge.sync();
+                config.powerSave = bool(value);
+                resid.setPowerSave(bool(value));
+            }
+            return;
+
+        case OPT_SID_ASYNC:
+
+            if (config.async != bool(value)) {
+
+                // Let the audio worker finish all pending jobs
+                sidBridge.sync();
+                config.async = bool(value);
+            }
             return;
 
         default:
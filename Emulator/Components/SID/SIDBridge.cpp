@@ -29,6 +29,34 @@ SIDBridge::SIDBridge(C64 &ref) : SubComponent(ref)
         &sid[2],
         &sid[3]
     };
+
+    // Assign each SID a worker of its own if enough cores are available
+    poolSize = std::clamp(isize(std::thread::hardware_concurrency()) - 1, isize(1), isize(4));
+}
+
+SIDBridge::~SIDBridge()
+{
+    for (isize i = 0; i < poolSize; i++) {
+
+        if (workers[i].joinable()) {
+
+            submit(SIDJob { .nr = u8(i), .type = SIDJob::QUIT });
+            workers[i].join();
+        }
+    }
+}
+
+void
+SIDBridge::_willReset(bool hard)
+{
+    sync();
+}
+
+void
+SIDBridge::_pause()
+{
+    // Leave the SIDs in a consistent state if the emulator stops mid-frame
+    sync();
 }
 
 isize
@@ -50,7 +78,7 @@ SIDBridge::peek(u16 addr)
     isize sidNr = mappedSID(addr);
 
     // Get the target SID up to date
-    sid[sidNr].executeUntil(cpu.clock);
+    executeUntil(sidNr, cpu.clock);
 
     addr &= 0x1F;
 
@@ -69,7 +97,10 @@ SIDBridge::peek(u16 addr)
             return readPotY();
         }
     }
-    
+
+    // The read value depends on the synthesized state (OSC3, ENV3, bus value)
+    if (sid[sidNr].config.async) sync(sidNr);
+
     return sid[sidNr].resid.peek(addr);
 }
 
@@ -120,11 +151,28 @@ SIDBridge::poke(u16 addr, u8 value)
     // Select the target SID
     isize sidNr = mappedSID(addr);
 
-    // Get the target SID up to date
-    sid[sidNr].executeUntil(cpu.clock);
+    if (sid[sidNr].config.async) {
 
-    // Write the register
-    sid[sidNr].poke(addr, value);
+        // Update the mirrored register and let the audio worker do the rest
+        sid[sidNr].sidreg[addr & 0x1F] = value;
+        sid[sidNr].clock = cpu.clock;
+        submit(SIDJob {
+
+            .cycle = cpu.clock,
+            .nr = u8(sidNr),
+            .type = SIDJob::WRITE,
+            .addr = u8(addr & 0x1F),
+            .value = value
+        });
+
+    } else {
+
+        // Get the target SID up to date
+        sid[sidNr].executeUntil(cpu.clock);
+
+        // Write the register
+        sid[sidNr].poke(addr, value);
+    }
 }
 
 void 
@@ -149,23 +197,131 @@ SIDBridge::beginFrame()
     // Update the CPU clock frequency
     c64.updateClockFrequency();
 
-    // Update the audio sample rate
-    setSampleRate(host.getOption(OPT_HOST_SAMPLE_RATE) + audioPort.getSampleRateCorrection());
+    /* Update the audio sample rate if the host rate has changed. Note that
+     * reSID is not reconfigured on sample rate corrections. These are applied
+     * by the audio port when the samples are mixed.
+     */
+    if (auto rate = double(host.getConfig().sampleRate); rate != sid0.getSampleRate()) {
+        setSampleRate(rate);
+    }
 }
 
 void 
 SIDBridge::endFrame()
 {
     // Execute all remaining SID cycles
-    sid0.executeUntil(cpu.clock);
-    sid1.executeUntil(cpu.clock);
-    sid2.executeUntil(cpu.clock);
-    sid3.executeUntil(cpu.clock);
+    for (isize i = 0; i < 4; i++) executeUntil(i, cpu.clock);
+
+    // Wait for the audio workers
+    sync();
 
     // Generate sound sampes
     audioPort.generateSamples();
 }
 
+void
+SIDBridge::endScanline()
+{
+    /* Let the audio worker run ahead every eight scanlines. It stops one cycle
+     * short of the current cycle, because reSID forces at least one cycle to
+     * be executed if it is called twice with the same target cycle. Since the
+     * chunked execution with SAMPLE_FAST doesn't produce the same samples as
+     * executing all cycles in a single run, the worker has to wait for the
+     * next register write in this mode.
+     */
+    if ((c64.scanline & 7) == 0) {
+
+        for (isize i = 0; i < 4; i++) {
+
+            if (!sid[i].config.async || sid[i].config.sampling == SAMPLING_FAST) continue;
+
+            submit(SIDJob {
+
+                .cycle = cpu.clock - 1,
+                .nr = u8(i),
+                .type = SIDJob::ADVANCE
+            });
+        }
+    }
+}
+
+void
+SIDBridge::sync() const
+{
+    for (isize i = 0; i < poolSize; i++) jobs[i].waitUntilEmpty();
+}
+
+void
+SIDBridge::sync(isize nr) const
+{
+    jobs[nr % poolSize].waitUntilEmpty();
+}
+
+void
+SIDBridge::executeUntil(isize nr, Cycle cycle)
+{
+    if (sid[nr].config.async) {
+
+        sid[nr].clock = cycle;
+        submit(SIDJob { .cycle = cycle, .nr = u8(nr), .type = SIDJob::EXECUTE });
+
+    } else {
+
+        sid[nr].executeUntil(cycle);
+    }
+}
+
+void
+SIDBridge::submit(const SIDJob &job)
+{
+    auto nr = job.nr % poolSize;
+
+    // Launch the audio worker on first use
+    if (!workers[nr].joinable()) workers[nr] = std::thread(&SIDBridge::runWorker, this, nr);
+
+    jobs[nr].write(job);
+}
+
+void
+SIDBridge::runWorker(isize nr)
+{
+    auto &queue = jobs[nr];
+
+    while (true) {
+
+        // Wait for the next job
+        auto &job = queue.front();
+        auto &target = sid[job.nr];
+
+        switch (job.type) {
+
+            case SIDJob::EXECUTE:
+
+                target.synthesize(job.cycle);
+                break;
+
+            case SIDJob::WRITE:
+
+                target.synthesize(job.cycle);
+                target.write(job.addr, job.value);
+                break;
+
+            case SIDJob::ADVANCE:
+
+                if (job.cycle > target.synthClock) target.synthesize(job.cycle);
+                break;
+
+            case SIDJob::QUIT:
+
+                queue.pop();
+                return;
+        }
+
+        // Signal completion
+        queue.pop();
+    }
+}
+
 float
 SIDBridge::draw(u32 *buffer, isize width, isize height,
             float maxAmp, u32 color, isize nr) const
@@ -195,7 +351,7 @@ SIDBridge::draw(u32 *buffer, isize width, isize height,
 
             for (isize w = 0; w < width; w++) {
 
-                auto sample = audioPort.current(isize(w * dw));
+                auto sample = audioPort.elements[isize(w * dw)];
                 samples[w][0] = abs(sample.l);
                 samples[w][1] = abs(sample.r);
             }
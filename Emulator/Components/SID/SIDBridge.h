@@ -19,6 +19,8 @@
 #include "AudioPort.h"
 #include "SID.h"
 #include "Chrono.h"
+#include "RingBuffer.h"
+#include <thread>
 
 namespace vc64 {
 
@@ -42,8 +44,48 @@ namespace vc64 {
  *          |  |  SID3  |----->                               |
  *          |   --------                                      |
  *           -------------------------------------------------
+ *
+ * If a SID is configured to run asynchronously, the bridge doesn't execute it
+ * on the emulator thread. Instead, it records all register writes together
+ * with the cycle they happen in and hands them over to an audio worker. The
+ * worker replays the writes in order and synthesizes the samples in between.
+ * Because the worker performs exactly the same sequence of reSID calls as the
+ * emulator thread would, the produced samples are identical in both modes.
+ * The emulator thread only waits for the worker if it needs to know the
+ * synthesized state, i.e., when a reSID register is read (OSC3, ENV3, and the
+ * bus value depend on it) and at the end of each frame.
+ *
+ * The SIDs are independent of each other. Hence, the bridge distributes them
+ * among a small pool of audio workers (one per SID if the host has enough
+ * cores). Each worker owns a job queue and processes the jobs of its SIDs in
+ * order, which keeps the output deterministic.
  */
 
+// A job for the audio worker
+struct SIDJob {
+
+    enum Type : u8 {
+
+        EXECUTE,    // Synthesize samples up to the target cycle
+        WRITE,      // Same as EXECUTE followed by a register write
+        ADVANCE,    // Same as EXECUTE if the target cycle lies in the future
+        QUIT        // Terminate the worker
+    };
+
+    // Target cycle
+    Cycle cycle;
+
+    // Target SID
+    u8 nr;
+
+    // Action to perform
+    Type type;
+
+    // Register write
+    u8 addr;
+    u8 value;
+};
+
 class SIDBridge final : public SubComponent {
 
     friend Memory;
@@ -77,6 +119,22 @@ public:
     };
 
 
+    //
+    // Audio worker
+    //
+
+private:
+
+    // Number of audio workers
+    isize poolSize = 1;
+
+    // Jobs waiting for the audio workers
+    util::SPSCRingBuffer<SIDJob, 4096> jobs[4];
+
+    // The audio workers (launched on demand)
+    std::thread workers[4];
+
+
     //
     // Methods
     //
@@ -84,9 +142,13 @@ public:
 public:
 
     SIDBridge(C64 &ref);
+    ~SIDBridge();
 
     SIDBridge& operator= (const SIDBridge& other) {
 
+        sync();
+        other.sync();
+
         CLONE_ARRAY(sid)
 
         return *this;
@@ -111,6 +173,11 @@ public:
 
     const Descriptions &getDescriptions() const override { return descriptions; }
 
+private:
+
+    void _willReset(bool hard) override;
+    void _pause() override;
+
 
     //
     // Methods from Configurable
@@ -146,6 +213,26 @@ public:
     // Finishes the current frame
     void endFrame();
 
+    // Finishes the current scanline
+    void endScanline();
+
+    // Waits until all audio workers have finished all pending jobs
+    void sync() const;
+
+    // Waits until the audio worker of a certain SID has finished all jobs
+    void sync(isize nr) const;
+
+private:
+
+    // Gets a SID up to date (directly or by delegating to the audio worker)
+    void executeUntil(isize nr, Cycle cycle);
+
+    // Hands a job over to the audio worker of the target SID
+    void submit(const SIDJob &job);
+
+    // Main function of an audio worker
+    void runWorker(isize nr);
+
     
     //
     // Accessig memory
@@ -139,6 +139,7 @@ typedef struct
 
     // Performance
     bool powerSave;
+    bool async;
 
 }
 SIDConfig;
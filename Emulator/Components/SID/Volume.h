@@ -90,7 +90,23 @@ template <typename T> struct AudioVolume : Serializable {
     }
 
     // Shifts the current volume towards the target volume
-    void shift() {
+    void shift() { shift(current, delta); }
+
+    // Shifts the volume n times and records all intermediate values
+    void shift(T *values, isize n) {
+
+        auto cur = current;
+        auto del = delta;
+
+        for (isize i = 0; i < n; i++) { shift(cur, del); values[i] = cur; }
+
+        current = cur;
+        delta = del;
+    }
+
+private:
+
+    void shift(T &current, T &delta) const {
         
         if (delta < 0 && current != 0) {
 
@@ -38,9 +38,137 @@ using namespace std;
 // DIRK
 #define resid_round(x) (x>=0.0?floor(x+0.5):ceil(x-0.5))
 
+// DIRK: Vectorized FIR convolution
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define RESID_AVX2 1
+#endif
+#endif
+
 namespace reSID
 {
 
+// ----------------------------------------------------------------------------
+// FIR convolution kernels.
+// All kernels accumulate the 16 x 16 bit products in 32 bit integers. Since
+// integer addition is associative, the vectorized kernels produce exactly the
+// same result as the portable loop.
+// ----------------------------------------------------------------------------
+typedef int (*convolve_fn)(const short* a, const short* b, int n);
+
+static int convolve_portable(const short* a, const short* b, int n)
+{
+  int v = 0;
+  for (int i = 0; i < n; i++) {
+    v += a[i]*b[i];
+  }
+  return v;
+}
+
+#if defined(__aarch64__)
+
+static int convolve_neon(const short* a, const short* b, int n)
+{
+  int32x4_t acc = vdupq_n_s32(0);
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    int16x8_t x = vld1q_s16(a + i);
+    int16x8_t y = vld1q_s16(b + i);
+    acc = vmlal_s16(acc, vget_low_s16(x), vget_low_s16(y));
+    acc = vmlal_high_s16(acc, x, y);
+  }
+  int v = vaddvq_s32(acc);
+  for (; i < n; i++) {
+    v += a[i]*b[i];
+  }
+  return v;
+}
+
+#elif defined(__SSE2__) || defined(_M_X64)
+
+static int convolve_sse2(const short* a, const short* b, int n)
+{
+  __m128i acc = _mm_setzero_si128();
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128i x = _mm_loadu_si128((const __m128i*)(a + i));
+    __m128i y = _mm_loadu_si128((const __m128i*)(b + i));
+    acc = _mm_add_epi32(acc, _mm_madd_epi16(x, y));
+  }
+  acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+  acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+  int v = _mm_cvtsi128_si32(acc);
+  for (; i < n; i++) {
+    v += a[i]*b[i];
+  }
+  return v;
+}
+
+#ifdef RESID_AVX2
+
+__attribute__((target("avx2")))
+static int convolve_avx2(const short* a, const short* b, int n)
+{
+  __m256i acc = _mm256_setzero_si256();
+  int i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+    __m256i y = _mm256_loadu_si256((const __m256i*)(b + i));
+    acc = _mm256_add_epi32(acc, _mm256_madd_epi16(x, y));
+  }
+  __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(acc),
+                              _mm256_extracti128_si256(acc, 1));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+  int v = _mm_cvtsi128_si32(sum);
+  for (; i < n; i++) {
+    v += a[i]*b[i];
+  }
+  return v;
+}
+
+#endif
+#endif
+
+// Picks the widest kernel supported by the host CPU.
+static convolve_fn best_convolve()
+{
+#if defined(__aarch64__)
+  return convolve_neon;
+#elif defined(__SSE2__) || defined(_M_X64)
+#ifdef RESID_AVX2
+  if (__builtin_cpu_supports("avx2")) return convolve_avx2;
+#endif
+  return convolve_sse2;
+#else
+  return convolve_portable;
+#endif
+}
+
+static convolve_fn convolve = best_convolve();
+
+void SID::enable_simd(bool enable)
+{
+  convolve = enable ? best_convolve() : convolve_portable;
+}
+
+const char* SID::simd_kernel()
+{
+#if defined(__aarch64__)
+  if (convolve == convolve_neon) return "NEON";
+#elif defined(__SSE2__) || defined(_M_X64)
+#ifdef RESID_AVX2
+  if (convolve == convolve_avx2) return "AVX2";
+#endif
+  if (convolve == convolve_sse2) return "SSE2";
+#endif
+  return "C++";
+}
+
 inline short clip(int input)
 {
     // Saturated arithmetics to guard against 16 bit sample overflow.
@@ -61,12 +189,17 @@ SID::SID()
   // Initialize pointers.
   sample = 0;
   fir = 0;
+  fir_sum = 0;
   fir_N = 0;
   fir_RES = 0;
   fir_beta = 0;
   fir_f_cycles_per_sample = 0;
   fir_filter_scale = 0;
 
+  silent = false;
+  silent_cycles = 0;
+  silent_level = 0;
+
   sid_model = MOS6581;
   voice[0].set_sync_source(&voice[2]);
   voice[1].set_sync_source(&voice[0]);
@@ -91,6 +224,7 @@ SID::~SID()
 {
   delete[] sample;
   delete[] fir;
+  delete[] fir_sum;
 }
 
 
@@ -99,6 +233,8 @@ SID::~SID()
 // ----------------------------------------------------------------------------
 void SID::set_chip_model(chip_model model)
 {
+  end_silence();
+
   sid_model = model;
 
   /*
@@ -126,6 +262,8 @@ void SID::set_chip_model(chip_model model)
 // ----------------------------------------------------------------------------
 void SID::reset()
 {
+  end_silence();
+
   for (int i = 0; i < 3; i++) {
     voice[i].reset();
   }
@@ -145,6 +283,7 @@ void SID::reset()
 void SID::input(short sample)
 {
   // The input can be used to simulate the MOS8580 "digi boost" hardware hack.
+  end_silence();
   filter.input(sample);
 }
 
@@ -168,6 +307,8 @@ void SID::input(short sample)
 // ----------------------------------------------------------------------------
 reg8 SID::read(reg8 offset)
 {
+  end_silence();
+
   switch (offset) {
   case 0x19:
     bus_value = potx.readPOT();
@@ -197,6 +338,8 @@ reg8 SID::read(reg8 offset)
 // ----------------------------------------------------------------------------
 void SID::write(reg8 offset, reg8 value)
 {
+  end_silence();
+
   write_address = offset;
   bus_value = value;
   bus_value_ttl = databus_ttl;
@@ -414,6 +557,10 @@ void SID::write_state(const State& state)
   int i;
   sampling_method tmp;
 
+  // The restored state supersedes all skipped cycles.
+  silent = false;
+  silent_cycles = 0;
+
   /* HACK: remember sampling mode and set it to resampling incase it was fast,
            else the write() call will not work correctly */
   tmp = sampling;
@@ -458,6 +605,7 @@ void SID::write_state(const State& state)
 // ----------------------------------------------------------------------------
 void SID::set_voice_mask(reg4 mask)
 {
+  end_silence();
   filter.set_voice_mask(mask);
 }
 
@@ -467,6 +615,7 @@ void SID::set_voice_mask(reg4 mask)
 // ----------------------------------------------------------------------------
 void SID::enable_filter(bool enable)
 {
+  end_silence();
   filter.enable_filter(enable);
 }
 
@@ -478,6 +627,7 @@ void SID::enable_filter(bool enable)
 // The setting is currently only effective for 6581.
 // ----------------------------------------------------------------------------
 void SID::adjust_filter_bias(double dac_bias) {
+  end_silence();
   filter.adjust_filter_bias(dac_bias);
 }
 
@@ -487,6 +637,7 @@ void SID::adjust_filter_bias(double dac_bias) {
 // ----------------------------------------------------------------------------
 void SID::enable_external_filter(bool enable)
 {
+  end_silence();
   extfilt.enable_filter(enable);
 }
 
@@ -578,6 +729,8 @@ double SID::I0(double x)
 bool SID::set_sampling_parameters(double clock_freq, sampling_method method,
                         double sample_freq, double pass_freq, double filter_scale)
 {
+  end_silence();
+
   // Check resampling constraints.
   if (method == SAMPLE_RESAMPLE || method == SAMPLE_RESAMPLE_FASTMEM)
   {
@@ -706,6 +859,17 @@ bool SID::set_sampling_parameters(double clock_freq, sampling_method method,
     }
   }
 
+  // DIRK: The convolution of a constant signal only depends on the sums.
+  delete[] fir_sum;
+  fir_sum = new int[fir_RES];
+
+  for (int i = 0; i < fir_RES; i++) {
+    fir_sum[i] = 0;
+    for (int j = 0; j < fir_N; j++) {
+      fir_sum[i] += fir[i*fir_N + j];
+    }
+  }
+
   return true;
 }
 
@@ -762,6 +926,28 @@ void SID::clock(cycle_count delta_t)
   }
 
   // Clock and synchronize oscillators.
+  clock_oscillators(delta_t);
+
+  // Calculate waveform output.
+  for (i = 0; i < 3; i++) {
+    voice[i].wave.set_waveform_output(delta_t);
+  }
+
+  // Clock filter.
+  filter.clock(delta_t, voice[0].output(), voice[1].output(), voice[2].output());
+
+  // Clock external filter.
+  extfilt.clock(delta_t, filter.output());
+}
+
+
+// ----------------------------------------------------------------------------
+// Clock and synchronize oscillators - delta_t cycles.
+// ----------------------------------------------------------------------------
+void SID::clock_oscillators(cycle_count delta_t)
+{
+  int i;
+
   // Loop until we reach the current cycle.
   cycle_count delta_t_osc = delta_t;
   while (delta_t_osc) {
@@ -808,17 +994,6 @@ void SID::clock(cycle_count delta_t)
 
     delta_t_osc -= delta_t_min;
   }
-
-  // Calculate waveform output.
-  for (i = 0; i < 3; i++) {
-    voice[i].wave.set_waveform_output(delta_t);
-  }
-
-  // Clock filter.
-  filter.clock(delta_t, voice[0].output(), voice[1].output(), voice[2].output());
-
-  // Clock external filter.
-  extfilt.clock(delta_t, filter.output());
 }
 
 
@@ -838,6 +1013,8 @@ void SID::clock(cycle_count delta_t)
 // ----------------------------------------------------------------------------
 int SID::clock(cycle_count& delta_t, short* buf, int n, int interleave)
 {
+  end_silence();
+
   switch (sampling) {
   default:
   case SAMPLE_FAST:
@@ -993,10 +1170,7 @@ int SID::clock_resample(cycle_count& delta_t, short* buf, int n, int interleave)
     short* sample_start = sample + sample_index - fir_N - 1 + RINGSIZE;
 
     // Convolution with filter impulse response.
-    int v1 = 0;
-    for (int j = 0; j < fir_N; j++) {
-      v1 += sample_start[j]*fir_start[j];
-    }
+    int v1 = convolve(sample_start, fir_start, fir_N);
 
     // Use next FIR table, wrap around to first FIR table using
     // next sample.
@@ -1007,10 +1181,7 @@ int SID::clock_resample(cycle_count& delta_t, short* buf, int n, int interleave)
     fir_start = fir + fir_offset*fir_N;
 
     // Convolution with filter impulse response.
-    int v2 = 0;
-    for (int k = 0; k < fir_N; k++) {
-      v2 += sample_start[k]*fir_start[k];
-    }
+    int v2 = convolve(sample_start, fir_start, fir_N);
 
     // Linear interpolation.
     // fir_offset_rmd is equal for all samples, it can thus be factorized out:
@@ -1059,10 +1230,7 @@ int SID::clock_resample_fastmem(cycle_count& delta_t, short* buf, int n, int int
     short* sample_start = sample + sample_index - fir_N + RINGSIZE;
 
     // Convolution with filter impulse response.
-    int v = 0;
-    for (int j = 0; j < fir_N; j++) {
-      v += sample_start[j]*fir_start[j];
-    }
+    int v = convolve(sample_start, fir_start, fir_N);
 
     v >>= FIR_SHIFT;
 
@@ -1072,4 +1240,243 @@ int SID::clock_resample_fastmem(cycle_count& delta_t, short* buf, int n, int int
   return s;
 }
 
+// ----------------------------------------------------------------------------
+// DIRK: Silence detection.
+//
+// The chip is provably silent if all envelopes are frozen at zero, no write
+// is pending, and both filters have reached a fixed point. In this state,
+// the audio output stays constant until the next register access. Sample
+// synthesis is skipped and the elapsed cycles are applied when the silence
+// ends.
+// ----------------------------------------------------------------------------
+bool SID::detect_silence()
+{
+  if (silent) {
+    return true;
+  }
+
+  // Pipelined writes would change the chip state. The FASTMEM filter tables
+  // are not supported.
+  if (write_pipeline || sampling == SAMPLE_RESAMPLE_FASTMEM) {
+    return false;
+  }
+
+  // All voices must be muted. Any pipelined envelope or shift register
+  // clocking would be lost by delta clocking.
+  for (int i = 0; i < 3; i++) {
+    EnvelopeGenerator& envelope = voice[i].envelope;
+
+    if (envelope.envelope_counter || !envelope.hold_zero ||
+        envelope.state_pipeline || envelope.envelope_pipeline ||
+        voice[i].wave.shift_pipeline || envelope.output()) {
+      return false;
+    }
+  }
+
+  if (!filters_settled()) {
+    return false;
+  }
+
+  silent_level = output();
+
+  switch (sampling) {
+  case SAMPLE_INTERPOLATE:
+    sample_prev = sample_now = short(silent_level);
+    break;
+  case SAMPLE_RESAMPLE:
+    {
+      // All samples entering the convolution must be equal.
+      short* sample_start = sample + sample_index - fir_N - 1 + RINGSIZE;
+      for (int i = 0; i <= fir_N; i++) {
+        if (sample_start[i] != clip(silent_level)) {
+          return false;
+        }
+      }
+    }
+    break;
+  default:
+    break;
+  }
+
+  silent = true;
+  return true;
+}
+
+
+// ----------------------------------------------------------------------------
+// DIRK: Checks whether another clock cycle leaves the filters unchanged.
+// SAMPLE_FAST steps the filters by up to 3 and up to 8 cycles, hence all of
+// these step sizes are checked in this mode.
+// ----------------------------------------------------------------------------
+bool SID::filters_settled()
+{
+  auto same_filter = [](const Filter& a, const Filter& b) {
+    return
+      a.Vhp == b.Vhp && a.Vbp == b.Vbp && a.Vbp_x == b.Vbp_x &&
+      a.Vbp_vc == b.Vbp_vc && a.Vlp == b.Vlp && a.Vlp_x == b.Vlp_x &&
+      a.Vlp_vc == b.Vlp_vc && a.v1 == b.v1 && a.v2 == b.v2 && a.v3 == b.v3;
+  };
+  auto same_extfilt = [](const ExternalFilter& a, const ExternalFilter& b) {
+    return a.Vlp == b.Vlp && a.Vhp == b.Vhp;
+  };
+
+  short Vi = short(filter.output());
+  Filter f = filter;
+  ExternalFilter e = extfilt;
+
+  if (sampling != SAMPLE_FAST) {
+    f.clock(0, 0, 0);
+    e.clock(Vi);
+    return same_filter(f, filter) && same_extfilt(e, extfilt);
+  }
+
+  for (cycle_count delta_t = 1; delta_t <= 3; delta_t++) {
+    f = filter;
+    f.clock(delta_t, 0, 0, 0);
+    if (!same_filter(f, filter)) {
+      return false;
+    }
+  }
+  for (cycle_count delta_t = 1; delta_t <= 8; delta_t++) {
+    e = extfilt;
+    e.clock(delta_t, Vi);
+    if (!same_extfilt(e, extfilt)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+// ----------------------------------------------------------------------------
+// DIRK: SID clocking with audio sampling while the chip is silent.
+// The sample offset is advanced exactly like in the selected sampling method.
+// ----------------------------------------------------------------------------
+int SID::clock_silence(cycle_count& delta_t, short* buf, int n, int interleave)
+{
+  cycle_count rounding = sampling == SAMPLE_FAST ? 1 << (FIXP_SHIFT - 1) : 0;
+  int s;
+
+  for (s = 0; s < n; s++) {
+    cycle_count next_sample_offset = sample_offset + cycles_per_sample + rounding;
+    cycle_count delta_t_sample = next_sample_offset >> FIXP_SHIFT;
+
+    if (delta_t_sample > delta_t) {
+      delta_t_sample = delta_t;
+    }
+
+    silent_cycles += delta_t_sample;
+
+    if ((delta_t -= delta_t_sample) == 0) {
+      sample_offset -= delta_t_sample << FIXP_SHIFT;
+      break;
+    }
+
+    sample_offset = (next_sample_offset & FIXP_MASK) - rounding;
+
+    if (sampling == SAMPLE_RESAMPLE) {
+      // All samples in the ring buffer are equal, hence the convolutions
+      // reduce to multiplications with the filter table sums.
+      int fir_offset = sample_offset*fir_RES >> FIXP_SHIFT;
+      int fir_offset_rmd = sample_offset*fir_RES & FIXP_MASK;
+      int v1 = clip(silent_level)*fir_sum[fir_offset];
+      int v2 = clip(silent_level)*fir_sum[fir_offset + 1 == fir_RES ? 0 : fir_offset + 1];
+      int v = v1 + int((unsigned(fir_offset_rmd)*unsigned(v2 - v1)) >> FIXP_SHIFT);
+
+      buf[s*interleave] = clip(v >> FIR_SHIFT);
+    } else {
+      buf[s*interleave] = short(silent_level);
+    }
+  }
+
+  // Apply long silent phases in portions to keep the cycle count in range.
+  if (unlikely(silent_cycles > (1 << 20))) {
+    end_silence();
+    silent = true;
+  }
+
+  return s;
+}
+
+
+// ----------------------------------------------------------------------------
+// DIRK: Applies the cycles elapsed during silence. The voices are muted and
+// the filters are settled, so only the bus value, the envelope counters, and
+// the oscillators need to catch up.
+// ----------------------------------------------------------------------------
+void SID::end_silence()
+{
+  if (likely(!silent)) {
+    return;
+  }
+
+  cycle_count delta_t = silent_cycles;
+  silent = false;
+  silent_cycles = 0;
+
+  if (delta_t <= 0) {
+    return;
+  }
+
+  if (sampling == SAMPLE_FAST) {
+    clock_silence_delta(delta_t);
+    return;
+  }
+
+  // The cycle based sampling methods clock the chip cycle by cycle, which
+  // involves several pipelines not modeled by delta clocking. Hence, the
+  // cycles are applied one by one, skipping the settled filters.
+  for (; delta_t > 0; delta_t--) {
+    int i;
+
+    for (i = 0; i < 3; i++) {
+      voice[i].envelope.clock();
+    }
+    for (i = 0; i < 3; i++) {
+      voice[i].wave.clock();
+    }
+    for (i = 0; i < 3; i++) {
+      voice[i].wave.synchronize();
+    }
+    for (i = 0; i < 3; i++) {
+      voice[i].wave.set_waveform_output();
+    }
+
+    if (unlikely(!--bus_value_ttl)) {
+      bus_value = 0;
+    }
+  }
+}
+
+
+// ----------------------------------------------------------------------------
+// DIRK: Delta clocking with muted voices and settled filters.
+// ----------------------------------------------------------------------------
+void SID::clock_silence_delta(cycle_count delta_t)
+{
+  // Age bus value.
+  bus_value_ttl -= delta_t;
+  if (bus_value_ttl <= 0) {
+    bus_value = 0;
+    bus_value_ttl = 0;
+  }
+
+  // Clock amplitude modulators.
+  for (int i = 0; i < 3; i++) {
+    voice[i].envelope.clock(delta_t);
+  }
+
+  // Clock and synchronize oscillators. The accumulator increment is computed
+  // in 32 bits, hence the oscillators are clocked in chunks.
+  for (cycle_count remaining = delta_t; remaining > 0; remaining -= 0x10000) {
+    clock_oscillators(remaining < 0x10000 ? remaining : 0x10000);
+  }
+
+  // Calculate waveform output.
+  for (int i = 0; i < 3; i++) {
+    voice[i].wave.set_waveform_output(delta_t);
+  }
+}
+
 } // namespace reSID
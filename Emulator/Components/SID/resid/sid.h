@@ -52,6 +52,15 @@ public:
   void adjust_sampling_frequency(double sample_freq);
   void enable_raw_debug_output(bool enable);
 
+  // DIRK: Selects the vectorized or the portable FIR convolution kernel
+  static void enable_simd(bool enable);
+  static const char* simd_kernel();
+
+  // DIRK: Skips sample synthesis while the chip is provably silent
+  bool detect_silence();
+  int clock_silence(cycle_count& delta_t, short* buf, int n, int interleave = 1);
+  void end_silence();
+
   void clock();
   void clock(cycle_count delta_t);
   int clock(cycle_count& delta_t, short* buf, int n, int interleave = 1);
@@ -110,6 +119,9 @@ public:
   int clock_resample(cycle_count& delta_t, short* buf, int n, int interleave);
   int clock_resample_fastmem(cycle_count& delta_t, short* buf, int n, int interleave);
   void write();
+  void clock_oscillators(cycle_count delta_t);
+  bool filters_settled();
+  void clock_silence_delta(cycle_count delta_t);
 
   chip_model sid_model;
   Voice voice[3];
@@ -169,7 +181,16 @@ public:
   // FIR_RES filter tables (FIR_N*FIR_RES).
   short* fir;
 
+  // DIRK: Sums of the FIR_RES filter tables (FIR_RES).
+  int* fir_sum;
+
   bool raw_debug_output; // FIXME: should be private?
+
+  // DIRK: Silence detection. While the chip is silent, the elapsed cycles
+  // are accumulated and applied when the silence ends.
+  bool silent;
+  cycle_count silent_cycles;
+  int silent_level;
 };
 
 
@@ -59,7 +59,7 @@ DmaDebugger::visualizeDma(u32 *p, u8 data, MemAccess type)
 }
 
 void
-DmaDebugger::computeOverlay(u32 *emuTexture, u32 *dmaTexture)
+DmaDebugger::computeOverlay(u32 *emuTexture, const u32 *dmaTexture) const
 {
     double weight = config.dmaOpacity / 255.0;
     
@@ -70,7 +70,7 @@ DmaDebugger::computeOverlay(u32 *emuTexture, u32 *dmaTexture)
             for (isize y = 0; y < Texture::height; y++) {
 
                 u32 *emu = emuTexture + (y * Texture::width);
-                u32 *dma = dmaTexture + (y * Texture::width);
+                const u32 *dma = dmaTexture + (y * Texture::width);
 
                 for (isize x = 0; x < Texture::width; x++) {
 
@@ -89,7 +89,7 @@ DmaDebugger::computeOverlay(u32 *emuTexture, u32 *dmaTexture)
             for (isize y = 0; y < Texture::height; y++) {
 
                 u32 *emu = emuTexture + (y * Texture::width);
-                u32 *dma = dmaTexture + (y * Texture::width);
+                const u32 *dma = dmaTexture + (y * Texture::width);
 
                 for (isize x = 0; x < Texture::width; x++) {
 
@@ -109,7 +109,7 @@ DmaDebugger::computeOverlay(u32 *emuTexture, u32 *dmaTexture)
             for (isize y = 0; y < Texture::height; y++) {
 
                 u32 *emu = emuTexture + (y * Texture::width);
-                u32 *dma = dmaTexture + (y * Texture::width);
+                const u32 *dma = dmaTexture + (y * Texture::width);
 
                 for (isize x = 0; x < Texture::width; x++) {
 
@@ -135,7 +135,7 @@ DmaDebugger::cutLayers()
     // Only proceed if at least one channel is enabled
     if (!(config.cutLayers & 0x0F00)) return;
     
-    u32 *emuTexturePtr = vic.emuTexturePtr;
+    u8 *emuTexturePtr = vic.emuTexturePtr;
     u8 *zBuffer = vic.zBuffer;
     
     for (isize i = 0; i < Texture::width; i++) {
@@ -166,19 +166,11 @@ DmaDebugger::cutLayers()
                 cut = false;
         }
         
-        if (cut) {
-            
-            u8 r = emuTexturePtr[i] & 0xFF;
-            u8 g = (emuTexturePtr[i] >> 8) & 0xFF;
-            u8 b = (emuTexturePtr[i] >> 16) & 0xFF;
-
-            double scale = config.cutOpacity / 255.0;
-            u8 bg = (vic.scanline() / 4) % 2 == (i / 4) % 2 ? 0x22 : 0x44;
-            u8 newr = (u8)(r * (1 - scale) + bg * scale);
-            u8 newg = (u8)(g * (1 - scale) + bg * scale);
-            u8 newb = (u8)(b * (1 - scale) + bg * scale);
-            
-            emuTexturePtr[i] = 0xFF000000 | newb << 16 | newg << 8 | newr;
+        if (cut && emuTexturePtr[i] < 16) {
+
+            // Blending is done when the texture is converted to RGBA
+            bool dark = (vic.scanline() / 4) % 2 == (i / 4) % 2;
+            emuTexturePtr[i] += dark ? TEX_CUT_DARK : TEX_CUT_LIGHT;
         }
     }
 }
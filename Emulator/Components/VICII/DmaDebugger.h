@@ -143,7 +143,7 @@ public:
     void visualizeDma(u32 *ptr, u8 data, MemAccess type);
     
     // Superimposes the debug output onto the current scanline
-    void computeOverlay(u32 *emuTexture, u32 *dmaTexture);
+    void computeOverlay(u32 *emuTexture, const u32 *dmaTexture) const;
 
     
     //
@@ -15,6 +15,13 @@
 #include "Emulator.h"
 #include "IOUtils.h"
 
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define VICII_SSSE3 1
+#endif
+
 namespace vc64 {
 
 #define SPR0 0x01
@@ -46,6 +53,7 @@ void
 VICII::_initialize()
 {
     setRevision(config.revision);
+    clearLineCache();
 }
 
 void
@@ -73,27 +81,36 @@ VICII::_didReset(bool hard)
         upperComparisonVal = upperComparisonValue();
         lowerComparisonVal = lowerComparisonValue();
         
-        // Reset the screen buffer pointers
-        emuTexture = emuTexture1;
-        dmaTexture = dmaTexture1;
+        // Invalidate the RGBA texture and the scanline cache
+        textureStamp++;
+        clearLineCache();
     }
 }
 
+void
+VICII::_didLoad()
+{
+    // Discard the recorded inputs of the interrupted scanline
+    cachedLine = false;
+    clearLineCache();
+}
+
 void
 VICII::resetEmuTexture(isize nr)
 {
-    assert(nr == 1 || nr == 2);
+    assert(nr >= 0 && nr < 3);
 
-    if (nr == 1) { resetTexture(emuTexture1); }
-    if (nr == 2) { resetTexture(emuTexture2); }
+    resetTexture(emuTextures[nr]);
+    textureStamp++;
+    clearLineCache();
 }
 
 void
 VICII::resetDmaTexture(isize nr)
 {
-    assert(nr == 1 || nr == 2);
-    
-    u32 *p = nr == 1 ? dmaTexture1 : dmaTexture2;
+    assert(nr >= 0 && nr < 3);
+
+    u32 *p = dmaTextures[nr];
 
     for (int i = 0; i < Texture::height * Texture::width; i++) {
         p[i] = 0xFF000000;
@@ -101,7 +118,7 @@ VICII::resetDmaTexture(isize nr)
 }
 
 void
-VICII::resetTexture(u32 *p)
+VICII::resetTexture(u8 *p)
 {
     // Determine the HBLANK / VBLANK area
     long width = isPAL ? PAL::PIXELS_PER_LINE : NTSC::PIXELS_PER_LINE;
@@ -115,12 +132,12 @@ VICII::resetTexture(u32 *p)
             if (y < height && x < width) {
                 
                 // Draw black pixels inside the used area
-                p[pos] = 0xFF000000;
+                p[pos] = TEX_BLACK;
 
             } else {
 
                 // Draw a checkerboard pattern outside the used area
-                p[pos] = (y / 4) % 2 == (x / 8) % 2 ? 0xFF222222 : 0xFF444444;
+                p[pos] = (y / 4) % 2 == (x / 8) % 2 ? TEX_CHECKER_DARK : TEX_CHECKER_LIGHT;
             }
         }
     }
@@ -346,15 +363,237 @@ VICII::isVBlankLine(isize line) const
 }
 
 u32 *
-VICII::getTexture() const
+VICII::getTexture(i64 *nr) const
+{
+    {   util::AutoMutex _am(textureMutex);
+
+        pickUpFrame();
+        if (nr) *nr = frontFrame;
+
+        // Only convert the front texture once
+        if (rgbaStamp == textureStamp) return rgbaTextures[rgbaFront];
+        rgbaStamp = textureStamp;
+
+        // Convert the texture into the buffer that hasn't been handed out last
+        auto *rgba = rgbaTextures[rgbaFront ^ 1];
+        u32 lut[TEX_COLORS];
+
+        computeLut(lut);
+        convertTexture(emuTextures[frontBuffer], rgba, Texture::height * Texture::width, lut);
+
+        // Superimpose the DMA texture if requested
+        if (dmaDebugger.config.dmaDebug) {
+            dmaDebugger.computeOverlay(rgba, getDmaTexture());
+        }
+
+        rgbaFront ^= 1;
+        return rgba;
+    }
+}
+
+void
+VICII::copyFrontTexture(u32 *dst, i64 *nr) const
 {
-    return emuTexture == emuTexture1 ? emuTexture2 : emuTexture1;
+    {   util::AutoMutex _am(textureMutex);
+
+        pickUpFrame();
+        if (nr) *nr = frontFrame;
+
+        // Reuse the front texture if it has been converted already
+        if (rgbaStamp == textureStamp) {
+
+            std::memcpy(dst, rgbaTextures[rgbaFront], Texture::height * Texture::width * sizeof(u32));
+            return;
+        }
+
+        u32 lut[TEX_COLORS];
+
+        computeLut(lut);
+        convertTexture(emuTextures[frontBuffer], dst, Texture::height * Texture::width, lut);
+
+        // Superimpose the DMA texture if requested
+        if (dmaDebugger.config.dmaDebug) {
+            dmaDebugger.computeOverlay(dst, getDmaTexture());
+        }
+    }
+}
+
+void
+VICII::pickUpFrame() const
+{
+    // Swap in the latest completed frame if it hasn't been picked up yet
+    auto state = handoff.load();
+    while (state & 4) {
+
+        if (handoff.compare_exchange_weak(state, (state & ~u64(7)) | frontBuffer)) {
+
+            frontBuffer = isize(state & 3);
+            frontFrame = i64(state >> 3);
+            rgbaStamp = -1;
+            break;
+        }
+    }
+}
+
+void
+VICII::copyTexture(u32 *dst) const
+{
+    u32 lut[TEX_COLORS];
+
+    computeLut(lut);
+    convertTexture(emuTextures[stableBuffer], dst, Texture::height * Texture::width, lut);
+
+    // Superimpose the DMA texture if requested
+    if (dmaDebugger.config.dmaDebug) {
+        dmaDebugger.computeOverlay(dst, dmaTextures[stableBuffer]);
+    }
+}
+
+void
+VICII::computeLut(u32 *lut) const
+{
+    auto scale = dmaDebugger.config.cutOpacity / 255.0;
+
+    auto cut = [scale](u32 rgba, u8 bg) {
+
+        u8 r = u8((rgba & 0xFF) * (1 - scale) + bg * scale);
+        u8 g = u8(((rgba >> 8) & 0xFF) * (1 - scale) + bg * scale);
+        u8 b = u8(((rgba >> 16) & 0xFF) * (1 - scale) + bg * scale);
+        return u32(0xFF000000 | b << 16 | g << 8 | r);
+    };
+
+    for (isize i = 0; i < TEX_COLORS; i++) lut[i] = 0;
+
+    for (isize i = 0; i < 16; i++) {
+
+        lut[i] = rgbaTable[i];
+        lut[TEX_CUT_DARK + i] = cut(rgbaTable[i], 0x22);
+        lut[TEX_CUT_LIGHT + i] = cut(rgbaTable[i], 0x44);
+    }
+    lut[TEX_BLACK] = 0xFF000000;
+    lut[TEX_CHECKER_DARK] = 0xFF222222;
+    lut[TEX_CHECKER_LIGHT] = 0xFF444444;
 }
 
 u32 *
 VICII::getDmaTexture() const
 {
-    return dmaTexture == dmaTexture1 ? dmaTexture2 : dmaTexture1;
+    return dmaTextures[frontBuffer];
+}
+
+#ifdef VICII_SSSE3
+
+/* Translates 16 texels at once with pshufb. The kernel is compiled for SSSE3
+ * regardless of the build flags and only called if the host CPU supports it.
+ * It returns the number of translated texels.
+ */
+__attribute__((target("ssse3")))
+static isize convertTextureSSSE3(const u8 *src, u32 *dst, isize count, const u32 *lut)
+{
+    isize i = 0;
+
+    // Split the lookup table into four byte planes with 16 entries each
+    __m128i plane[4][TEX_COLORS / 16];
+    alignas(16) u8 bytes[4][TEX_COLORS];
+
+    for (isize j = 0; j < TEX_COLORS; j++) {
+        for (isize k = 0; k < 4; k++) bytes[k][j] = u8(lut[j] >> (8 * k));
+    }
+    for (isize k = 0; k < 4; k++) {
+        for (isize j = 0; j < TEX_COLORS / 16; j++) {
+            plane[k][j] = _mm_load_si128((const __m128i *)(bytes[k] + 16 * j));
+        }
+    }
+
+    const __m128i fifteen = _mm_set1_epi8(15);
+    const __m128i sixteen = _mm_set1_epi8(16);
+    const __m128i invalid = _mm_set1_epi8(char(0x80));
+
+    // Translate 16 texels at once
+    for (; i + 16 <= count; i += 16) {
+
+        __m128i idx = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i rgba[4];
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(idx, fifteen), idx)) == 0xFFFF) {
+
+            // Fast path: All texels are plain C64 colors
+            for (isize k = 0; k < 4; k++) rgba[k] = _mm_shuffle_epi8(plane[k][0], idx);
+
+        } else {
+
+            // Slow path: Combine the lookups into all table sections
+            for (isize k = 0; k < 4; k++) rgba[k] = _mm_setzero_si128();
+
+            __m128i sel = idx;
+            for (isize j = 0; j < TEX_COLORS / 16; j++, sel = _mm_sub_epi8(sel, sixteen)) {
+
+                // Mask out all texels outside the current table section
+                auto inside = _mm_cmpeq_epi8(_mm_min_epu8(sel, fifteen), sel);
+                auto shuffle = _mm_or_si128(sel, _mm_andnot_si128(inside, invalid));
+
+                for (isize k = 0; k < 4; k++) {
+                    rgba[k] = _mm_or_si128(rgba[k], _mm_shuffle_epi8(plane[k][j], shuffle));
+                }
+            }
+        }
+
+        // Interleave the byte planes
+        auto rg0 = _mm_unpacklo_epi8(rgba[0], rgba[1]);
+        auto rg1 = _mm_unpackhi_epi8(rgba[0], rgba[1]);
+        auto ba0 = _mm_unpacklo_epi8(rgba[2], rgba[3]);
+        auto ba1 = _mm_unpackhi_epi8(rgba[2], rgba[3]);
+
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_unpacklo_epi16(rg0, ba0));
+        _mm_storeu_si128((__m128i *)(dst + i + 4), _mm_unpackhi_epi16(rg0, ba0));
+        _mm_storeu_si128((__m128i *)(dst + i + 8), _mm_unpacklo_epi16(rg1, ba1));
+        _mm_storeu_si128((__m128i *)(dst + i + 12), _mm_unpackhi_epi16(rg1, ba1));
+    }
+
+    return i;
+}
+
+static const bool hasSSSE3 = __builtin_cpu_supports("ssse3");
+
+#endif
+
+void
+VICII::convertTexture(const u8 *src, u32 *dst, isize count, const u32 *lut)
+{
+    isize i = 0;
+
+#if defined(__aarch64__)
+
+    // Split the lookup table into four byte planes (R, G, B, A)
+    uint8x16x4_t plane[4];
+    u8 bytes[4][TEX_COLORS];
+
+    for (isize j = 0; j < TEX_COLORS; j++) {
+        for (isize k = 0; k < 4; k++) bytes[k][j] = u8(lut[j] >> (8 * k));
+    }
+    for (isize k = 0; k < 4; k++) plane[k] = vld1q_u8_x4(bytes[k]);
+
+    // Translate 16 texels at once
+    for (; i + 16 <= count; i += 16) {
+
+        uint8x16_t idx = vld1q_u8(src + i);
+        uint8x16x4_t rgba;
+
+        rgba.val[0] = vqtbl4q_u8(plane[0], idx);
+        rgba.val[1] = vqtbl4q_u8(plane[1], idx);
+        rgba.val[2] = vqtbl4q_u8(plane[2], idx);
+        rgba.val[3] = vqtbl4q_u8(plane[3], idx);
+        vst4q_u8((u8 *)(dst + i), rgba);
+    }
+
+#elif defined(VICII_SSSE3)
+
+    if (hasSSSE3) i = convertTextureSSSE3(src, dst, count, lut);
+
+#endif
+
+    // Translate the remaining texels
+    for (; i < count; i++) dst[i] = lut[src[i]];
 }
 
 void
@@ -363,6 +602,7 @@ VICII::updatePalette()
     for (isize i = 0; i < 16; i++) {
         rgbaTable[i] = monitor.getColor(i);
     }
+    textureStamp++;
 }
 
 u32 
@@ -694,6 +934,14 @@ VICII::turnSpriteDmaOn()
     }
     spriteDmaOnOff |= risingEdges;
     expansionFF |= risingEdges;
+
+    // Sprite data for the next scanline is fetched from now on
+    if (risingEdges) {
+
+        // Sprites are drawn on top of the canvas which must be drawn first
+        flushCachedLine();
+        collisionLine = true;
+    }
 }
 
 void
@@ -769,28 +1017,28 @@ VICII::endFrame()
     // Only proceed if the current frame hasn't been executed in headless mode
     if (c64.getHeadless()) return;
 
-    // Run the DMA debugger if enabled
-    bool debug = dmaDebugger.config.dmaDebug;
-    if (debug) dmaDebugger.computeOverlay(emuTexture, dmaTexture);
-
     // Switch texture buffers
-    if (emuTexture == emuTexture1) {
-        
-        assert(dmaTexture == dmaTexture1);
-        emuTexture = emuTexture2;
-        dmaTexture = dmaTexture2;
-        if (debug) { resetEmuTexture(2); resetDmaTexture(2); }
+    publishFrame();
 
-    } else {
-        
-        assert(emuTexture == emuTexture2);
-        assert(dmaTexture == dmaTexture2);
-        emuTexture = emuTexture1;
-        dmaTexture = dmaTexture1;
-        if (debug) { resetEmuTexture(1); resetDmaTexture(1); }
+    if (dmaDebugger.config.dmaDebug) {
+
+        resetEmuTexture(workingBuffer);
+        resetDmaTexture(workingBuffer);
     }
 }
 
+void
+VICII::publishFrame()
+{
+    // Swap the working buffer with the latest frame buffer
+    auto state = handoff.exchange(u64(c64.frame) << 3 | 4 | u64(workingBuffer));
+
+    stableBuffer = workingBuffer;
+    workingBuffer = isize(state & 3);
+    emuTexture = emuTextures[workingBuffer];
+    dmaTexture = dmaTextures[workingBuffer];
+}
+
 void
 VICII::processDelayedActions()
 {
@@ -854,6 +1102,16 @@ VICII::beginScanline()
     // Determine if we're inside the VBLANK area
     vblank = isVBlankLine(line);
 
+    // In headless mode, only draw scanlines with sprite activity
+    collisionLine = spriteDisplay | spriteDisplayDelayed | spriteSrActive | spriteDmaOnOff;
+
+    // Record scanlines without sprite activity if the scanline cache is used
+    auto cut = dmaDebugger.config.cutLayers;
+    bool cutting = (cut & 0x1000) && (cut & 0x0F00);
+    bool debugging = dmaDebugger.config.dmaDebug || cutting;
+    cachedLine = config.lineCache && !vblank && !collisionLine && !debugging && !c64.getHeadless();
+    if (cachedLine) beginCachedLine();
+
     // Increase the y counter (overflow is handled in cycle 2)
     if (!yCounterOverflow()) yCounter++;
     
@@ -872,7 +1130,10 @@ VICII::endScanline()
 {
     // Set vertical flipflop if condition was hit
     if (verticalFrameFFsetCond) setVerticalFrameFF(true);
-    
+
+    // Draw the scanline if it has been recorded
+    finishCachedLine();
+
     // Cut out layers if requested
     dmaDebugger.cutLayers();
 
@@ -104,12 +104,54 @@ struct SpriteSR : Serializable
     } SERIALIZERS(serialize);
 };
 
+/* Drawing inputs of a single cycle. Scanlines that are drawn via the
+ * scanline cache don't call the canvas and border routines right away.
+ * Instead, all values these routines depend on are recorded here.
+ */
+struct DrawRecord
+{
+    u32 gAccess;        // Delayed g-access result
+    u16 bufferoffset;   // First pixel of the 8 pixel chunk
+    u8  border;         // Border routine (0 = standard, 17, or 55)
+    u8  slowPath;       // Indicates a pending register update
+    u8  flipflops;      // Main, delayed main, and delayed vertical flipflop
+    u8  canLoad;        // Shift register load condition
+    u8  mode;           // Delayed display mode
+    u8  xscroll;        // Delayed x scroll value
+    u8  ctrl[2][2];     // D011 and D016 (delayed, current)
+    u8  colors[2][5];   // D020 - D024 (delayed, current)
+    u8  unused[2];
+};
+
+static_assert(sizeof(DrawRecord) == 28, "DrawRecord must not contain padding bytes");
+
+/* Drawing inputs of a whole scanline. A scanline is fully determined by the
+ * state of the graphics sequencer at the beginning of the line and by the
+ * drawing inputs of all visible cycles.
+ */
+struct LineRecord
+{
+    // Graphics sequencer state (data, mcFlop, latchedChr, latchedCol, colorbits)
+    u8 start[5];
+    u8 end[5];
+
+    // Number of recorded cycles
+    u8 count;
+
+    // Indicates if the stable texture has been drawn from this record
+    bool valid;
+
+    // Recorded cycles (one for each visible column)
+    DrawRecord cycles[48];
+};
+
 class VICII final : public SubComponent, public Inspectable<VICIIInfo, VICIIStats> {
 
     friend class Memory;
     friend class DmaDebugger;
     friend class VideoPort;
     friend class Reu;
+    friend class Benchmark;
     
     // REMOVE ASAP
     friend class Heatmap;
@@ -201,6 +243,7 @@ class VICII final : public SubComponent, public Inspectable<VICIIInfo, VICIIStat
 
         OPT_VICII_REVISION,
         OPT_VICII_POWER_SAVE,
+        OPT_VICII_LINE_CACHE,
         OPT_VICII_GRAY_DOT_BUG,
         OPT_GLUE_LOGIC,
         OPT_VICII_HIDE_SPRITES,
@@ -517,6 +560,19 @@ private:
 
     // True if the current scanline belongs to the VBLANK area
     bool vblank;
+
+    /* Indicates if the current scanline is drawn in headless mode. Scanlines
+     * that might contain sprite pixels are drawn to keep the collision
+     * registers exact.
+     */
+    bool collisionLine;
+
+    /* Indicates if the current scanline is drawn via the scanline cache. In
+     * this case, the drawing inputs are recorded and the scanline is drawn in
+     * endScanline(), either by copying it from the stable texture or by
+     * replaying the recorded cycles.
+     */
+    bool cachedLine;
     
     // Indicates if the current scanline is a DMA line (bad line)
     bool badLine;
@@ -579,7 +635,9 @@ private:
      */
     u8 cleared_bits_in_d017;
     
-    // Collision bits
+    /* Collision bits. For each sprite, the pixels drawn in the current cycle
+     * are recorded (pixel 0 in bit 7).
+     */
     u8 collision[8];
     
     
@@ -694,37 +752,88 @@ private:
     u32 rgbaTable[16];
 
     /* Texture buffers. VICII outputs the generated texture into these buffers.
-     * At any time, one buffer is the working buffer and the other one is the
-     * stable buffer. While VICII always writes into the working buffer, the
-     * GUI accesses the stable buffer at a constant frame rate and copies it
-     * into the texture RAM of the graphics card.
+     * The three buffers form a triple buffer. At any time, VICII owns one
+     * buffer (the working buffer), the consumer side owns another one (the
+     * front buffer), and the third one holds the latest completed frame.
+     * When a frame has been completed, VICII swaps the working buffer with the
+     * latest frame buffer. When the texture is requested, the front buffer is
+     * swapped with the latest frame buffer if it contains a newer frame. Both
+     * swaps are carried out atomically. Hence, the consumer side never sees a
+     * half-drawn frame and the emulator thread never waits for a consumer.
      *
      * The emuTexture buffers contain the emulator texture. It is the texture
-     * that is usually drawn by the GUI. The dmaTexture buffers contain the
+     * that is usually drawn by the GUI. To keep memory traffic low, VICII
+     * stores color indices (see TEX_COLORS) which are translated into RGBA
+     * values when the texture is requested. The dmaTexture buffers contain the
      * texture generated by the DMA debugger. If DMA debugging is enabled, this
      * texture is superimposed on the emulator texture.
      */
-    u32 *emuTexture1 = new u32[Texture::height * Texture::width];
-    u32 *emuTexture2 = new u32[Texture::height * Texture::width];
-    u32 *dmaTexture1 = new u32[Texture::height * Texture::width];
-    u32 *dmaTexture2 = new u32[Texture::height * Texture::width];
+    u8 *emuTextures[3] = {
+
+        new u8[Texture::height * Texture::width],
+        new u8[Texture::height * Texture::width],
+        new u8[Texture::height * Texture::width]
+    };
+    u32 *dmaTextures[3] = {
+
+        new u32[Texture::height * Texture::width],
+        new u32[Texture::height * Texture::width],
+        new u32[Texture::height * Texture::width]
+    };
+
+    /* Handoff state of the triple buffer. Bits 0 and 1 contain the index of
+     * the buffer holding the latest completed frame. Bit 2 is set if this
+     * frame hasn't been picked up by the consumer side yet. The remaining bits
+     * contain the frame number.
+     */
+    mutable std::atomic<u64> handoff = 1;
 
-    /* Pointer to the current working texture. This variable points either to
-     * the first or the second texture buffer. After a frame has been finished,
-     * the pointer is redirected to the other buffer.
+    // Buffer roles (working, last completed, and front buffer)
+    isize workingBuffer = 0;
+    isize stableBuffer = 1;
+    mutable isize frontBuffer = 2;
+
+    // Frame number of the front buffer
+    mutable i64 frontFrame = 0;
+
+    /* Pointer to the current working texture. After a frame has been
+     * finished, the pointer is redirected to the new working buffer.
      */
-    u32 *emuTexture;
-    u32 *dmaTexture;
+    u8 *emuTexture = emuTextures[0];
+    u32 *dmaTexture = dmaTextures[0];
 
     /* Pointer to the beginning of the current scanline inside the current
      * working textures. These pointers are used by all rendering methods to
-     * write pixels. It always points to the beginning of a scanline, either
-     * the first or the second texture buffer. They are reset at the beginning
-     * of each frame and incremented at the beginning of each scanline.
+     * write pixels. It always points to the beginning of a scanline inside
+     * the working buffer. They are reset at the beginning of each frame and
+     * incremented at the beginning of each scanline.
      */
-    u32 *emuTexturePtr;
+    u8 *emuTexturePtr;
     u32 *dmaTexturePtr;
 
+    /* The front texture in RGBA format. It is computed on demand by
+     * getTexture() and alternates between two buffers. Hence, the texture
+     * handed out to a consumer stays intact while the next one is converted,
+     * but it is overwritten by the next but one call. For this reason,
+     * getTexture() is meant for a single consumer, usually the renderer of
+     * the GUI. All other consumers call copyFrontTexture(), which copies the
+     * front texture while holding the texture mutex.
+     * The stamps indicate if the front buffer is up to date. The first one is
+     * increased whenever the conversion parameters change, the second one
+     * records the value of the first one at the time of the last conversion.
+     * The emulator thread doesn't acquire the texture mutex. It converts the
+     * latest completed frame into a buffer of its own via copyTexture().
+     */
+    u32 *rgbaTextures[2] = {
+
+        new u32[Texture::height * Texture::width],
+        new u32[Texture::height * Texture::width]
+    };
+    mutable isize rgbaFront = 0;
+    std::atomic<i64> textureStamp = 0;
+    mutable i64 rgbaStamp = -1;
+    mutable util::ReentrantMutex textureMutex;
+
     /* VICII utilizes a depth buffer to determine pixel priority. The render
      * routines only write a color value, if it is closer to the view point.
      * The depth of the closest pixel is kept in this buffer. The lower the
@@ -739,6 +848,13 @@ private:
      */
     short bufferoffset;
 
+    /* Scanline cache. For each scanline of the stable texture, the cache
+     * stores the inputs the scanline has been drawn from. The second record
+     * collects the inputs of the current scanline.
+     */
+    LineRecord *lineCache = new LineRecord[Texture::height];
+    LineRecord pendingLine;
+
     
     //
     // Debugging
@@ -801,6 +917,9 @@ public:
         CLONE(lineMatchesIrqLine)
         CLONE(isVisibleColumn)
         CLONE(vblank)
+        CLONE(collisionLine)
+        CLONE(cachedLine)
+        CLONE(pendingLine)
         CLONE(badLine)
         CLONE(DENwasSetInLine30)
         CLONE(displayState)
@@ -839,6 +958,7 @@ public:
 
         CLONE(config)
 
+        clearLineCache();
         updateVicFunctionTable();
         return *this;
     }
@@ -955,6 +1075,7 @@ private:
     void _dump(Category category, std::ostream& os) const override;
     void _initialize() override;
     void _didReset(bool hard) override;
+    void _didLoad() override;
     void _trackOn() override;
     void _trackOff() override;
 
@@ -1001,10 +1122,10 @@ private:
 private:
 
     void resetEmuTexture(isize nr);
-    void resetEmuTextures() { resetEmuTexture(1); resetEmuTexture(2); }
+    void resetEmuTextures() { for (isize i = 0; i < 3; i++) resetEmuTexture(i); }
     void resetDmaTexture(isize nr);
-    void resetDmaTextures() { resetDmaTexture(1); resetDmaTexture(2); }
-    void resetTexture(u32 *p);
+    void resetDmaTextures() { for (isize i = 0; i < 3; i++) resetDmaTexture(i); }
+    void resetTexture(u8 *p);
 
     void initFuncTable(VICIIRevision revision);
     void initFuncTable(VICIIRevision revision, u16 flags);
@@ -1081,10 +1202,45 @@ public:
 
 private:
 
-    // Returns pointers to the stable textures
-    u32 *getTexture() const;
+    /* Returns pointers to the front textures. Before the emulator texture is
+     * returned, the front buffer is replaced by the latest completed frame if
+     * a new one is available. The frame number is optionally returned in nr.
+     */
+    u32 *getTexture(i64 *nr = nullptr) const;
     u32 *getDmaTexture() const;
 
+    /* Copies the front texture into dst. Unlike the pointer returned by
+     * getTexture(), the copy can't be overwritten. Hence, this function can
+     * be called by any number of consumers.
+     */
+    void copyFrontTexture(u32 *dst, i64 *nr = nullptr) const;
+
+    // Swaps in the latest completed frame (the caller holds the texture mutex)
+    void pickUpFrame() const;
+
+    /* Converts the latest completed frame into an RGBA texture. This function
+     * is meant for the emulator thread. It neither locks nor touches the front
+     * buffer, because the emulator thread never writes the stable buffer.
+     */
+    void copyTexture(u32 *dst) const;
+
+    // Returns the latest completed frame in indexed format (emulator thread only)
+    const u8 *getIndexedTexture() const { return emuTextures[stableBuffer]; }
+
+    // Sets up the lookup table translating color indices into RGBA values
+    void computeLut(u32 *lut) const;
+
+    // Returns the number of the latest completed frame (lock-free)
+    i64 getLatestFrame() const { return i64(handoff.load() >> 3); }
+
+    // Hands a completed frame over to the consumer side
+    void publishFrame();
+
+public:
+
+    // Translates color indices into RGBA values
+    static void convertTexture(const u8 *src, u32 *dst, isize count, const u32 *lut);
+
 
     //
     // Accessing memory (VIC_memory.cpp)
@@ -1447,26 +1603,29 @@ public:
     template <u16 flags> void cycle64();
     template <u16 flags> void cycle65();
 
+// Indicates if pixels are drawn in the current cycle
+#define DRAWING (!(flags & HEADLESS_CYCLE) || collisionLine)
+
 #define DRAW_SPRITES_DMA1 \
 assert(isFirstDMAcycle); assert(!isSecondDMAcycle); \
-if constexpr (!(flags & HEADLESS_CYCLE)) { drawSpritesSlowPath(); }
+if (DRAWING) { drawSpritesSlowPath(); }
 
 #define DRAW_SPRITES_DMA2 \
 assert(!isFirstDMAcycle); assert(isSecondDMAcycle); \
-if constexpr (!(flags & HEADLESS_CYCLE)) { drawSpritesSlowPath(); }
+if (DRAWING) { drawSpritesSlowPath(); }
 
 #define DRAW_SPRITES \
 assert(!isFirstDMAcycle && !isSecondDMAcycle); \
-if (spriteDisplay && !(flags & HEADLESS_CYCLE)) { drawSprites(); }
+if (spriteDisplay && DRAWING) { drawSprites(); }
 
 #define DRAW_SPRITES59 \
-if ((spriteDisplayDelayed || spriteDisplay || isSecondDMAcycle) && !(flags & HEADLESS_CYCLE)) \
+if ((spriteDisplayDelayed || spriteDisplay || isSecondDMAcycle) && DRAWING) \
 { drawSpritesSlowPath(); }
     
-#define DRAW   if (!vblank && !(flags & HEADLESS_CYCLE)) { drawCanvas(); drawBorder(); };
-#define DRAW17 if (!vblank && !(flags & HEADLESS_CYCLE)) { drawCanvas(); drawBorder17(); };
-#define DRAW55 if (!vblank && !(flags & HEADLESS_CYCLE)) { drawCanvas(); drawBorder55(); };
-#define DRAW59 if (!vblank && !(flags & HEADLESS_CYCLE)) { drawCanvas(); drawBorder(); };
+#define DRAW   if (cachedLine) { recordCycle(0); } else if (!vblank && DRAWING) { drawCanvas(); drawBorder(); };
+#define DRAW17 if (cachedLine) { recordCycle(17); } else if (!vblank && DRAWING) { drawCanvas(); drawBorder17(); };
+#define DRAW55 if (cachedLine) { recordCycle(55); } else if (!vblank && DRAWING) { drawCanvas(); drawBorder55(); };
+#define DRAW59 if (cachedLine) { recordCycle(0); } else if (!vblank && DRAWING) { drawCanvas(); drawBorder(); };
 
 #define END_CYCLE \
 dataBusPhi2 = 0xFF; \
@@ -1495,16 +1654,36 @@ private:
     // Draws the border pixels in cycle 55
     void drawBorder55();
     
-    // Draws 8 canvas pixels
+    // Draws 8 canvas pixels (V selects the vectorized fast path)
     void drawCanvas();
-    void drawCanvasFastPath();
+    template <bool V = true> void drawCanvasFastPath();
     void drawCanvasSlowPath();
 
+    // Draws 8 canvas pixels with a few 64-bit operations (fast path)
+    void drawCanvasVectorized();
+
     // Draws a single canvas pixel
     void drawCanvasPixel(u8 pixel, u8 mode, u8 d016);
     
     // Reloads the sequencer shift register with the gAccess result
     void loadShiftRegister();
+
+    // Records the drawing inputs of the current cycle
+    void recordCycle(u8 border);
+
+    // Draws all recorded cycles of the current scanline
+    void replayCycles();
+
+    /* Starts, interrupts, and completes a scanline that is drawn via the
+     * scanline cache. If the scanline is interrupted, all recorded cycles are
+     * drawn and the remaining cycles are drawn directly.
+     */
+    void beginCachedLine();
+    void flushCachedLine();
+    void finishCachedLine();
+
+    // Invalidates all cached scanlines
+    void clearLineCache();
     
     //
     // Drawing routines (VIC_sprites.cpp)
@@ -1512,15 +1691,17 @@ private:
     
 private:
     
-    // Draws 8 sprite pixels (see draw())
+    // Draws 8 sprite pixels (T selects the table-driven fast path)
     void drawSprites();
-    void drawSpritesFastPath();
+    template <bool T = true> void drawSpritesFastPath();
     void drawSpritesSlowPath();
     
-    /* Draws all sprite pixels for a single sprite. This function is used when
-     * the fast path is taken.
+    /* Draws all sprite pixels for a single sprite. These functions are used
+     * when the fast path is taken. Pixels marked in the occupied mask have
+     * already been drawn by a sprite with a lower number.
      */
-    template <bool multicolor> void drawSpriteNr(isize nr, bool enable, bool active);
+    template <bool multicolor> void drawSpriteNr(isize nr, bool enable, bool active, u8 occupied);
+    void drawSpriteNrTabulated(isize nr, bool enable, bool active, u8 occupied);
 
     /* Draws a single sprite pixel for all sprites. This function is used when
      * the slow path is taken.
@@ -1541,7 +1722,7 @@ private:
     
     // Writes a single color value into the screenbuffer
 #define COLORIZE(index,color) \
-emuTexturePtr[index] = rgbaTable[color];
+emuTexturePtr[index] = u8(color);
     
     // Sets a single frame pixel
 #define SET_FRAME_PIXEL(pixel,color) { \
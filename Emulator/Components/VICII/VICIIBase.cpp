@@ -174,6 +174,7 @@ VICII::clearStats()
         double canvasTotal = stats.canvasFastPath + stats.canvasSlowPath;
         double spriteTotal = stats.spriteFastPath + stats.spriteSlowPath;
         double exitTotal = stats.quickExitHit + stats.quickExitMiss;
+        double lineTotal = stats.lineCacheHit + stats.lineCacheMiss;
 
         msg("Canvas: Fast path: %ld Slow path: %ld Ratio: %f\n",
             stats.canvasFastPath,
@@ -190,6 +191,11 @@ VICII::clearStats()
             stats.quickExitMiss,
             exitTotal != 0 ? stats.quickExitHit / exitTotal : -1);
 
+        msg("Scanlines: Hit: %ld Miss: %ld Ratio: %f\n",
+            stats.lineCacheHit,
+            stats.lineCacheMiss,
+            lineTotal != 0 ? stats.lineCacheHit / lineTotal : -1);
+
         memset(&stats, 0, sizeof(stats));
     }
 }
@@ -207,6 +213,7 @@ VICII::getOption(Option option) const
 
         case OPT_VICII_REVISION:        return config.awaiting;
         case OPT_VICII_POWER_SAVE:      return config.powerSave;
+        case OPT_VICII_LINE_CACHE:      return config.lineCache;
         case OPT_VICII_GRAY_DOT_BUG:    return config.grayDotBug;
         case OPT_GLUE_LOGIC:            return config.glueLogic;
         case OPT_VICII_HIDE_SPRITES:    return config.hideSprites;
@@ -231,6 +238,7 @@ VICII::checkOption(Option opt, i64 value)
             return;
 
         case OPT_VICII_POWER_SAVE:
+        case OPT_VICII_LINE_CACHE:
         case OPT_VICII_GRAY_DOT_BUG:
         case OPT_VICII_HIDE_SPRITES:
         case OPT_VICII_SS_COLLISIONS:
@@ -271,6 +279,12 @@ VICII::setOption(Option opt, i64 value)
             config.powerSave = bool(value);
             return;
 
+        case OPT_VICII_LINE_CACHE:
+
+            config.lineCache = bool(value);
+            clearLineCache();
+            return;
+
         case OPT_VICII_GRAY_DOT_BUG:
 
             config.grayDotBug = bool(value);
@@ -13,19 +13,57 @@
 #include "config.h"
 #include "VICII.h"
 #include "C64.h"
+#include <array>
+#include <bit>
 
 namespace vc64 {
 
+/* The vectorized drawing routines process 8 pixels in a single 64-bit word.
+ * Byte n of the word (in memory order) corresponds to pixel n. Bit planes
+ * store pixel 0 in bit 7 and pixel 7 in bit 0, matching the order in which
+ * the sequencer shifts out the graphics data.
+ */
+static constexpr auto laneMask = []() {
+
+    std::array<u64, 256> result = { };
+
+    for (isize plane = 0; plane < 256; plane++) {
+        for (isize pixel = 0; pixel < 8; pixel++) {
+
+            if (!(plane & (0x80 >> pixel))) continue;
+
+            auto byte = std::endian::native == std::endian::little ? pixel : 7 - pixel;
+            result[plane] |= u64(0xFF) << (8 * byte);
+        }
+    }
+    return result;
+}();
+
+// Replicates a byte into all eight lanes
+static constexpr u64 splat(u8 value) { return value * 0x0101010101010101; }
+
+// Selects one out of four colors per lane based on two bit planes
+static inline u64 selectColors(u8 hi, u8 lo, u32 colors)
+{
+    auto h = laneMask[hi];
+    auto l = laneMask[lo];
+
+    auto c01 = (~l & splat(u8(colors))) | (l & splat(u8(colors >> 8)));
+    auto c23 = (~l & splat(u8(colors >> 16))) | (l & splat(u8(colors >> 24)));
+
+    return (~h & c01) | (h & c23);
+}
+
 void
 VICII::drawBorder()
 {
     if (flipflops.delayed.main) {
-        
-        SET_FRAME_PIXEL(0, reg.delayed.colors[COLREG_BORDER]);
-        
-        for (isize pixel = 1; pixel <= 7; pixel++) {
-            SET_FRAME_PIXEL(pixel, reg.current.colors[COLREG_BORDER]);
-        }
+
+        u64 color = splat(reg.current.colors[COLREG_BORDER]);
+
+        memcpy(emuTexturePtr + bufferoffset, &color, 8);
+        memset(zBuffer + bufferoffset, DEPTH_BORDER, 8);
+        emuTexturePtr[bufferoffset] = reg.delayed.colors[COLREG_BORDER];
     }
 }
 
@@ -35,10 +73,11 @@ VICII::drawBorder17()
     if (flipflops.delayed.main && !flipflops.current.main) {
         
         // 38 column mode (only pixels 0...6 are drawn)
-        SET_FRAME_PIXEL(0, reg.delayed.colors[COLREG_BORDER]);
-        for (isize pixel = 1; pixel <= 6; pixel++) {
-            SET_FRAME_PIXEL(pixel, reg.current.colors[COLREG_BORDER]);
-        }
+        u64 color = splat(reg.current.colors[COLREG_BORDER]);
+
+        memcpy(emuTexturePtr + bufferoffset, &color, 7);
+        memset(zBuffer + bufferoffset, DEPTH_BORDER, 7);
+        emuTexturePtr[bufferoffset] = reg.delayed.colors[COLREG_BORDER];
         
     } else {
         
@@ -71,11 +110,20 @@ VICII::drawCanvas()
     }
 }
 
-void
+template <bool V> void
 VICII::drawCanvasFastPath()
 {
     if (VICII_STATS) stats.canvasFastPath++;
-    
+
+    if constexpr (V) {
+
+        if (reg.delayed.mode <= DISPLAY_MODE_EXTENDED_BG_COLOR) {
+
+            drawCanvasVectorized();
+            return;
+        }
+    }
+
     u8 xscroll = reg.delayed.xscroll;
     
     switch (reg.delayed.mode) {
@@ -196,6 +244,128 @@ VICII::drawCanvasFastPath()
     }
 }
 
+void
+VICII::drawCanvasVectorized()
+{
+    /* The 8 pixels are split into two segments. Pixels 0 ... xscroll - 1 are
+     * synthesized from the old shift register contents, the remaining pixels
+     * from the reloaded register. If the register doesn't reload, the first
+     * segment covers all pixels.
+     */
+    u8 xscroll = reg.delayed.xscroll;
+    bool reload = !flipflops.delayed.vertical && sr.canLoad;
+    u8 second = reload ? u8(0xFF >> xscroll) : 0;
+
+    auto &colors = reg.delayed.colors;
+
+    /* Computes the bit planes and the color table of a segment. Each pixel is
+     * described by a two bit color code (hi, lo) which is translated into one
+     * of four colors. The fg plane marks all foreground pixels.
+     */
+    auto synthesize = [&](u8 data, u8 chr, u8 col, bool flop,
+                          u8 &hi, u8 &lo, u8 &fg, u32 &table) {
+
+        bool mc;
+
+        switch (reg.delayed.mode) {
+
+            case DISPLAY_MODE_STANDARD_TEXT:
+
+                mc = false;
+                table = colors[COLREG_BG0] | col << 8;
+                break;
+
+            case DISPLAY_MODE_MULTICOLOR_TEXT:
+
+                if ((mc = col & 0x8)) {
+                    table = HI_HI_LO_LO(col & 0x07, colors[COLREG_BG2], colors[COLREG_BG1], colors[COLREG_BG0]);
+                } else {
+                    table = colors[COLREG_BG0] | col << 8;
+                }
+                break;
+
+            case DISPLAY_MODE_STANDARD_BITMAP:
+
+                mc = false;
+                table = LO_NIBBLE(chr) | HI_NIBBLE(chr) << 8;
+                break;
+
+            case DISPLAY_MODE_MULTICOLOR_BITMAP:
+
+                mc = true;
+                table = HI_HI_LO_LO(col, LO_NIBBLE(chr), HI_NIBBLE(chr), colors[COLREG_BG0]);
+                break;
+
+            default:
+
+                mc = false;
+                table = colors[COLREG_BG0 + (chr >> 6)] | col << 8;
+                break;
+        }
+
+        if (!mc) {
+
+            // Each pixel is determined by a single bit
+            hi = 0;
+            lo = fg = data;
+
+        } else if (flop) {
+
+            // Each pair of pixels is determined by two bits
+            hi = (data & 0xAA) | (data & 0xAA) >> 1;
+            lo = (data & 0x55) | (data & 0x55) << 1;
+            fg = hi;
+
+        } else {
+
+            // The first pixel repeats the color bits of the previous pixel
+            hi = (data & 0x55) | (data & 0x55) >> 1 | (sr.colorbits & 0x2) << 6;
+            lo = (data & 0x2A) | (data & 0x2A) << 1 | (sr.colorbits & 0x1) << 7;
+            fg = hi;
+        }
+    };
+
+    u8 hi, lo, fg, hi2, lo2, fg2;
+    u32 table, table2;
+
+    // Synthesize the first segment
+    synthesize(sr.data, sr.latchedChr, sr.latchedCol, sr.mcFlop, hi, lo, fg, table);
+    u64 color = selectColors(hi, lo, table);
+
+    if (reload) {
+
+        loadShiftRegister();
+
+        // Synthesize the second segment
+        synthesize(sr.data, sr.latchedChr, sr.latchedCol, true, hi2, lo2, fg2, table2);
+        hi2 >>= xscroll; lo2 >>= xscroll; fg2 >>= xscroll;
+
+        u64 mask = laneMask[second];
+        color = (color & ~mask) | (selectColors(hi2, lo2, table2) & mask);
+
+        hi = (hi & ~second) | hi2;
+        lo = (lo & ~second) | lo2;
+        fg = (fg & ~second) | fg2;
+
+        // Run the shift register and the multicolor flipflop
+        sr.data = u8(sr.data << (8 - xscroll));
+        sr.mcFlop = !(xscroll & 1);
+
+    } else {
+
+        sr.data = 0;
+    }
+
+    // The color bits of the last pixel are kept
+    sr.colorbits = u8((hi & 1) << 1 | (lo & 1));
+
+    // Write pixels and depth values
+    u64 depth = (laneMask[fg] & splat(DEPTH_FG)) | (~laneMask[fg] & splat(DEPTH_BG));
+
+    memcpy(emuTexturePtr + bufferoffset, &color, 8);
+    memcpy(zBuffer + bufferoffset, &depth, 8);
+}
+
 void
 VICII::drawCanvasSlowPath()
 {
@@ -375,4 +545,166 @@ VICII::loadShiftRegister()
     }
 }
 
+void
+VICII::recordCycle(u8 border)
+{
+    assert(pendingLine.count < 48);
+
+    auto &r = pendingLine.cycles[pendingLine.count++];
+    bool load = !flipflops.delayed.vertical && sr.canLoad;
+
+    // The g-access result only matters if the shift register is reloaded
+    r.gAccess = load ? gAccessResult.delayed() : 0;
+    r.bufferoffset = u16(bufferoffset);
+    r.border = border;
+    r.slowPath = (delay & VICUpdateRegisters) ? 1 : 0;
+    r.flipflops = u8(flipflops.current.main | flipflops.delayed.main << 1 | flipflops.delayed.vertical << 2);
+    r.canLoad = sr.canLoad;
+    r.mode = u8(reg.delayed.mode);
+    r.xscroll = reg.delayed.xscroll;
+    r.ctrl[0][0] = reg.delayed.ctrl1;
+    r.ctrl[0][1] = reg.delayed.ctrl2;
+    r.ctrl[1][0] = reg.current.ctrl1;
+    r.ctrl[1][1] = reg.current.ctrl2;
+    memcpy(r.colors[0], reg.delayed.colors + COLREG_BORDER, 5);
+    memcpy(r.colors[1], reg.current.colors + COLREG_BORDER, 5);
+    r.unused[0] = r.unused[1] = 0;
+}
+
+void
+VICII::replayCycles()
+{
+    // Save all values that are overwritten by the recorded inputs
+    auto savedReg = reg;
+    auto savedFlipflops = flipflops;
+    auto savedCanLoad = sr.canLoad;
+    auto savedDelay = delay;
+    auto savedOffset = bufferoffset;
+    auto savedAccess = gAccessResult;
+
+    for (isize i = 0; i < pendingLine.count; i++) {
+
+        auto &r = pendingLine.cycles[i];
+
+        gAccessResult.reset(r.gAccess);
+        bufferoffset = r.bufferoffset;
+        delay = r.slowPath ? VICUpdateRegisters : 0;
+        flipflops.current.main = r.flipflops & 1;
+        flipflops.delayed.main = r.flipflops & 2;
+        flipflops.delayed.vertical = r.flipflops & 4;
+        sr.canLoad = r.canLoad;
+        reg.delayed.mode = DisplayMode(r.mode);
+        reg.delayed.xscroll = r.xscroll;
+        reg.delayed.ctrl1 = r.ctrl[0][0];
+        reg.delayed.ctrl2 = r.ctrl[0][1];
+        reg.current.ctrl1 = r.ctrl[1][0];
+        reg.current.ctrl2 = r.ctrl[1][1];
+        memcpy(reg.delayed.colors + COLREG_BORDER, r.colors[0], 5);
+        memcpy(reg.current.colors + COLREG_BORDER, r.colors[1], 5);
+
+        drawCanvas();
+
+        switch (r.border) {
+
+            case 17: drawBorder17(); break;
+            case 55: drawBorder55(); break;
+            default: drawBorder(); break;
+        }
+    }
+
+    reg = savedReg;
+    flipflops = savedFlipflops;
+    sr.canLoad = savedCanLoad;
+    delay = savedDelay;
+    bufferoffset = savedOffset;
+    gAccessResult = savedAccess;
+}
+
+void
+VICII::beginCachedLine()
+{
+    pendingLine.start[0] = sr.data;
+    pendingLine.start[1] = sr.mcFlop;
+    pendingLine.start[2] = sr.latchedChr;
+    pendingLine.start[3] = sr.latchedCol;
+    pendingLine.start[4] = sr.colorbits;
+    pendingLine.count = 0;
+}
+
+void
+VICII::flushCachedLine()
+{
+    if (cachedLine) {
+
+        replayCycles();
+        lineCache[c64.scanline].valid = false;
+        cachedLine = false;
+    }
+}
+
+void
+VICII::finishCachedLine()
+{
+    auto &entry = lineCache[c64.scanline];
+
+    // Scanlines of rendered frames that are drawn directly are not cached
+    if (!cachedLine) {
+
+        if (!c64.getHeadless()) entry.valid = false;
+        return;
+    }
+
+    auto &p = pendingLine;
+    cachedLine = false;
+
+    if (entry.valid && entry.count == p.count &&
+        memcmp(entry.start, p.start, sizeof(p.start)) == 0 &&
+        memcmp(entry.cycles, p.cycles, p.count * sizeof(DrawRecord)) == 0) {
+
+        // The stable texture contains the very same scanline
+        if (p.count) {
+
+            auto *stable = emuTextures[stableBuffer];
+            auto first = p.cycles[0].bufferoffset;
+            auto last = p.cycles[p.count - 1].bufferoffset + 8;
+            auto offset = (emuTexturePtr - emuTexture) + first;
+
+            memcpy(emuTexturePtr + first, stable + offset, last - first);
+        }
+
+        // Bring the graphics sequencer into the state it had after drawing
+        sr.data = entry.end[0];
+        sr.mcFlop = entry.end[1];
+        sr.latchedChr = entry.end[2];
+        sr.latchedCol = entry.end[3];
+        sr.colorbits = entry.end[4];
+
+        stats.lineCacheHit++;
+
+    } else {
+
+        replayCycles();
+
+        p.end[0] = sr.data;
+        p.end[1] = sr.mcFlop;
+        p.end[2] = sr.latchedChr;
+        p.end[3] = sr.latchedCol;
+        p.end[4] = sr.colorbits;
+        p.valid = true;
+
+        memcpy(&entry, &p, offsetof(LineRecord, cycles) + p.count * sizeof(DrawRecord));
+
+        stats.lineCacheMiss++;
+    }
+}
+
+void
+VICII::clearLineCache()
+{
+    for (isize i = 0; i < Texture::height; i++) lineCache[i].valid = false;
+}
+
+template void VICII::drawCanvasFastPath<false>();
+template void VICII::drawCanvasFastPath<true>();
+
 }
@@ -12,9 +12,107 @@
 
 #include "config.h"
 #include "VICII.h"
+#include <array>
+#include <bit>
 
 namespace vc64 {
 
+/* Sprite expansion tables
+ *
+ * The table-driven fast path runs the shift register of a sprite for up to 8
+ * pixels at once. Which bits end up in which pixel depends on the color mode
+ * (hires or multicolor), on the X expansion bit, and on the state of the
+ * expansion and the multicolor flipflop. For each of these 16 configurations,
+ * the table maps the next 8 bits of the shift register onto two bit planes
+ * which hold the color bits of the 8 pixels (pixel 0 in bit 7). Pixels drawn
+ * before the first color bits are loaded repeat the color bits of the
+ * previous pixel. They are marked in the carry mask.
+ */
+struct SpriteExpansion {
+
+    // Bit planes (hi plane in the upper byte) indexed by the next 8 data bits
+    u16 planes[256];
+
+    // Pixels repeating the color bits of the previous pixel
+    u8 carry;
+
+    // Pixels in which the shift register is shifted
+    u8 shifts;
+
+    // Number of data bits shifted out before the first color bits are loaded
+    u8 skip;
+};
+
+static constexpr auto spriteExpansion = []() {
+
+    std::array<SpriteExpansion, 16> result = { };
+
+    for (isize config = 0; config < 16; config++) {
+
+        bool multicolor = config & 8;
+        bool xExp = config & 4;
+        auto &entry = result[config];
+
+        entry.skip = multicolor && !(config & 1);
+
+        for (isize window = 0; window < 256; window++) {
+
+            // Run the shift register the same way drawSpriteNr() does
+            u32 data = u32(window) << (16 - entry.skip);
+            bool expFlop = config & 2;
+            bool mcFlop = config & 1;
+            bool loaded = false;
+            u8 colBits = 0, hi = 0, lo = 0;
+
+            entry.carry = entry.shifts = 0;
+
+            for (isize pixel = 0; pixel < 8; pixel++) {
+
+                u8 bit = u8(0x80 >> pixel);
+
+                if (expFlop) {
+
+                    if (!multicolor) {
+
+                        colBits = (data >> 22) & 0x02;
+                        loaded = true;
+
+                    } else if (mcFlop) {
+
+                        colBits = (data >> 22) & 0x03;
+                        loaded = true;
+                    }
+                    mcFlop = !mcFlop;
+                    data <<= 1;
+                    entry.shifts |= bit;
+                }
+                expFlop = !expFlop || !xExp;
+
+                if (!loaded) entry.carry |= bit;
+                if (colBits & 2) hi |= bit;
+                if (colBits & 1) lo |= bit;
+            }
+            entry.planes[window] = u16(hi << 8 | lo);
+        }
+    }
+    return result;
+}();
+
+// Gathers the sb-collision indicator bits of eight depth values in a bit plane
+static inline u8 collisionPlane(const u8 *depth)
+{
+    u64 lanes;
+    memcpy(&lanes, depth, 8);
+    lanes = (lanes >> 4) & 0x0101010101010101;
+
+    // The multiplication moves the bit of pixel n to bit 63 - n
+    if constexpr (std::endian::native == std::endian::little) {
+        return u8((lanes * 0x8040201008040201) >> 56);
+    } else {
+        return u8((lanes * 0x0102040810204080) >> 56);
+    }
+}
+
 void
 VICII::drawSprites()
 {
@@ -32,7 +130,7 @@ VICII::drawSprites()
 // Fast path
 //
 
-void
+template <bool T> void
 VICII::drawSpritesFastPath()
 {    
     if (VICII_STATS) stats.spriteFastPath++;
@@ -40,6 +138,9 @@ VICII::drawSpritesFastPath()
     // Prepare for collision detection
     for (isize i = 0; i < 8; i++) collision[i] = 0;
     
+    // Pixels that have already been drawn by a sprite with a lower number
+    u8 occupied = 0;
+
     // Iterate through all 8 sprites
     for (isize i = 0; i < 8; i++) {
 
@@ -49,24 +150,104 @@ VICII::drawSpritesFastPath()
         // Skip this sprite if there is nothing to draw
         if (!enable && !active) continue;
 
-        if (GET_BIT(reg.delayed.sprMC, i)) {
+        if constexpr (T) {
+
+            // Draw the sprite with the help of the expansion tables
+            drawSpriteNrTabulated(i, enable, active, occupied);
+
+        } else if (GET_BIT(reg.delayed.sprMC, i)) {
             
             // Draw multicolor sprite
-            drawSpriteNr <true> (i, enable, active);
+            drawSpriteNr <true> (i, enable, active, occupied);
             
         } else {
             
             // Draw monocolor sprite
-            drawSpriteNr <false> (i, enable, active);
+            drawSpriteNr <false> (i, enable, active, occupied);
         }
+        occupied |= collision[i];
     }
 
     // Perform collision checks
     checkCollisions();
 }
 
+void
+VICII::drawSpriteNrTabulated(isize nr, bool enable, bool active, u8 occupied)
+{
+    auto &spr = spriteSr[nr];
+    bool multicolor = GET_BIT(reg.delayed.sprMC, nr);
+    bool xExp = GET_BIT(reg.delayed.sprExpandX, nr);
+    bool expFlop = spr.expFlop;
+    bool mcFlop = spr.mcFlop;
+
+    // First pixel processed by the shift register
+    isize first = 0;
+
+    if (!active) {
+
+        // Check if the horizontal trigger condition holds in this cycle
+        first = isize(reg.delayed.sprX[nr]) - isize(xCounter);
+        if (first < 0 || first > 7) return;
+
+        expFlop = mcFlop = true;
+    }
+
+    auto &entry = spriteExpansion[multicolor << 3 | xExp << 2 | expFlop << 1 | mcFlop];
+    auto shifts = std::popcount(u8(entry.shifts & (0xFF << first)));
+    u32 data = spr.data << shifts;
+
+    /* If the shift register runs empty, it is inactivated in the middle of the
+     * cycle and might even be retriggered. This happens at most once per
+     * sprite and scanline and is left to the per-pixel routine.
+     */
+    if (!data) {
+
+        if (multicolor) {
+            drawSpriteNr <true> (nr, enable, active, occupied);
+        } else {
+            drawSpriteNr <false> (nr, enable, active, occupied);
+        }
+        return;
+    }
+
+    // Look up the color bits of all pixels
+    auto planes = entry.planes[u8(spr.data >> (16 - entry.skip))];
+    u8 hi = HI_BYTE(planes);
+    u8 lo = LO_BYTE(planes);
+    if (spr.colBits & 2) hi |= entry.carry;
+    if (spr.colBits & 1) lo |= entry.carry;
+    hi >>= first;
+    lo >>= first;
+
+    // Update the shift register
+    if (!active) SET_BIT(spriteSrActive, nr);
+    spr.data = data;
+    spr.colBits = u8((hi & 1) << 1 | (lo & 1));
+    spr.expFlop = xExp ? expFlop ^ ((8 - first) & 1) : true;
+    spr.mcFlop = multicolor ? mcFlop ^ (shifts & 1) : mcFlop;
+
+    // Draw all non-transparent pixels
+    u8 pixels = hi | lo;
+    if (!pixels || config.hideSprites) return;
+
+    auto colors = HI_HI_LO_LO(reg.delayed.colors[COLREG_SPR_EX2],
+                              reg.delayed.colors[COLREG_SPR0 + nr],
+                              reg.delayed.colors[COLREG_SPR_EX1], 0);
+
+    // Only draw pixels where no other sprite pixel has been drawn yet
+    for (u8 todo = pixels & ~occupied; todo; todo &= todo - 1) {
+
+        isize bit = std::countr_zero(todo);
+        isize colBits = ((hi >> bit) & 1) << 1 | ((lo >> bit) & 1);
+
+        SET_SPRITE_PIXEL(nr, 7 - bit, u8(colors >> (8 * colBits)));
+    }
+    collision[nr] = pixels;
+}
+
 template <bool multicolor> void
-VICII::drawSpriteNr(isize nr, bool enable, bool active)
+VICII::drawSpriteNr(isize nr, bool enable, bool active, u8 occupied)
 {
     bool xExp = GET_BIT(reg.delayed.sprExpandX, nr);
 
@@ -122,7 +303,7 @@ VICII::drawSpriteNr(isize nr, bool enable, bool active)
             if (spriteSr[nr].colBits && !config.hideSprites) {
                 
                 // Only draw the pixel if no other sprite pixel has been drawn yet
-                if (!collision[pixel]) {
+                if (!(occupied & (0x80 >> pixel))) {
                     
                     u8 color =
                     spriteSr[nr].colBits == 1 ? reg.delayed.colors[COLREG_SPR_EX1] :
@@ -131,7 +312,7 @@ VICII::drawSpriteNr(isize nr, bool enable, bool active)
                     
                     SET_SPRITE_PIXEL(nr, pixel, color);
                 }
-                collision[pixel] |= (1 << nr);
+                collision[nr] |= u8(0x80 >> pixel);
             }
         }
     }
@@ -236,6 +417,9 @@ VICII::drawSpritePixel(isize pixel, u8 enableBits, u8 freezeBits)
 {
     if (!enableBits && !spriteSrActive) return;
     
+    // Indicates if a sprite pixel has been drawn
+    bool occupied = false;
+
     // Iterate over all sprites
     for (isize sprite = 0; sprite < 8; sprite++) {
         
@@ -306,7 +490,7 @@ VICII::drawSpritePixel(isize pixel, u8 enableBits, u8 freezeBits)
             if (spriteSr[sprite].colBits && !config.hideSprites) {
                 
                 // Only draw the pixel if no other sprite pixel has been drawn yet
-                if (!collision[pixel]) {
+                if (!occupied) {
                     
                     u8 color =
                     spriteSr[sprite].colBits == 1 ? reg.delayed.colors[COLREG_SPR_EX1] :
@@ -315,7 +499,8 @@ VICII::drawSpritePixel(isize pixel, u8 enableBits, u8 freezeBits)
                     
                     SET_SPRITE_PIXEL(sprite, pixel, color);
                 }
-                collision[pixel] |= (1 << sprite);
+                occupied = true;
+                collision[sprite] |= u8(0x80 >> pixel);
             }
         }
     }
@@ -324,30 +509,46 @@ VICII::drawSpritePixel(isize pixel, u8 enableBits, u8 freezeBits)
 void
 VICII::checkCollisions()
 {
-    // Only proceed if there was any collision at all
+    // Determine all pixels that have been drawn by more than a single sprite
+    u8 drawn = 0, overlap = 0;
     for (isize i = 0; i < 8; i++) {
-        
-        if (collision[i]) {
-            
-            // Check for sprite-sprite collisions (at least 2 bits must be set)
-            if ((collision[i] & (collision[i] - 1)) && config.checkSSCollisions) {
-                
-                // Trigger an IRQ if this is the first detected collision
-                if (!spriteSpriteCollision) triggerIrq(4);
-                
-                spriteSpriteCollision |= collision[i];
-            }
-            
-            // Check for sprite-background collisions (z buffer bit 4 must be set)
-            if ((zBuffer[bufferoffset + i] & 0x10) && config.checkSBCollisions) {
-                
-                // Trigger an IRQ if this is the first detected collision
-                if (!spriteBackgroundColllision) triggerIrq(2);
-                
-                spriteBackgroundColllision |= collision[i];
-            }
+
+        overlap |= drawn & collision[i];
+        drawn |= collision[i];
+    }
+
+    // Only proceed if there was any collision at all
+    if (!drawn) return;
+
+    // Check for sprite-sprite collisions
+    if (overlap && config.checkSSCollisions) {
+
+        u8 sprites = 0;
+        for (isize i = 0; i < 8; i++) if (collision[i] & overlap) sprites |= 1 << i;
+
+        // Trigger an IRQ if this is the first detected collision
+        if (!spriteSpriteCollision) triggerIrq(4);
+
+        spriteSpriteCollision |= sprites;
+    }
+
+    // Check for sprite-background collisions (z buffer bit 4 must be set)
+    if (config.checkSBCollisions) {
+
+        if (u8 foreground = drawn & collisionPlane(zBuffer + bufferoffset)) {
+
+            u8 sprites = 0;
+            for (isize i = 0; i < 8; i++) if (collision[i] & foreground) sprites |= 1 << i;
+
+            // Trigger an IRQ if this is the first detected collision
+            if (!spriteBackgroundColllision) triggerIrq(2);
+
+            spriteBackgroundColllision |= sprites;
         }
     }
 }
 
+template void VICII::drawSpritesFastPath<false>();
+template void VICII::drawSpritesFastPath<true>();
+
 }
@@ -59,6 +59,22 @@ static const u16 HEADLESS_CYCLE = 0b0100;
 #define DEPTH_SPRITE_BG     0b10000000 // Behind foreground
 #define DEPTH_BG            0b10100000 // Behind sprite 2 layer
 
+/* Texel values of the emulator texture
+ *
+ * VICII draws color indices which are converted to RGBA in getTexture() and copyTexture().
+ *
+ *       0x00 - 0x0F : C64 colors
+ *       0x10 - 0x1F : C64 colors cut out over a dark checkerboard cell
+ *       0x20 - 0x2F : C64 colors cut out over a light checkerboard cell
+ *       0x30 - 0x32 : Black, dark and light checkerboard cell
+ */
+#define TEX_CUT_DARK        0x10 // Added to a color index by cutLayers()
+#define TEX_CUT_LIGHT       0x20 // Added to a color index by cutLayers()
+#define TEX_BLACK           0x30 // Unused area inside the visible window
+#define TEX_CHECKER_DARK    0x31 // HBLANK and VBLANK area
+#define TEX_CHECKER_LIGHT   0x32 // HBLANK and VBLANK area
+#define TEX_COLORS          0x40 // Size of the color lookup table
+
 // Event flags
 #define VICUpdateIrqLine    (1ULL << 0) // Sets or releases the IRQ line
 #define VICLpTransition     (1ULL << 1) // Triggers a lightpen event
@@ -317,6 +333,7 @@ typedef struct
     VICIIRevision revision;
     VICIIRevision awaiting;
     bool powerSave;
+    bool lineCache;
     bool grayDotBug;
     GlueLogic glueLogic;
 
@@ -338,6 +355,10 @@ typedef struct
     isize spriteSlowPath;
     isize quickExitHit;
     isize quickExitMiss;
+
+    // Scanline cache
+    isize lineCacheHit;
+    isize lineCacheMiss;
 }
 VICIIStats;
 
@@ -35,9 +35,11 @@ Thumbnail::take(const C64 &c64, isize dx, isize dy)
     width = i32(PAL::VISIBLE_PIXELS / dx);
     height = i32(c64.vic.numVisibleLines() / dy);
 
+    Buffer<u32> texture(Texture::height * Texture::width);
+    c64.videoPort.copyTexture(texture.ptr);
+
     u32 *target = screen;
-    u32 *source = (u32 *)c64.videoPort.getTexture();
-    source += xStart + yStart * Texture::width;
+    u32 *source = texture.ptr + xStart + yStart * Texture::width;
 
     for (isize y = 0; y < height; y++) {
         for (isize x = 0; x < width; x++) {
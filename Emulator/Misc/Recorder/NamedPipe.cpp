@@ -13,8 +13,10 @@
 #include "config.h"
 #include "NamedPipe.h"
 #include "IOUtils.h"
+#include <cerrno>
 #ifndef _WIN32
 #include <unistd.h>
+#include <sys/uio.h>
 #endif
 
 namespace vc64 {
@@ -36,6 +38,23 @@ NamedPipe::create(const string &name)
 #endif
 }
 
+bool
+NamedPipe::createFile(const string &name)
+{
+    this->name = name;
+
+#ifdef _WIN32
+
+    return false;
+
+#else
+
+    pipe = ::open(name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    return pipe != -1;
+
+#endif
+}
+
 bool
 NamedPipe::open()
 {
@@ -96,4 +115,46 @@ NamedPipe::write(u8 *buffer, isize length)
 #endif
 }
 
+isize
+NamedPipe::write(u8 **buffers, isize *lengths, isize count)
+{
+#ifdef _WIN32
+
+    return 0;
+
+#else
+
+    assert(isOpen());
+
+    std::vector<iovec> iov(count);
+    for (isize i = 0; i < count; i++) iov[i] = { buffers[i], size_t(lengths[i]) };
+
+    // Repeat until all buffers have been written completely
+    isize total = 0;
+    for (isize i = 0; i < count;) {
+
+        auto written = ::writev(pipe, iov.data() + i, int(count - i));
+
+        if (written < 0) {
+
+            if (errno == EINTR) continue;
+            break;
+        }
+        total += written;
+
+        // Skip all buffers that have been written completely
+        for (; i < count && size_t(written) >= iov[i].iov_len; i++) written -= iov[i].iov_len;
+
+        // Advance inside a partially written buffer
+        if (i < count) {
+
+            iov[i].iov_base = (u8 *)iov[i].iov_base + written;
+            iov[i].iov_len -= size_t(written);
+        }
+    }
+    return total;
+
+#endif
+}
+
 }
@@ -24,10 +24,16 @@ class NamedPipe final {
 public:
 
     bool create(const string &name);
+
+    // Creates a regular file instead of a pipe and opens it for writing
+    bool createFile(const string &name);
     bool open();
     bool isOpen();
     bool close();
     isize write(u8 *buffer, isize length);
+
+    // Writes multiple buffers at once and returns the number of written bytes
+    isize write(u8 **buffers, isize *lengths, isize count);
 };
 
 }
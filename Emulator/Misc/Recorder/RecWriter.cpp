@@ -0,0 +1,149 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// This FILE is dual-licensed. You are free to choose between:
+//
+//     - The GNU General Public License v3 (or any later version)
+//     - The Mozilla Public License v2
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR MPL-2.0
+// -----------------------------------------------------------------------------
+
+#include "config.h"
+#include "RecWriter.h"
+
+namespace vc64 {
+
+RecWriter::~RecWriter()
+{
+    close();
+}
+
+void
+RecWriter::init(isize slotSize, RecEncoder encoder, isize encodedSize)
+{
+    assert(!writer.joinable());
+    assert(!encoder || encodedSize > 0);
+
+    delete[] pool;
+    pool = new u8[slots * slotSize];
+    this->slotSize = slotSize;
+
+    delete[] encoded;
+    encoded = encoder ? new u8[slots * encodedSize] : nullptr;
+    this->encoder = encoder;
+    this->encodedSize = encodedSize;
+
+    failed = false;
+    stats = { };
+    writes = 0;
+    bytes = 0;
+}
+
+void
+RecWriter::close()
+{
+    // Let the writer flush all pending slots and terminate
+    if (writer.joinable()) {
+
+        queue.write(-1);
+        writer.join();
+    }
+
+    delete[] pool;
+    pool = nullptr;
+    delete[] encoded;
+    encoded = nullptr;
+}
+
+u8 *
+RecWriter::claim(bool wait)
+{
+    assert(pool);
+
+    if (queue.isFull()) {
+
+        if (!wait) return nullptr;
+        queue.waitUntilFree();
+    }
+
+    return pool + queue.index(queue.w.load(std::memory_order_relaxed)) * slotSize;
+}
+
+void
+RecWriter::commit(isize length)
+{
+    assert(length >= 0 && length <= slotSize);
+
+    // Launch the writer on first use
+    if (!writer.joinable()) writer = std::thread(&RecWriter::runWriter, this);
+
+    queue.write(length);
+
+    stats.buffers++;
+    stats.maxQueued = std::max(stats.maxQueued, queue.count());
+}
+
+RecStreamStats
+RecWriter::getStats() const
+{
+    auto result = stats;
+    result.writes = writes;
+    result.bytes = bytes;
+
+    return result;
+}
+
+void
+RecWriter::runWriter()
+{
+    u8 *buffers[slots];
+    isize lengths[slots];
+
+    while (true) {
+
+        // Wait for the next slot
+        queue.front();
+
+        // Collect all pending slots
+        auto rr = queue.r.load(std::memory_order_relaxed);
+        auto pending = queue.count();
+        bool quit = false;
+        isize count = 0, total = 0;
+
+        for (; count < pending; count++) {
+
+            if (queue.peek(count) < 0) { quit = true; break; }
+
+            auto slot = queue.index(rr + count);
+            buffers[count] = pool + slot * slotSize;
+            lengths[count] = queue.peek(count);
+
+            // Convert the slot if requested
+            if (encoder && !failed) {
+
+                lengths[count] = encoder(buffers[count], lengths[count], encoded + slot * encodedSize);
+                buffers[count] = encoded + slot * encodedSize;
+                assert(lengths[count] <= encodedSize);
+            }
+            total += lengths[count];
+        }
+
+        // Write them in one go (discard them if the pipe is broken)
+        if (count && !failed) {
+
+            auto written = pipe.write(buffers, lengths, count);
+
+            writes++;
+            bytes += written;
+            if (written != total) failed = true;
+        }
+
+        // Release the slots
+        queue.skip(quit ? count + 1 : count);
+        if (quit) return;
+    }
+}
+
+}
@@ -0,0 +1,125 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// This FILE is dual-licensed. You are free to choose between:
+//
+//     - The GNU General Public License v3 (or any later version)
+//     - The Mozilla Public License v2
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR MPL-2.0
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#include "RecorderTypes.h"
+#include "NamedPipe.h"
+#include "RingBuffer.h"
+#include <thread>
+
+namespace vc64 {
+
+/* The writer feeds a named pipe on a thread of its own. This keeps the
+ * emulator thread from stalling if the encoder on the other side of the pipe
+ * falls behind.
+ *
+ * The emulator thread copies each frame into a slot of a preallocated buffer
+ * pool and hands the slot over through a lock-free queue. Because the writer
+ * consumes the slots in order, the queue doubles as the free list: A slot can
+ * be reused as soon as the writer has removed it from the queue. If all slots
+ * are in use, the caller either drops the frame or waits for the writer to
+ * free a slot. Claiming a slot doesn't reserve it. Hence, a caller feeding
+ * multiple writers can claim a slot in each of them and drop the frame in all
+ * of them if one claim fails. The writer flushes all pending slots with a
+ * single gathering write.
+ *
+ * Optionally, the writer converts each slot with an encoder before writing
+ * it. Thus, format conversions don't burden the emulator thread either.
+ */
+
+// Converts a slot and returns the number of bytes written into dst
+typedef isize (*RecEncoder)(const u8 *src, isize length, u8 *dst);
+
+class RecWriter final {
+
+public:
+
+    // Number of slots in the buffer pool
+    static constexpr isize slots = 16;
+
+private:
+
+    // The pipe to feed
+    NamedPipe &pipe;
+
+    // Buffer pool
+    u8 *pool = nullptr;
+
+    // Size of a single slot in bytes
+    isize slotSize = 0;
+
+    // Optional encoder and the pool receiving the encoded slots
+    RecEncoder encoder = nullptr;
+    u8 *encoded = nullptr;
+    isize encodedSize = 0;
+
+    // Number of bytes stored in each queued slot (-1 terminates the writer)
+    util::SPSCRingBuffer<isize, slots> queue;
+
+    // The writer thread (launched on demand)
+    std::thread writer;
+
+    // Indicates that a write operation has failed
+    std::atomic<bool> failed = false;
+
+    // Statistics (the atomic values are updated by the writer thread)
+    RecStreamStats stats = { };
+    std::atomic<isize> writes = 0;
+    std::atomic<i64> bytes = 0;
+
+
+    //
+    // Initializing
+    //
+
+public:
+
+    RecWriter(NamedPipe &pipe) : pipe(pipe) { }
+    ~RecWriter();
+
+    // Allocates the buffer pool (encodedSize bounds the encoder's output)
+    void init(isize slotSize, RecEncoder encoder = nullptr, isize encodedSize = 0);
+
+    // Flushes all pending slots, terminates the writer, and frees the pool
+    void close();
+
+
+    //
+    // Feeding the writer
+    //
+
+public:
+
+    /* Returns a free slot. If all slots are in use, the function returns
+     * nullptr or, if wait is set, blocks until the writer has freed a slot.
+     */
+    u8 *claim(bool wait = false);
+
+    // Hands the most recently claimed slot over to the writer
+    void commit(isize length);
+
+    // Records that a frame has been dropped
+    void drop() { stats.dropped++; }
+
+    // Indicates whether a write operation has failed
+    bool hasFailed() const { return failed; }
+
+    // Returns the collected statistics
+    RecStreamStats getStats() const;
+
+private:
+
+    void runWriter();
+};
+
+}
@@ -14,9 +14,66 @@
 #include "Recorder.h"
 #include "C64.h"
 #include "Host.h"
+#include "IOUtils.h"
 
 namespace vc64 {
 
+/* A video slot starts with the lookup table of the frame, followed by the
+ * cutout with one color index per pixel. The emulator thread only copies the
+ * indices. The writer thread translates them with one of the encoders below.
+ */
+static constexpr isize lutSize = TEX_COLORS * sizeof(u32);
+
+// Converts an indexed frame into an RGBA frame
+static isize
+encodeRGBA(const u8 *src, isize length, u8 *dst)
+{
+    isize pixels = length - lutSize;
+    u32 lut[TEX_COLORS];
+
+    std::memcpy(lut, src, lutSize);
+    VICII::convertTexture(src + lutSize, (u32 *)dst, pixels, lut);
+
+    return 4 * pixels;
+}
+
+// Converts an indexed frame into a YUV 4:4:4 frame of a Y4M stream (BT.601)
+static isize
+encodeY4M(const u8 *src, isize length, u8 *dst)
+{
+    isize pixels = length - lutSize;
+    u8 lutY[TEX_COLORS], lutU[TEX_COLORS], lutV[TEX_COLORS];
+
+    // Translate the lookup table
+    for (isize i = 0; i < TEX_COLORS; i++, src += 4) {
+
+        int r = src[0], g = src[1], b = src[2];
+
+        lutY[i] = u8(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+        lutU[i] = u8(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+        lutV[i] = u8(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+    }
+
+    std::memcpy(dst, "FRAME\n", 6);
+    u8 *y = dst + 6, *u = y + pixels, *v = u + pixels;
+
+    for (isize i = 0; i < pixels; i++) {
+
+        y[i] = lutY[src[i]];
+        u[i] = lutU[src[i]];
+        v[i] = lutV[src[i]];
+    }
+
+    return 6 + 3 * pixels;
+}
+
+// Writes a 32-bit value in little-endian format
+static void
+write32LE(u8 *p, u32 value)
+{
+    for (isize i = 0; i < 4; i++) p[i] = u8(value >> (8 * i));
+}
+
 Recorder::Recorder(C64& ref) : SubComponent(ref)
 {
 
@@ -48,6 +105,23 @@ Recorder::_dump(Category category, std::ostream& os) const
         os << bol(RecStateEnum::key(state)) << std::endl;
         os << tab("Duration");
         os << flt(getDuration().asSeconds()) << std::endl;
+
+        for (isize i = 0; i < 2; i++) {
+
+            auto stats = i == 0 ? videoWriter.getStats() : audioWriter.getStats();
+
+            os << std::endl;
+            os << tab(i == 0 ? "Video frames" : "Audio frames");
+            os << dec(stats.buffers) << std::endl;
+            os << tab("Dropped");
+            os << dec(stats.dropped) << std::endl;
+            os << tab("Max queued");
+            os << dec(stats.maxQueued) << " / " << dec(RecWriter::slots) << std::endl;
+            os << tab("Writes");
+            os << dec(stats.writes) << std::endl;
+            os << tab("Bytes");
+            os << dec(stats.bytes) << std::endl;
+        }
     }
 }
 
@@ -56,6 +130,7 @@ Recorder::getOption(Option option) const
 {
     switch (option) {
 
+        case OPT_REC_FORMAT:        return config.format;
         case OPT_REC_FRAME_RATE:    return config.frameRate;
         case OPT_REC_BIT_RATE:      return config.bitRate;
         case OPT_REC_SAMPLE_RATE:   return config.sampleRate;
@@ -72,6 +147,13 @@ Recorder::checkOption(Option opt, i64 value)
 {
     switch (opt) {
 
+        case OPT_REC_FORMAT:
+
+            if (!RecFormatEnum::isValid(value)) {
+                throw Error(VC64ERROR_OPT_INV_ARG, RecFormatEnum::keyList());
+            }
+            return;
+
         case OPT_REC_FRAME_RATE:
         case OPT_REC_BIT_RATE:
         case OPT_REC_SAMPLE_RATE:
@@ -92,6 +174,11 @@ Recorder::setOption(Option opt, i64 value)
 
     switch (opt) {
 
+        case OPT_REC_FORMAT:
+
+            config.format = RecFormat(value);
+            return;
+
         case OPT_REC_FRAME_RATE:
 
             config.frameRate = isize(value);
@@ -130,6 +217,8 @@ Recorder::cacheInfo(RecorderInfo &result) const
         result.available = FFmpeg::available();
         result.state = state;
         result.duration = getDuration().asSeconds();
+        result.video = videoWriter.getStats();
+        result.audio = audioWriter.getStats();
     }
 }
 
@@ -148,13 +237,13 @@ Recorder::audioPipePath()
 string
 Recorder::videoStreamPath()
 {
-    return host.tmp("video.mp4").string();
+    return host.tmp(format == REC_FORMAT_RAW ? "video.y4m" : "video.mp4").string();
 }
 
 string
 Recorder::audioStreamPath()
 {
-    return host.tmp("audio.mp4").string();
+    return host.tmp(format == REC_FORMAT_RAW ? "audio.wav" : "audio.mp4").string();
 }
 
 util::Time
@@ -182,6 +271,25 @@ Recorder::startRecording(isize x1, isize y1, isize x2, isize y2)
         throw Error(VC64ERROR_REC_LAUNCH, "Recording in progress.");
     }
 
+    // Make sure the screen dimensions are even
+    if ((x2 - x1) % 2) x2--;
+    if ((y2 - y1) % 2) y2--;
+
+    // Remember the cutout
+    cutout.x1 = x1;
+    cutout.x2 = x2;
+    cutout.y1 = y1;
+    cutout.y2 = y2;
+    debug(REC_DEBUG, "Recorded area: (%ld,%ld) - (%ld,%ld)\n", x1, y1, x2, y2);
+
+    // Write raw streams directly to disk if requested
+    if ((format = config.format) == REC_FORMAT_RAW) {
+
+        createRawStreams();
+        state = REC_STATE_PREPARE;
+        return;
+    }
+
     // Create pipes
     debug(REC_DEBUG, "Creating pipes...\n");
 
@@ -194,17 +302,6 @@ Recorder::startRecording(isize x1, isize y1, isize x2, isize y2)
 
     debug(REC_DEBUG, "Pipes created\n");
 
-    // Make sure the screen dimensions are even
-    if ((x2 - x1) % 2) x2--;
-    if ((y2 - y1) % 2) y2--;
-
-    // Remember the cutout
-    cutout.x1 = x1;
-    cutout.x2 = x2;
-    cutout.y1 = y1;
-    cutout.y2 = y2;
-    debug(REC_DEBUG, "Recorded area: (%ld,%ld) - (%ld,%ld)\n", x1, y1, x2, y2);
-
 
     //
     // Assemble the command line arguments for the video encoder
@@ -307,10 +404,92 @@ Recorder::startRecording(isize x1, isize y1, isize x2, isize y2)
         throw Error(VC64ERROR_REC_LAUNCH, "Unable to launch the audio pipe.");
     }
 
+    // Setup the buffer pool of the video writer
+    videoWriter.init(lutSize + (x2 - x1) * (y2 - y1), encodeRGBA, 4 * (x2 - x1) * (y2 - y1));
+
     debug(REC_DEBUG, "Success\n");
     state = REC_STATE_PREPARE;
 }
 
+void
+Recorder::createRawStreams()
+{
+    isize width = cutout.x2 - cutout.x1;
+    isize height = cutout.y2 - cutout.y1;
+
+    debug(REC_DEBUG, "Creating raw streams...\n");
+
+    // Closes the files created so far and reports an error
+    auto fail = [&](const string &msg) {
+
+        videoPipe.close();
+        audioPipe.close();
+        throw Error(VC64ERROR_REC_LAUNCH, msg);
+    };
+
+    if (!videoPipe.createFile(videoStreamPath())) {
+        fail("Unable to create the video file.");
+    }
+    if (!audioPipe.createFile(audioStreamPath())) {
+        fail("Unable to create the audio file.");
+    }
+
+    // Write the Y4M stream header
+    string header = "YUV4MPEG2";
+    header += " W" + std::to_string(width) + " H" + std::to_string(height);
+    header += " F" + std::to_string(config.frameRate) + ":1 Ip";
+    header += " A" + std::to_string(config.aspectRatio.x) + ":" + std::to_string(config.aspectRatio.y);
+    header += " C444\n";
+
+    if (videoPipe.write((u8 *)header.data(), isize(header.size())) != isize(header.size())) {
+        fail("Unable to write the video file.");
+    }
+
+    // Write the WAV header (the chunk sizes are filled in when finalizing)
+    u8 wav[44] = { };
+
+    std::memcpy(wav + 0, "RIFF", 4);
+    std::memcpy(wav + 8, "WAVEfmt ", 8);
+    write32LE(wav + 16, 16);                            // Size of the fmt chunk
+    write32LE(wav + 20, 3 | 2 << 16);                   // IEEE float, stereo
+    write32LE(wav + 24, u32(config.sampleRate));        // Sample rate
+    write32LE(wav + 28, u32(config.sampleRate * 8));    // Byte rate
+    write32LE(wav + 32, 8 | 32 << 16);                  // Block size, bit depth
+    std::memcpy(wav + 36, "data", 4);
+
+    if (audioPipe.write(wav, 44) != 44) {
+        fail("Unable to write the audio file.");
+    }
+
+    // Let the video writer convert the frames
+    videoWriter.init(lutSize + width * height, encodeY4M, 6 + 3 * width * height);
+}
+
+void
+Recorder::finalizeRawStreams()
+{
+    std::error_code ec;
+    auto path = audioStreamPath();
+    auto size = fs::file_size(path, ec);
+
+    if (ec || size < 44) {
+
+        warn("Failed to finalize %s\n", path.c_str());
+        return;
+    }
+
+    // Fill in the chunk sizes of the WAV header
+    u8 riffSize[4], dataSize[4];
+    write32LE(riffSize, u32(size - 8));
+    write32LE(dataSize, u32(size - 44));
+
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(4);
+    file.write((char *)riffSize, 4);
+    file.seekp(40);
+    file.write((char *)dataSize, 4);
+}
+
 void
 Recorder::stopRecording()
 {
@@ -329,6 +508,27 @@ Recorder::exportAs(const fs::path &path)
 {
     if (isRecording()) return false;
 
+    // Raw streams are exported as they are
+    if (format == REC_FORMAT_RAW) {
+
+        auto video = path, audio = path;
+        video.replace_extension(".y4m");
+        audio.replace_extension(".wav");
+
+        std::error_code ec1, ec2;
+        fs::copy_file(videoStreamPath(), video, fs::copy_options::overwrite_existing, ec1);
+        fs::copy_file(audioStreamPath(), audio, fs::copy_options::overwrite_existing, ec2);
+
+        if (ec1 || ec2) {
+
+            warn("Failed to export the raw streams to %s\n", path.string().c_str());
+            return false;
+        }
+
+        debug(REC_DEBUG, "Exported %s and %s\n", video.string().c_str(), audio.string().c_str());
+        return true;
+    }
+
     //
     // Assemble the command line arguments for the video encoder
     //
@@ -374,7 +574,7 @@ Recorder::vsyncHandler()
                 
             case REC_STATE_WAIT:     break;
             case REC_STATE_PREPARE:  prepare(); break;
-            case REC_STATE_RECORD:   recordVideo(); recordAudio(); break;
+            case REC_STATE_RECORD:   record(); break;
             case REC_STATE_FINALIZE: finalize(); break;
             case REC_STATE_ABORT:    abort(); break;
         }
@@ -404,8 +604,12 @@ Recorder::prepare()
         host.setOption(OPT_HOST_SAMPLE_RATE, i64(config.sampleRate * 59.827 / 60.0));
         samplesPerFrame = 735;
     }
+
+    // Setup the buffer pool of the audio writer
+    audioWriter.init(samplesPerFrame * isize(sizeof(SamplePair)));
     
-    // Start with a nearly empty buffer
+    // Take the audio samples away from the host and start with a nearly empty buffer
+    audioPort.acquireConsumer();
     audioPort.clamp(1);
 
     // Switch state and inform the GUI
@@ -415,73 +619,109 @@ Recorder::prepare()
 }
 
 void
-Recorder::recordVideo()
+Recorder::record()
 {
-    assert(videoFFmpeg.isRunning());
-    assert(videoPipe.isOpen());
+    assert(format == REC_FORMAT_RAW || (videoFFmpeg.isRunning() && audioFFmpeg.isRunning()));
+    assert(videoPipe.isOpen() && audioPipe.isOpen());
 
-    u32 *texture = (u32 *)videoPort.getTexture();
-    
-    isize width = sizeof(u32) * (cutout.x2 - cutout.x1);
-    isize height = cutout.y2 - cutout.y1;
-    isize offset = cutout.y1 * Texture::width + cutout.x1;
+    if (audioPort.count() != samplesPerFrame) {
 
-    u8 *data = new u8[width * height];
-    u8 *src = (u8 *)(texture + offset);
-    u8 *dst = data;
-    
-    for (isize y = 0; y < height; y++, src += 4 * Texture::width, dst += width) {
-        std::memcpy(dst, src, width);
+        // trace(REC_DEBUG, "Samples: %ld (expected: %ld)\n", audioPort.count(), samplesPerFrame);
+        assert(audioPort.count() >= samplesPerFrame);
     }
-    
-    // Feed the video pipe
-    isize length = width * height;
-    isize written = videoPipe.write((u8 *)data, length);
 
-    if (written != length || FORCE_RECORDING_ERROR) {
+    /* Claim a slot in both writers before handing anything over. Frames are
+     * only dropped when feeding the encoders. A file sink throttles the
+     * emulator instead, because it would lose frames for good.
+     */
+    auto wait = format == REC_FORMAT_RAW;
+    auto *video = videoWriter.claim(wait);
+    auto *audio = audioWriter.claim(wait);
+
+    if (video && audio) {
+
+        recordVideo(video);
+        recordAudio(audio);
+
+    } else {
+
+        // Drop the frame in both streams to keep them in sync
+        videoWriter.drop();
+        audioWriter.drop();
+    }
+
+    // Drop the remaining samples
+    audioPort.clamp(0);
+
+    if (videoWriter.hasFailed() || audioWriter.hasFailed() || FORCE_RECORDING_ERROR) {
         state = REC_STATE_ABORT;
     }
 }
 
 void
-Recorder::recordAudio()
+Recorder::recordVideo(u8 *data)
 {
-    assert(audioFFmpeg.isRunning());
-    assert(audioPipe.isOpen());
+    isize width = cutout.x2 - cutout.x1;
+    isize height = cutout.y2 - cutout.y1;
+    isize offset = cutout.y1 * Texture::width + cutout.x1;
 
-    if (audioPort.count() != samplesPerFrame) {
+    // Store the lookup table in front of the pixels
+    u32 lut[TEX_COLORS];
+    videoPort.computeLut(lut);
+    std::memcpy(data, lut, lutSize);
 
-        // trace(REC_DEBUG, "Samples: %ld (expected: %ld)\n", audioPort.count(), samplesPerFrame);
-        assert(audioPort.count() >= samplesPerFrame);
+    // Copy the cutout into the claimed slot (the writer converts it)
+    const u8 *src = videoPort.getIndexedTexture() + offset;
+    u8 *dst = data + lutSize;
+
+    for (isize y = 0; y < height; y++, src += Texture::width, dst += width) {
+        std::memcpy(dst, src, width);
     }
-    
-    // Feed the audio pipe
-    for (isize i = 0; i < samplesPerFrame; i++) {
 
-        isize written = 0;
+    videoWriter.commit(lutSize + width * height);
+}
+
+void
+Recorder::recordAudio(u8 *data)
+{
+    auto *samples = (SamplePair *)data;
+    auto count = audioPort.copy(samples, samplesPerFrame);
 
-        SamplePair pair = audioPort.read();
-        written += audioPipe.write((u8 *)&pair.l, sizeof(float));
-        written += audioPipe.write((u8 *)&pair.r, sizeof(float));
+    // Pad a short frame with silence to keep the audio in sync with the video
+    if (count < samplesPerFrame) {
 
-        if (written != 2 * sizeof(float) || FORCE_RECORDING_ERROR) {
-            state = REC_STATE_ABORT;
-        }
+        trace(REC_DEBUG, "Padding %ld missing samples\n", samplesPerFrame - count);
+        std::fill(samples + count, samples + samplesPerFrame, SamplePair { });
     }
-    
-    audioPort.clear();
+
+    audioWriter.commit(samplesPerFrame * isize(sizeof(SamplePair)));
 }
 
 void
 Recorder::finalize()
 {
+    // Wait for the writer threads to flush their buffers
+    videoWriter.close();
+    audioWriter.close();
+
     // Close pipes
     videoPipe.close();
     audioPipe.close();
 
-    // Wait for the decoders to terminate
-    videoFFmpeg.join();
-    audioFFmpeg.join();
+    // Hand the audio samples back to the host
+    audioPort.releaseConsumer();
+
+    if (format == REC_FORMAT_RAW) {
+
+        // Complete the file headers
+        finalizeRawStreams();
+
+    } else {
+
+        // Wait for the decoders to terminate
+        videoFFmpeg.join();
+        audioFFmpeg.join();
+    }
 
     // Switch state and inform the GUI
     state = REC_STATE_WAIT;
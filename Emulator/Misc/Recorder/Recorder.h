@@ -17,6 +17,7 @@
 #include "Chrono.h"
 #include "FFmpeg.h"
 #include "NamedPipe.h"
+#include "RecWriter.h"
 
 namespace vc64 {
 
@@ -31,6 +32,7 @@ class Recorder final : public SubComponent, public Inspectable<RecorderInfo> {
 
     Options options = {
 
+        OPT_REC_FORMAT,
         OPT_REC_FRAME_RATE,
         OPT_REC_BIT_RATE,
         OPT_REC_SAMPLE_RATE,
@@ -54,6 +56,10 @@ class Recorder final : public SubComponent, public Inspectable<RecorderInfo> {
     NamedPipe videoPipe;
     NamedPipe audioPipe;
 
+    // Threads feeding the pipes
+    RecWriter videoWriter { videoPipe };
+    RecWriter audioWriter { audioPipe };
+
     
     //
     // Recording status
@@ -62,6 +68,9 @@ class Recorder final : public SubComponent, public Inspectable<RecorderInfo> {
     // The current recorder state
     RecState state = REC_STATE_WAIT;
 
+    // The output format of the current or latest recording
+    RecFormat format = REC_FORMAT_FFMPEG;
+
     
     //
     // Recording parameters
@@ -153,6 +162,12 @@ private:
     // Returns the length of the recorded video
     util::Time getDuration() const;
 
+    // Creates the output files of a raw recording
+    void createRawStreams();
+
+    // Completes the headers of a raw recording
+    void finalizeRawStreams();
+
 
     //
     // Starting and stopping a video capture
@@ -185,8 +200,9 @@ public:
 private:
     
     void prepare();
-    void recordVideo();
-    void recordAudio();
+    void record();
+    void recordVideo(u8 *data);
+    void recordAudio(u8 *data);
     void finalize();
     void abort();
 };
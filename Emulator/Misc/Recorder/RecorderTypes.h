@@ -51,6 +51,30 @@ struct RecStateEnum : util::Reflection<RecStateEnum, RecState> {
     }
 };
 
+enum_long(REC_FORMAT)
+{
+    REC_FORMAT_FFMPEG,                  ///< MP4 file encoded by FFmpeg
+    REC_FORMAT_RAW                      ///< Y4M video and WAV audio file
+};
+typedef REC_FORMAT RecFormat;
+
+struct RecFormatEnum : util::Reflection<RecFormatEnum, RecFormat> {
+
+    static constexpr long minVal = 0;
+    static constexpr long maxVal = REC_FORMAT_RAW;
+
+    static const char *prefix() { return "REC_FORMAT"; }
+    static const char *_key(long value)
+    {
+        switch (value) {
+
+            case REC_FORMAT_FFMPEG:     return "FFMPEG";
+            case REC_FORMAT_RAW:        return "RAW";
+        }
+        return "???";
+    }
+};
+
 
 //
 // Structures
@@ -58,6 +82,9 @@ struct RecStateEnum : util::Reflection<RecStateEnum, RecState> {
 
 typedef struct
 {
+    // Output format
+    RecFormat format;
+
     // Recording parameters
     isize frameRate;
     isize bitRate;
@@ -68,6 +95,25 @@ typedef struct
 }
 RecorderConfig;
 
+typedef struct
+{
+    // Number of buffers handed over to the writer thread
+    isize buffers;
+
+    // Number of buffers dropped because the encoder fell behind
+    isize dropped;
+
+    // Maximum number of buffers waiting in the queue
+    isize maxQueued;
+
+    // Number of gathering writes issued by the writer thread
+    isize writes;
+
+    // Number of bytes written into the pipe
+    i64 bytes;
+}
+RecStreamStats;
+
 typedef struct
 {
     // Indicates if FFmpeg is availabe
@@ -78,6 +124,10 @@ typedef struct
 
     // Duration of the recorded Video
     double duration;
+
+    // Statistics of the video and audio writer threads
+    RecStreamStats video;
+    RecStreamStats audio;
 }
 RecorderInfo;
 
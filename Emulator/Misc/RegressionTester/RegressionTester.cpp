@@ -93,7 +93,10 @@ RegressionTester::dumpTexture(C64 &c64, std::ostream& os)
         return ((y >> 3) & 1) == ((x >> 3) & 1) ? grey2 : grey4;
     };
 
-    auto buffer = (u32 *)c64.videoPort.getTexture();
+    Buffer<u32> texture(Texture::height * Texture::width);
+    c64.videoPort.copyTexture(texture.ptr);
+
+    auto buffer = texture.ptr;
     char *cptr;
 
     for (isize y = Y1; y < Y2; y++) {
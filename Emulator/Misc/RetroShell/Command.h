@@ -28,6 +28,7 @@ namespace Arg {
 static const std::string address    = "<address>";
 static const std::string boolean    = "{ true | false }";
 static const std::string command    = "<command>";
+static const std::string condition  = "<condition>";
 static const std::string count      = "<count>";
 static const std::string dst        = "<destination>";
 static const std::string ignores    = "<ignores>";
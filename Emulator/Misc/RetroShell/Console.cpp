@@ -395,7 +395,7 @@ Console::split(const string& userInput)
         }
         esc = false;
     }
-    if (!token.empty()) result.push_back(token);
+    if (!token.empty()) result.push_back(util::trim(token, "\""));
 
     return result;
 }
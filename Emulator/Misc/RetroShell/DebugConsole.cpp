@@ -179,6 +179,17 @@ DebugConsole::initCommands(Command &root)
         cpu.toggleBreakpoint(parseNum(argv[0]));
     });
 
+    root.add({"break", "if"}, { Arg::nr }, { Arg::condition },
+             "Set or remove a breakpoint condition",
+             [this](Arguments& argv, long value) {
+
+        if (argv.size() > 1) {
+            cpu.setBreakpointCondition(parseNum(argv[0]), argv[1]);
+        } else {
+            cpu.deleteBreakpointCondition(parseNum(argv[0]));
+        }
+    });
+
     root.add({"watch"},     "Manage CPU watchpoints");
 
     root.add({"watch", ""},
@@ -209,6 +220,17 @@ DebugConsole::initCommands(Command &root)
         cpu.toggleWatchpoint(parseNum(argv[0]));
     });
 
+    root.add({"watch", "if"}, { Arg::nr }, { Arg::condition },
+             "Set or remove a watchpoint condition",
+             [this](Arguments& argv, long value) {
+
+        if (argv.size() > 1) {
+            cpu.setWatchpointCondition(parseNum(argv[0]), argv[1]);
+        } else {
+            cpu.deleteWatchpointCondition(parseNum(argv[0]));
+        }
+    });
+
 
     //
     // Monitoring
@@ -540,6 +562,22 @@ DebugConsole::initCommands(Command &root)
         dump(c64, Category::Checksums);
     });
 
+    root.add({"profile"}, "Execution profiler");
+
+    root.add({"profile", ""}, {},
+             "Display the time spent in each component",
+             [this](Arguments& argv, long value) {
+
+        dump(emulator, Category::Stats);
+    });
+
+    root.add({"profile", "enable"}, { Arg::boolean },
+             "Enable or disable the profiler",
+             [this](Arguments& argv, long value) {
+
+        c64.setProfiling(parseBool(argv[0]));
+    });
+
     root.add({"debug"}, "Debug variables");
 
     root.add({"debug", ""}, {},
@@ -13,10 +13,32 @@
 #pragma once
 
 #include "BasicTypes.h"
+#include <chrono>
 #include <ctime>
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#endif
+
 namespace vc64::util {
 
+/* Reads a cheap, monotonically increasing tick counter. On x86 and ARM64
+ * hosts, the processor's time stamp counter is read directly. The tick rate
+ * is unspecified and needs to be calibrated against Time::now().
+ */
+inline u64 rdtsc()
+{
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    u64 result; asm volatile("mrs %0, cntvct_el0" : "=r" (result)); return result;
+#else
+    return u64(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
 class Time {
     
 public:
@@ -13,6 +13,10 @@
 #pragma once
 
 #include "BasicTypes.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <type_traits>
 #include <utility>
 
 namespace vc64::util {
@@ -24,6 +28,7 @@ namespace vc64::util {
  *          SortedArray : A fixed size array with sorted insert
  *           RingBuffer : A standard ringbuffer
  *     SortedRingBuffer : A standard ringbuffer with sorted insert
+ *       SPSCRingBuffer : A lock-free single-producer single-consumer ringbuffer
  */
 
 //
@@ -328,4 +333,173 @@ struct SortedRingBuffer : public RingBuffer<T, capacity>
     }
 };
 
+//
+// Lock-free ringbuffer
+//
+
+/* This ringbuffer connects a single producer thread with a single consumer
+ * thread. The producer owns the write counter and the consumer owns the read
+ * counter. Both counters grow monotonically and are mapped to the element
+ * storage by masking. The consumer removes an element only after processing
+ * it. Hence, an empty buffer indicates that all elements have been processed.
+ */
+template <class T, isize capacity> struct SPSCRingBuffer
+{
+    static_assert((capacity & (capacity - 1)) == 0, "Capacity must be a power of two");
+
+    // Element storage
+    T *elements = new T[capacity]();
+
+    // Read and write counters (placed in separate cache lines)
+    alignas(64) std::atomic<isize> r = 0;
+    alignas(64) std::atomic<isize> w = 0;
+
+
+    //
+    // Initializing
+    //
+
+    SPSCRingBuffer() { }
+    ~SPSCRingBuffer() { delete[] elements; }
+    SPSCRingBuffer(const SPSCRingBuffer&) = delete;
+    SPSCRingBuffer& operator= (const SPSCRingBuffer&) = delete;
+
+
+    //
+    // Querying the fill status
+    //
+
+    isize cap() const { return capacity; }
+    isize count() const { return w.load(std::memory_order_acquire) - r.load(std::memory_order_acquire); }
+    isize free() const { return capacity - count(); }
+    double fillLevel() const { return (double)count() / capacity; }
+    bool isEmpty() const { return count() == 0; }
+    bool isFull() const { return count() == capacity; }
+
+
+    //
+    // Working with indices
+    //
+
+    static isize index(isize counter) { return counter & (capacity - 1); }
+
+
+    //
+    // Producing elements
+    //
+
+    // Appends an element if there is space left
+    bool tryWrite(const T &element)
+    {
+        auto ww = w.load(std::memory_order_relaxed);
+        if (ww - r.load(std::memory_order_acquire) == capacity) return false;
+
+        elements[ww & (capacity - 1)] = element;
+        w.store(ww + 1, std::memory_order_release);
+        w.notify_one();
+        return true;
+    }
+
+    // Appends an element and blocks while the buffer is full
+    void write(const T &element)
+    {
+        while (!tryWrite(element)) {
+
+            auto rr = r.load(std::memory_order_acquire);
+            if (w.load(std::memory_order_relaxed) - rr == capacity) r.wait(rr);
+        }
+    }
+
+    // Appends up to n elements in bulk and returns the number of appended elements
+    isize tryWrite(const T *src, isize n)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        auto ww = w.load(std::memory_order_relaxed);
+        n = std::min(n, capacity - (ww - r.load(std::memory_order_acquire)));
+        if (n <= 0) return 0;
+
+        auto len = std::min(n, capacity - index(ww));
+        std::memcpy(elements + index(ww), src, len * sizeof(T));
+        std::memcpy(elements, src + len, (n - len) * sizeof(T));
+        w.store(ww + n, std::memory_order_release);
+        w.notify_one();
+        return n;
+    }
+
+    // Blocks until the consumer has processed all elements
+    void waitUntilEmpty() const
+    {
+        auto ww = w.load(std::memory_order_acquire);
+        for (auto rr = r.load(std::memory_order_acquire); rr != ww; rr = r.load(std::memory_order_acquire)) {
+            r.wait(rr);
+        }
+    }
+
+    // Blocks until the consumer has processed at least one element of a full buffer
+    void waitUntilFree() const
+    {
+        auto ww = w.load(std::memory_order_relaxed);
+        for (auto rr = r.load(std::memory_order_acquire); ww - rr == capacity; rr = r.load(std::memory_order_acquire)) {
+            r.wait(rr);
+        }
+    }
+
+
+    //
+    // Consuming elements
+    //
+
+    // Returns the oldest element and blocks while the buffer is empty
+    T& front()
+    {
+        auto rr = r.load(std::memory_order_relaxed);
+        w.wait(rr, std::memory_order_acquire);
+        return elements[rr & (capacity - 1)];
+    }
+
+    // Returns an element without removing it (offset 0 is the oldest element)
+    const T& peek(isize offset) const
+    {
+        assert(offset < count());
+        return elements[index(r.load(std::memory_order_relaxed) + offset)];
+    }
+
+    // Removes the oldest element
+    void pop()
+    {
+        r.store(r.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        r.notify_all();
+    }
+
+    // Removes up to n elements in bulk and returns the number of removed elements
+    isize tryRead(T *dst, isize n)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        auto rr = r.load(std::memory_order_relaxed);
+        n = std::min(n, w.load(std::memory_order_acquire) - rr);
+        if (n <= 0) return 0;
+
+        auto len = std::min(n, capacity - index(rr));
+        std::memcpy((void *)dst, elements + index(rr), len * sizeof(T));
+        std::memcpy((void *)(dst + len), elements, (n - len) * sizeof(T));
+        r.store(rr + n, std::memory_order_release);
+        r.notify_all();
+        return n;
+    }
+
+    // Removes up to n elements without reading them
+    isize skip(isize n)
+    {
+        auto rr = r.load(std::memory_order_relaxed);
+        n = std::min(n, w.load(std::memory_order_acquire) - rr);
+        if (n <= 0) return 0;
+
+        r.store(rr + n, std::memory_order_release);
+        r.notify_all();
+        return n;
+    }
+};
+
 }
@@ -748,9 +748,21 @@ AudioPortAPI::copyInterleaved(float *buffer, isize n)
 //
 
 u32 *
-VideoPortAPI::getTexture() const
+VideoPortAPI::getTexture(i64 *nr) const
 {
-    return emu->getTexture();
+    return emu->getTexture(nr);
+}
+
+void
+VideoPortAPI::copyTexture(u32 *dst, i64 *nr) const
+{
+    emu->copyTexture(dst, nr);
+}
+
+i64
+VideoPortAPI::getLatestFrame() const
+{
+    return emu->getLatestFrame();
 }
 
 u32 *
@@ -759,6 +771,12 @@ VideoPortAPI::getDmaTexture() const
     return emu->getDmaTexture();
 }
 
+void
+VideoPortAPI::requestFrame()
+{
+    emu->requestFrame();
+}
+
 
 //
 // DMA Debugger
@@ -298,10 +298,51 @@ struct VideoPortAPI : API {
      * The texture dimensions are given by constants vc64::Texture::width
      * and vc64::Texture::height texels. Each texel is represented by a
      * 32 bit color value.
+     *
+     * The emulator hands completed frames over via a triple buffer. Hence,
+     * the returned texture is never modified by the emulator thread and
+     * calling this function never blocks the emulator thread.
+     *
+     * The returned texture stays intact until this function is called for
+     * the second time. It is therefore meant for a single consumer, usually
+     * the renderer of the GUI. Other consumers should use copyTexture().
+     *
+     * @param   nr  If not null, the frame number of the texture is stored
+     *              here. The number is negative if the emulator is powered
+     *              off.
+     */
+    u32 *getTexture(i64 *nr = nullptr) const;
+
+    /** @brief  Copies the most recent stable texture
+     *
+     * This function copies the texture returned by getTexture() into dst,
+     * which must provide space for Texture::width * Texture::height texels.
+     * It can be called from any thread and by any number of consumers. It
+     * never blocks the emulator thread.
+     *
+     * @param   nr  If not null, the frame number of the texture is stored
+     *              here (see getTexture()).
      */
-    u32 *getTexture() const;
+    void copyTexture(u32 *dst, i64 *nr = nullptr) const;
     u32 *getDmaTexture() const;
 
+    /** @brief  Returns the number of the latest completed frame
+     *
+     * This function is lock-free and can be used to poll for new frames. A
+     * new frame is available if the returned number differs from the number
+     * of the texture that has been retrieved last.
+     */
+    i64 getLatestFrame() const;
+
+    /** @brief  Requests the next frame to be rendered
+     *
+     * If the emulator skips frames (see option C64.RENDER_INTERVAL), the
+     * stable texture is only updated for rendered frames. Calling this
+     * function ensures that the next frame is rendered. Its pixels can be
+     * retrieved via getTexture() once the frame has been completed.
+     */
+    void requestFrame();
+
 };
 
 
@@ -571,6 +612,9 @@ struct RecorderAPI : API {
     /** @brief  Exports the recorded video to a file.
      *  @param  path    The export destination.
      *  @return true on success.
+     *  @note   Raw recordings are exported as two files. Their names are
+     *          derived from path by replacing the extension with .y4m and
+     *          .wav, respectively.
      */
     bool exportAs(const std::filesystem::path &path);
 